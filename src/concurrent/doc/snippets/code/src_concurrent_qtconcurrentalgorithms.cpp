@@ -0,0 +1,91 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the documentation of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:BSD$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** BSD License Usage
+** Alternatively, you may use this file under the terms of the BSD license
+** as follows:
+**
+** "Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are
+** met:
+**   * Redistributions of source code must retain the above copyright
+**     notice, this list of conditions and the following disclaimer.
+**   * Redistributions in binary form must reproduce the above copyright
+**     notice, this list of conditions and the following disclaimer in
+**     the documentation and/or other materials provided with the
+**     distribution.
+**   * Neither the name of The Qt Company Ltd nor the names of its
+**     contributors may be used to endorse or promote products derived
+**     from this software without specific prior written permission.
+**
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+** "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+** LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+** A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+** OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+** OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE."
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//! [0]
+QList<int> values = ...;
+QFuture<void> future = QtConcurrent::sort(values);
+...
+future.waitForFinished();
+// values is now sorted in ascending order
+//! [0]
+
+
+//! [1]
+QStringList names = ...;
+QtConcurrent::blockingSort(names, [](const QString &lhs, const QString &rhs) {
+    return QString::compare(lhs, rhs, Qt::CaseInsensitive) < 0;
+});
+//! [1]
+
+
+//! [2]
+QList<int> values = { 1, 2, 3, 4 };
+QtConcurrent::blockingInclusiveScan(values);
+// values is now { 1, 3, 6, 10 }
+//! [2]
+
+
+//! [3]
+QList<int> values = { 1, 2, 3, 4, 5, 6 };
+qsizetype evenCount = QtConcurrent::blockingPartition(values, [](int value) {
+    return value % 2 == 0;
+});
+// values is now { 2, 4, 6, 1, 3, 5 } and evenCount is 3
+//! [3]
+
+
+//! [4]
+QList<QImage> images = ...;
+QFuture<qsizetype> future = QtConcurrent::findFirst(images, [](const QImage &image) {
+    return image.isNull();
+});
+...
+qsizetype index = future.result(); // -1 if there was no null image
+//! [4]
@@ -0,0 +1,512 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTCONCURRENT_ALGORITHMKERNEL_H
+#define QTCONCURRENT_ALGORITHMKERNEL_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentiteratekernel.h>
+#include <QtConcurrent/qtconcurrentmapkernel.h>
+#include <QtConcurrent/qtconcurrentthreadengine.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+
+QT_BEGIN_NAMESPACE
+
+
+
+namespace QtConcurrent {
+
+/*
+    The PhasedKernel class runs an algorithm that consists of a fixed
+    number of phases over a random access range. Each phase is split into
+    independent tasks which may run concurrently; a phase is only started
+    once all tasks of the previous one have finished. The thread that
+    finishes the last task of a phase runs finishPhase() and then moves on
+    to the next phase, starting more threads as tasks become available.
+
+    The range is divided into blockCount blocks of roughly the same size;
+    blocks are never smaller than MinimumBlockSize items, except when the
+    whole range is smaller than that.
+*/
+template <typename Iterator, typename T>
+class PhasedKernel : public ThreadEngine<T>
+{
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>,
+                  "The parallel algorithms require random access iterators");
+public:
+    typedef T ResultType;
+
+    enum { MinimumBlockSize = 1024 };
+
+    PhasedKernel(QThreadPool *pool, Iterator _begin, Iterator _end, int blocksPerThread)
+        : ThreadEngine<T>(pool), begin(_begin), end(_end), count(std::distance(_begin, _end)),
+          blockCount(int(qBound(qsizetype(1), count / MinimumBlockSize,
+                                qsizetype(qMax(1, pool->maxThreadCount()) * blocksPerThread))))
+    {
+    }
+
+    virtual int phaseCount() const = 0;
+    virtual int taskCount(int phase) const = 0;
+    virtual void runTask(int phase, int task) = 0;
+    virtual void finishPhase(int phase) { Q_UNUSED(phase); }
+
+    void start() override
+    {
+        progressReportingEnabled = this->isProgressReportingEnabled();
+        if (progressReportingEnabled) {
+            int totalTasks = 0;
+            for (int phase = 0; phase < phaseCount(); ++phase)
+                totalTasks += taskCount(phase);
+            this->setProgressRange(0, totalTasks);
+        }
+
+        currentPhase = -1;
+        advancePhase();
+    }
+
+    bool shouldStartThread() override
+    {
+        return pendingTasks.loadRelaxed() > 0 && !this->shouldThrottleThread();
+    }
+
+    ThreadFunctionResult threadFunction() override
+    {
+        for (;;) {
+            if (this->isCanceled())
+                break;
+
+            this->waitForResume(); // (only waits if the qfuture is paused.)
+
+            int phase;
+            int task;
+            {
+                QMutexLocker locker(&phaseMutex);
+                if (nextTask >= currentTaskCount)
+                    break;
+                phase = currentPhase;
+                task = nextTask++;
+                pendingTasks.storeRelaxed(currentTaskCount - nextTask);
+            }
+
+            if (shouldStartThread())
+                this->startThread();
+
+            runTask(phase, task);
+
+            if (progressReportingEnabled)
+                this->setProgressValue(completed.fetchAndAddRelaxed(1) + 1);
+
+            {
+                QMutexLocker locker(&phaseMutex);
+                if (++finishedTasks == currentTaskCount)
+                    advancePhase();
+            }
+
+            if (this->shouldThrottleThread())
+                return ThrottleThread;
+        }
+        return ThreadFinished;
+    }
+
+protected:
+    qsizetype blockBegin(int block) const
+    {
+        return qsizetype(qint64(count) * block / blockCount);
+    }
+
+    // The merge tree pairs up adjacent runs of blocks: round r (starting at
+    // 1) merges runs of 2^(r-1) blocks into runs of 2^r blocks.
+    int mergeRounds() const
+    {
+        int rounds = 0;
+        while ((1 << rounds) < blockCount)
+            ++rounds;
+        return rounds;
+    }
+
+    int mergeTaskCount(int round) const
+    {
+        const int width = 1 << (round - 1);
+        return (blockCount + width - 1) / (2 * width);
+    }
+
+    void mergeRange(int round, int task, int *first, int *middle, int *last) const
+    {
+        const int width = 1 << (round - 1);
+        *first = task * 2 * width;
+        *middle = *first + width;
+        *last = qMin(*first + 2 * width, blockCount);
+    }
+
+    const Iterator begin;
+    const Iterator end;
+    const qsizetype count;
+    const int blockCount;
+
+private:
+    // Called with phaseMutex locked, or from start().
+    void advancePhase()
+    {
+        if (currentPhase >= 0)
+            finishPhase(currentPhase);
+        for (++currentPhase; currentPhase < phaseCount(); ++currentPhase) {
+            if (taskCount(currentPhase) > 0)
+                break;
+            finishPhase(currentPhase);
+        }
+        currentTaskCount = currentPhase < phaseCount() ? taskCount(currentPhase) : 0;
+        nextTask = 0;
+        finishedTasks = 0;
+        pendingTasks.storeRelaxed(currentTaskCount);
+    }
+
+    QMutex phaseMutex;
+    int currentPhase = -1;
+    int currentTaskCount = 0;
+    int nextTask = 0;
+    int finishedTasks = 0;
+    QAtomicInt pendingTasks;
+    QAtomicInt completed;
+    bool progressReportingEnabled = false;
+};
+
+/*
+    SortKernel sorts each block with std::sort and then merges the sorted
+    blocks pairwise with std::inplace_merge, one round of the merge tree
+    per phase.
+*/
+template <typename Iterator, typename LessThan>
+class SortKernel : public PhasedKernel<Iterator, void>
+{
+    typedef PhasedKernel<Iterator, void> Base;
+    LessThan lessThan;
+
+public:
+    SortKernel(QThreadPool *pool, Iterator begin, Iterator end, LessThan _lessThan)
+        : Base(pool, begin, end, 1), lessThan(_lessThan)
+    { }
+
+    int phaseCount() const override
+    {
+        return 1 + this->mergeRounds();
+    }
+
+    int taskCount(int phase) const override
+    {
+        return phase == 0 ? this->blockCount : this->mergeTaskCount(phase);
+    }
+
+    void runTask(int phase, int task) override
+    {
+        if (phase == 0) {
+            std::sort(this->begin + this->blockBegin(task),
+                      this->begin + this->blockBegin(task + 1), lessThan);
+            return;
+        }
+
+        int first, middle, last;
+        this->mergeRange(phase, task, &first, &middle, &last);
+        std::inplace_merge(this->begin + this->blockBegin(first),
+                           this->begin + this->blockBegin(middle),
+                           this->begin + this->blockBegin(last), lessThan);
+    }
+};
+
+/*
+    PartitionKernel partitions each block with std::stable_partition, and
+    then joins adjacent partitioned runs by rotating the "false" part of
+    the left run past the "true" part of the right run. This keeps the
+    relative order of the items in both groups.
+*/
+template <typename Iterator, typename Predicate>
+class PartitionKernel : public PhasedKernel<Iterator, qsizetype>
+{
+    typedef PhasedKernel<Iterator, qsizetype> Base;
+    Predicate predicate;
+    QList<qsizetype> splits; // partition point of the run starting at each block
+    qsizetype partitionPoint = 0;
+
+public:
+    PartitionKernel(QThreadPool *pool, Iterator begin, Iterator end, Predicate _predicate)
+        : Base(pool, begin, end, 1), predicate(_predicate)
+    {
+        splits.resize(this->blockCount);
+    }
+
+    int phaseCount() const override
+    {
+        return 1 + this->mergeRounds();
+    }
+
+    int taskCount(int phase) const override
+    {
+        return phase == 0 ? this->blockCount : this->mergeTaskCount(phase);
+    }
+
+    void runTask(int phase, int task) override
+    {
+        if (phase == 0) {
+            const Iterator first = this->begin + this->blockBegin(task);
+            const Iterator split = std::stable_partition(first,
+                                                         this->begin + this->blockBegin(task + 1),
+                                                         [this](auto &&value) {
+                return std::invoke(predicate, value);
+            });
+            splits[task] = split - this->begin;
+            return;
+        }
+
+        int first, middle, last;
+        this->mergeRange(phase, task, &first, &middle, &last);
+        const Iterator newSplit = std::rotate(this->begin + splits.at(first),
+                                              this->begin + this->blockBegin(middle),
+                                              this->begin + splits.at(middle));
+        splits[first] = newSplit - this->begin;
+        Q_UNUSED(last);
+    }
+
+    void finishPhase(int phase) override
+    {
+        if (phase == this->phaseCount() - 1)
+            partitionPoint = splits.at(0);
+    }
+
+    qsizetype *result() override
+    {
+        return &partitionPoint;
+    }
+};
+
+/*
+    InclusiveScanKernel computes an in-place inclusive scan in two passes:
+    each block is first scanned locally, then the running totals of the
+    preceding blocks are folded into every block except the first.
+*/
+template <typename Iterator, typename BinaryOperation>
+class InclusiveScanKernel : public PhasedKernel<Iterator, void>
+{
+    typedef PhasedKernel<Iterator, void> Base;
+    typedef typename std::iterator_traits<Iterator>::value_type ValueType;
+    BinaryOperation operation;
+    QList<ValueType> carries; // total of all blocks before block i + 1
+
+public:
+    InclusiveScanKernel(QThreadPool *pool, Iterator begin, Iterator end,
+                        BinaryOperation _operation)
+        : Base(pool, begin, end, 4), operation(_operation)
+    { }
+
+    int phaseCount() const override
+    {
+        return 2;
+    }
+
+    int taskCount(int phase) const override
+    {
+        return phase == 0 ? this->blockCount : this->blockCount - 1;
+    }
+
+    void runTask(int phase, int task) override
+    {
+        if (phase == 0) {
+            const Iterator first = this->begin + this->blockBegin(task);
+            std::partial_sum(first, this->begin + this->blockBegin(task + 1), first,
+                             [this](const auto &lhs, const auto &rhs) {
+                return std::invoke(operation, lhs, rhs);
+            });
+            return;
+        }
+
+        const ValueType &carry = carries.at(task);
+        const Iterator last = this->begin + this->blockBegin(task + 2);
+        for (Iterator it = this->begin + this->blockBegin(task + 1); it != last; ++it)
+            *it = std::invoke(operation, carry, *it);
+    }
+
+    void finishPhase(int phase) override
+    {
+        if (phase != 0)
+            return;
+
+        carries.reserve(this->blockCount - 1);
+        for (int block = 1; block < this->blockCount; ++block) {
+            const ValueType &blockTotal = *(this->begin + (this->blockBegin(block) - 1));
+            if (carries.isEmpty())
+                carries.append(blockTotal);
+            else
+                carries.append(std::invoke(operation, carries.constLast(), blockTotal));
+        }
+    }
+};
+
+/*
+    FindFirstKernel records the lowest index for which the predicate
+    matched. Blocks that start after an already found match are skipped,
+    so the search stops shortly after the first match.
+*/
+template <typename Iterator, typename Predicate>
+class FindFirstKernel : public IterateKernel<Iterator, qsizetype>
+{
+    typedef IterateKernel<Iterator, qsizetype> Base;
+    Predicate predicate;
+    QAtomicInt firstMatch { std::numeric_limits<int>::max() };
+    qsizetype foundIndex = -1;
+
+    void reportMatch(int index)
+    {
+        int current = firstMatch.loadRelaxed();
+        while (index < current && !firstMatch.testAndSetRelaxed(current, index, current))
+            ;
+    }
+
+public:
+    FindFirstKernel(QThreadPool *pool, Iterator begin, Iterator end, Predicate _predicate)
+        : Base(pool, begin, end), predicate(_predicate)
+    { }
+
+    bool runIteration(Iterator it, int index, qsizetype *) override
+    {
+        if (index < firstMatch.loadRelaxed() && std::invoke(predicate, *it))
+            reportMatch(index);
+        return false;
+    }
+
+    bool runIterations(Iterator sequenceBeginIterator, int beginIndex, int endIndex, qsizetype *) override
+    {
+        if (beginIndex > firstMatch.loadRelaxed())
+            return false;
+
+        Iterator it = sequenceBeginIterator;
+        std::advance(it, beginIndex);
+        for (int i = beginIndex; i < endIndex; ++i) {
+            if (std::invoke(predicate, *it)) {
+                reportMatch(i);
+                break;
+            }
+            std::advance(it, 1);
+        }
+        return false;
+    }
+
+    bool shouldStartThread() override
+    {
+        return firstMatch.loadRelaxed() == std::numeric_limits<int>::max()
+                && Base::shouldStartThread();
+    }
+
+    void finish() override
+    {
+        const int index = firstMatch.loadRelaxed();
+        foundIndex = index == std::numeric_limits<int>::max() ? -1 : index;
+    }
+
+    qsizetype *result() override
+    {
+        return &foundIndex;
+    }
+};
+
+//! [qtconcurrentalgorithmkernel-1]
+template <typename Iterator, typename LessThan>
+inline ThreadEngineStarter<void> startSort(QThreadPool *pool, Iterator begin, Iterator end,
+                                           LessThan lessThan)
+{
+    return startThreadEngine(new SortKernel<Iterator, LessThan>(pool, begin, end, lessThan));
+}
+
+//! [qtconcurrentalgorithmkernel-2]
+template <typename Iterator, typename BinaryOperation>
+inline ThreadEngineStarter<void> startInclusiveScan(QThreadPool *pool, Iterator begin,
+                                                    Iterator end, BinaryOperation operation)
+{
+    return startThreadEngine(new InclusiveScanKernel<Iterator, BinaryOperation>(pool, begin, end,
+                                                                                operation));
+}
+
+//! [qtconcurrentalgorithmkernel-3]
+template <typename Iterator, typename Predicate>
+inline ThreadEngineStarter<qsizetype> startPartition(QThreadPool *pool, Iterator begin,
+                                                     Iterator end, Predicate predicate)
+{
+    return startThreadEngine(new PartitionKernel<Iterator, Predicate>(pool, begin, end,
+                                                                      predicate));
+}
+
+//! [qtconcurrentalgorithmkernel-4]
+template <typename Iterator, typename Predicate>
+inline ThreadEngineStarter<qsizetype> startFindFirst(QThreadPool *pool, Iterator begin,
+                                                     Iterator end, Predicate predicate)
+{
+    return startThreadEngine(new FindFirstKernel<Iterator, Predicate>(pool, begin, end,
+                                                                      predicate));
+}
+
+//! [qtconcurrentalgorithmkernel-5]
+template <typename Sequence, typename Predicate>
+inline ThreadEngineStarter<qsizetype> startFindFirst(QThreadPool *pool, const Sequence &sequence,
+                                                     Predicate predicate)
+{
+    typedef SequenceHolder1<Sequence,
+                            FindFirstKernel<typename Sequence::const_iterator, Predicate>,
+                            Predicate>
+                            SequenceHolderType;
+    return startThreadEngine(new SequenceHolderType(pool, sequence, predicate));
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
@@ -0,0 +1,560 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+/*!
+    \page qtconcurrentalgorithms.html
+    \title Concurrent Algorithms
+    \ingroup thread
+
+    The QtConcurrent::sort(), QtConcurrent::inclusiveScan(),
+    QtConcurrent::partition() and QtConcurrent::findFirst() functions are
+    parallel counterparts of the STL algorithms with the same purpose. They
+    operate on a sequence such as a QList, or on a pair of iterators, and
+    split the work among the threads of a QThreadPool.
+
+    These functions are a part of the \l {Qt Concurrent} framework.
+
+    \section1 Concurrent Sort, Scan and Partition
+
+    QtConcurrent::sort(), QtConcurrent::inclusiveScan() and
+    QtConcurrent::partition() modify the sequence in-place. They divide it
+    into blocks that are processed concurrently, and then combine the
+    partial results in one or more further passes:
+
+    \snippet code/src_concurrent_qtconcurrentalgorithms.cpp 0
+
+    The sequence must not be modified or destroyed while the algorithm is
+    running, and it must provide random-access iterators. The functions
+    accept an optional comparison, operation or predicate function:
+
+    \snippet code/src_concurrent_qtconcurrentalgorithms.cpp 1
+
+    QtConcurrent::inclusiveScan() replaces each item with the result of
+    combining it with all items before it. Since the blocks are combined in
+    a different order than a sequential scan would use, the operation must be
+    associative:
+
+    \snippet code/src_concurrent_qtconcurrentalgorithms.cpp 2
+
+    QtConcurrent::partition() moves the items for which the predicate returns
+    \c true in front of the others, preserving the relative order within both
+    groups, and returns the number of items in the first group:
+
+    \snippet code/src_concurrent_qtconcurrentalgorithms.cpp 3
+
+    \section1 Concurrent Find
+
+    QtConcurrent::findFirst() returns the index of the first item for which
+    the predicate returns \c true, or -1 if there is no such item. Once a
+    match is found, blocks that start after it are no longer examined:
+
+    \snippet code/src_concurrent_qtconcurrentalgorithms.cpp 4
+
+    \section1 Cancellation and Progress
+
+    The returned QFuture reports progress as the blocks are processed, and
+    supports canceling, suspending and resuming. If the algorithm is canceled,
+    the sequence is left in a valid but unspecified order: it still contains
+    the same items, but the requested transformation may only have been
+    applied partially.
+
+    Each of the functions has a blocking variant, such as
+    QtConcurrent::blockingSort(), that returns when the algorithm has
+    finished.
+*/
+
+/*!
+    \class QtConcurrent::PhasedKernel
+    \inmodule QtConcurrent
+    \internal
+*/
+
+/*!
+    \class QtConcurrent::SortKernel
+    \inmodule QtConcurrent
+    \internal
+*/
+
+/*!
+    \class QtConcurrent::PartitionKernel
+    \inmodule QtConcurrent
+    \internal
+*/
+
+/*!
+    \class QtConcurrent::InclusiveScanKernel
+    \inmodule QtConcurrent
+    \internal
+*/
+
+/*!
+    \class QtConcurrent::FindFirstKernel
+    \inmodule QtConcurrent
+    \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-1] ThreadEngineStarter<void> QtConcurrent::startSort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-2] ThreadEngineStarter<void> QtConcurrent::startInclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, BinaryOperation operation)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-3] ThreadEngineStarter<qsizetype> QtConcurrent::startPartition(QThreadPool *pool, Iterator begin, Iterator end, Predicate predicate)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-4] ThreadEngineStarter<qsizetype> QtConcurrent::startFindFirst(QThreadPool *pool, Iterator begin, Iterator end, Predicate predicate)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-5] ThreadEngineStarter<qsizetype> QtConcurrent::startFindFirst(QThreadPool *pool, const Sequence &sequence, Predicate predicate)
+  \internal
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::sort(QThreadPool *pool, Sequence &sequence, LessThan lessThan)
+
+    Sorts the items in \a sequence in-place according to \a lessThan, which defaults to
+    \c{std::less<>}. The sort is not stable: items that compare equal may not
+    keep their relative order.
+
+    All calls to \a lessThan are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::sort(Sequence &sequence, LessThan lessThan)
+
+    Sorts the items in \a sequence in-place according to \a lessThan, which defaults to
+    \c{std::less<>}. The sort is not stable: items that compare equal may not
+    keep their relative order.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> QFuture<void> QtConcurrent::sort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan)
+
+    Sorts the items from \a begin to \a end in-place according to \a lessThan, which defaults to
+    \c{std::less<>}. The sort is not stable: items that compare equal may not
+    keep their relative order.
+
+    All calls to \a lessThan are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> QFuture<void> QtConcurrent::sort(Iterator begin, Iterator end, LessThan lessThan)
+
+    Sorts the items from \a begin to \a end in-place according to \a lessThan, which defaults to
+    \c{std::less<>}. The sort is not stable: items that compare equal may not
+    keep their relative order.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan)
+
+    Sorts the items in \a sequence in-place according to \a lessThan, which defaults to
+    \c{std::less<>}. The sort is not stable: items that compare equal may not
+    keep their relative order.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    All calls to \a lessThan are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingSort(Sequence &sequence, LessThan lessThan)
+
+    Sorts the items in \a sequence in-place according to \a lessThan, which defaults to
+    \c{std::less<>}. The sort is not stable: items that compare equal may not
+    keep their relative order.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> void QtConcurrent::blockingSort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan)
+
+    Sorts the items from \a begin to \a end in-place according to \a lessThan, which defaults to
+    \c{std::less<>}. The sort is not stable: items that compare equal may not
+    keep their relative order.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    All calls to \a lessThan are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> void QtConcurrent::blockingSort(Iterator begin, Iterator end, LessThan lessThan)
+
+    Sorts the items from \a begin to \a end in-place according to \a lessThan, which defaults to
+    \c{std::less<>}. The sort is not stable: items that compare equal may not
+    keep their relative order.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(QThreadPool *pool, Sequence &sequence, BinaryOperation operation)
+
+    Replaces each item in \a sequence with the result of combining it with all
+    preceding items using \a operation, which defaults to \c{std::plus<>}.
+    The \a operation must be associative.
+
+    All calls to \a operation are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(Sequence &sequence, BinaryOperation operation)
+
+    Replaces each item in \a sequence with the result of combining it with all
+    preceding items using \a operation, which defaults to \c{std::plus<>}.
+    The \a operation must be associative.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, BinaryOperation operation)
+
+    Replaces each item from \a begin to \a end with the result of combining it with all
+    preceding items using \a operation, which defaults to \c{std::plus<>}.
+    The \a operation must be associative.
+
+    All calls to \a operation are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(Iterator begin, Iterator end, BinaryOperation operation)
+
+    Replaces each item from \a begin to \a end with the result of combining it with all
+    preceding items using \a operation, which defaults to \c{std::plus<>}.
+    The \a operation must be associative.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(QThreadPool *pool, Sequence &sequence, BinaryOperation operation)
+
+    Replaces each item in \a sequence with the result of combining it with all
+    preceding items using \a operation, which defaults to \c{std::plus<>}.
+    The \a operation must be associative.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    All calls to \a operation are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(Sequence &sequence, BinaryOperation operation)
+
+    Replaces each item in \a sequence with the result of combining it with all
+    preceding items using \a operation, which defaults to \c{std::plus<>}.
+    The \a operation must be associative.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, BinaryOperation operation)
+
+    Replaces each item from \a begin to \a end with the result of combining it with all
+    preceding items using \a operation, which defaults to \c{std::plus<>}.
+    The \a operation must be associative.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    All calls to \a operation are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(Iterator begin, Iterator end, BinaryOperation operation)
+
+    Replaces each item from \a begin to \a end with the result of combining it with all
+    preceding items using \a operation, which defaults to \c{std::plus<>}.
+    The \a operation must be associative.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> QFuture<qsizetype> QtConcurrent::partition(QThreadPool *pool, Sequence &sequence, Predicate predicate)
+
+    Reorders the items in \a sequence so that all items for which \a predicate
+    returns \c true precede the items for which it returns \c false. The
+    relative order of the items in each group is preserved. The result is
+    the number of items for which \a predicate returned \c true.
+
+    All calls to \a predicate are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> QFuture<qsizetype> QtConcurrent::partition(Sequence &sequence, Predicate predicate)
+
+    Reorders the items in \a sequence so that all items for which \a predicate
+    returns \c true precede the items for which it returns \c false. The
+    relative order of the items in each group is preserved. The result is
+    the number of items for which \a predicate returned \c true.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> QFuture<qsizetype> QtConcurrent::partition(QThreadPool *pool, Iterator begin, Iterator end, Predicate predicate)
+
+    Reorders the items from \a begin to \a end so that all items for which \a predicate
+    returns \c true precede the items for which it returns \c false. The
+    relative order of the items in each group is preserved. The result is
+    the number of items for which \a predicate returned \c true.
+
+    All calls to \a predicate are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> QFuture<qsizetype> QtConcurrent::partition(Iterator begin, Iterator end, Predicate predicate)
+
+    Reorders the items from \a begin to \a end so that all items for which \a predicate
+    returns \c true precede the items for which it returns \c false. The
+    relative order of the items in each group is preserved. The result is
+    the number of items for which \a predicate returned \c true.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> qsizetype QtConcurrent::blockingPartition(QThreadPool *pool, Sequence &sequence, Predicate predicate)
+
+    Reorders the items in \a sequence so that all items for which \a predicate
+    returns \c true precede the items for which it returns \c false. The
+    relative order of the items in each group is preserved. The result is
+    the number of items for which \a predicate returned \c true.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    All calls to \a predicate are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> qsizetype QtConcurrent::blockingPartition(Sequence &sequence, Predicate predicate)
+
+    Reorders the items in \a sequence so that all items for which \a predicate
+    returns \c true precede the items for which it returns \c false. The
+    relative order of the items in each group is preserved. The result is
+    the number of items for which \a predicate returned \c true.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> qsizetype QtConcurrent::blockingPartition(QThreadPool *pool, Iterator begin, Iterator end, Predicate predicate)
+
+    Reorders the items from \a begin to \a end so that all items for which \a predicate
+    returns \c true precede the items for which it returns \c false. The
+    relative order of the items in each group is preserved. The result is
+    the number of items for which \a predicate returned \c true.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    All calls to \a predicate are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> qsizetype QtConcurrent::blockingPartition(Iterator begin, Iterator end, Predicate predicate)
+
+    Reorders the items from \a begin to \a end so that all items for which \a predicate
+    returns \c true precede the items for which it returns \c false. The
+    relative order of the items in each group is preserved. The result is
+    the number of items for which \a predicate returned \c true.
+
+    \note This function will block until all items in the sequence have been
+    processed.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> QFuture<qsizetype> QtConcurrent::findFirst(QThreadPool *pool, const Sequence &sequence, Predicate predicate)
+
+    Searches the items in \a sequence for the first item for which \a predicate
+    returns \c true. The result is the index of that item, or -1 if there is
+    no such item.
+
+    All calls to \a predicate are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> QFuture<qsizetype> QtConcurrent::findFirst(const Sequence &sequence, Predicate predicate)
+
+    Searches the items in \a sequence for the first item for which \a predicate
+    returns \c true. The result is the index of that item, or -1 if there is
+    no such item.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> QFuture<qsizetype> QtConcurrent::findFirst(QThreadPool *pool, Iterator begin, Iterator end, Predicate predicate)
+
+    Searches the items from \a begin to \a end for the first item for which \a predicate
+    returns \c true. The result is the index of that item, or -1 if there is
+    no such item.
+
+    All calls to \a predicate are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> QFuture<qsizetype> QtConcurrent::findFirst(Iterator begin, Iterator end, Predicate predicate)
+
+    Searches the items from \a begin to \a end for the first item for which \a predicate
+    returns \c true. The result is the index of that item, or -1 if there is
+    no such item.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> qsizetype QtConcurrent::blockingFindFirst(QThreadPool *pool, const Sequence &sequence, Predicate predicate)
+
+    Searches the items in \a sequence for the first item for which \a predicate
+    returns \c true. The result is the index of that item, or -1 if there is
+    no such item.
+
+    \note This function will block until the search has finished.
+
+    All calls to \a predicate are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> qsizetype QtConcurrent::blockingFindFirst(const Sequence &sequence, Predicate predicate)
+
+    Searches the items in \a sequence for the first item for which \a predicate
+    returns \c true. The result is the index of that item, or -1 if there is
+    no such item.
+
+    \note This function will block until the search has finished.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> qsizetype QtConcurrent::blockingFindFirst(QThreadPool *pool, Iterator begin, Iterator end, Predicate predicate)
+
+    Searches the items from \a begin to \a end for the first item for which \a predicate
+    returns \c true. The result is the index of that item, or -1 if there is
+    no such item.
+
+    \note This function will block until the search has finished.
+
+    All calls to \a predicate are invoked from the threads taken from the QThreadPool \a pool.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> qsizetype QtConcurrent::blockingFindFirst(Iterator begin, Iterator end, Predicate predicate)
+
+    Searches the items from \a begin to \a end for the first item for which \a predicate
+    returns \c true. The result is the index of that item, or -1 if there is
+    no such item.
+
+    \note This function will block until the search has finished.
+
+    \sa {Concurrent Algorithms}
+*/
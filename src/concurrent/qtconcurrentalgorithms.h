@@ -0,0 +1,317 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTCONCURRENT_ALGORITHMS_H
+#define QTCONCURRENT_ALGORITHMS_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentalgorithmkernel.h>
+#include <QtConcurrent/qtconcurrentcompilertest.h>
+
+QT_BEGIN_NAMESPACE
+
+
+
+namespace QtConcurrent {
+
+// sort() on sequences
+template <typename Sequence, typename LessThan = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<void> sort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(pool, std::begin(sequence), std::end(sequence), lessThan);
+}
+
+template <typename Sequence, typename LessThan = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<void> sort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), std::begin(sequence), std::end(sequence),
+                     lessThan);
+}
+
+// sort() on iterators
+template <typename Iterator, typename LessThan = std::less<>>
+QFuture<void> sort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan = LessThan())
+{
+    return startSort(pool, begin, end, lessThan);
+}
+
+template <typename Iterator, typename LessThan = std::less<>>
+QFuture<void> sort(Iterator begin, Iterator end, LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), begin, end, lessThan);
+}
+
+// inclusiveScan() on sequences
+template <typename Sequence, typename BinaryOperation = std::plus<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<void> inclusiveScan(QThreadPool *pool, Sequence &sequence,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(pool, std::begin(sequence), std::end(sequence), operation);
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+QFuture<void> inclusiveScan(Sequence &sequence, BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(QThreadPool::globalInstance(), std::begin(sequence),
+                              std::end(sequence), operation);
+}
+
+// inclusiveScan() on iterators
+template <typename Iterator, typename BinaryOperation = std::plus<>>
+QFuture<void> inclusiveScan(QThreadPool *pool, Iterator begin, Iterator end,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(pool, begin, end, operation);
+}
+
+template <typename Iterator, typename BinaryOperation = std::plus<>>
+QFuture<void> inclusiveScan(Iterator begin, Iterator end,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(QThreadPool::globalInstance(), begin, end, operation);
+}
+
+// partition() on sequences
+template <typename Sequence, typename Predicate>
+QFuture<qsizetype> partition(QThreadPool *pool, Sequence &sequence, Predicate predicate)
+{
+    return startPartition(pool, std::begin(sequence), std::end(sequence), predicate);
+}
+
+template <typename Sequence, typename Predicate>
+QFuture<qsizetype> partition(Sequence &sequence, Predicate predicate)
+{
+    return startPartition(QThreadPool::globalInstance(), std::begin(sequence),
+                          std::end(sequence), predicate);
+}
+
+// partition() on iterators
+template <typename Iterator, typename Predicate>
+QFuture<qsizetype> partition(QThreadPool *pool, Iterator begin, Iterator end,
+                             Predicate predicate)
+{
+    return startPartition(pool, begin, end, predicate);
+}
+
+template <typename Iterator, typename Predicate>
+QFuture<qsizetype> partition(Iterator begin, Iterator end, Predicate predicate)
+{
+    return startPartition(QThreadPool::globalInstance(), begin, end, predicate);
+}
+
+// findFirst() on sequences
+template <typename Sequence, typename Predicate>
+QFuture<qsizetype> findFirst(QThreadPool *pool, const Sequence &sequence, Predicate predicate)
+{
+    return startFindFirst(pool, sequence, predicate);
+}
+
+template <typename Sequence, typename Predicate>
+QFuture<qsizetype> findFirst(const Sequence &sequence, Predicate predicate)
+{
+    return startFindFirst(QThreadPool::globalInstance(), sequence, predicate);
+}
+
+// findFirst() on iterators
+template <typename Iterator, typename Predicate>
+QFuture<qsizetype> findFirst(QThreadPool *pool, Iterator begin, Iterator end,
+                             Predicate predicate)
+{
+    return startFindFirst(pool, begin, end, predicate);
+}
+
+template <typename Iterator, typename Predicate>
+QFuture<qsizetype> findFirst(Iterator begin, Iterator end, Predicate predicate)
+{
+    return startFindFirst(QThreadPool::globalInstance(), begin, end, predicate);
+}
+
+// blockingSort() on sequences
+template <typename Sequence, typename LessThan = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+void blockingSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(pool, std::begin(sequence), std::end(sequence), lessThan);
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename LessThan = std::less<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+void blockingSort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(QThreadPool::globalInstance(), std::begin(sequence),
+                                     std::end(sequence), lessThan);
+    future.waitForFinished();
+}
+
+// blockingSort() on iterators
+template <typename Iterator, typename LessThan = std::less<>>
+void blockingSort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(pool, begin, end, lessThan);
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename LessThan = std::less<>>
+void blockingSort(Iterator begin, Iterator end, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(QThreadPool::globalInstance(), begin, end, lessThan);
+    future.waitForFinished();
+}
+
+// blockingInclusiveScan() on sequences
+template <typename Sequence, typename BinaryOperation = std::plus<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+void blockingInclusiveScan(QThreadPool *pool, Sequence &sequence,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(pool, std::begin(sequence), std::end(sequence),
+                                              operation);
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0>
+void blockingInclusiveScan(Sequence &sequence, BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(QThreadPool::globalInstance(), std::begin(sequence),
+                                              std::end(sequence), operation);
+    future.waitForFinished();
+}
+
+// blockingInclusiveScan() on iterators
+template <typename Iterator, typename BinaryOperation = std::plus<>>
+void blockingInclusiveScan(QThreadPool *pool, Iterator begin, Iterator end,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(pool, begin, end, operation);
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename BinaryOperation = std::plus<>>
+void blockingInclusiveScan(Iterator begin, Iterator end,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(QThreadPool::globalInstance(), begin, end,
+                                              operation);
+    future.waitForFinished();
+}
+
+// blockingPartition() on sequences
+template <typename Sequence, typename Predicate>
+qsizetype blockingPartition(QThreadPool *pool, Sequence &sequence, Predicate predicate)
+{
+    QFuture<qsizetype> future = startPartition(pool, std::begin(sequence), std::end(sequence),
+                                               predicate);
+    return future.result();
+}
+
+template <typename Sequence, typename Predicate>
+qsizetype blockingPartition(Sequence &sequence, Predicate predicate)
+{
+    QFuture<qsizetype> future = startPartition(QThreadPool::globalInstance(),
+                                               std::begin(sequence), std::end(sequence),
+                                               predicate);
+    return future.result();
+}
+
+// blockingPartition() on iterators
+template <typename Iterator, typename Predicate>
+qsizetype blockingPartition(QThreadPool *pool, Iterator begin, Iterator end, Predicate predicate)
+{
+    QFuture<qsizetype> future = startPartition(pool, begin, end, predicate);
+    return future.result();
+}
+
+template <typename Iterator, typename Predicate>
+qsizetype blockingPartition(Iterator begin, Iterator end, Predicate predicate)
+{
+    QFuture<qsizetype> future = startPartition(QThreadPool::globalInstance(), begin, end,
+                                               predicate);
+    return future.result();
+}
+
+// blockingFindFirst() on sequences
+template <typename Sequence, typename Predicate>
+qsizetype blockingFindFirst(QThreadPool *pool, const Sequence &sequence, Predicate predicate)
+{
+    QFuture<qsizetype> future = startFindFirst(pool, sequence, predicate);
+    return future.result();
+}
+
+template <typename Sequence, typename Predicate>
+qsizetype blockingFindFirst(const Sequence &sequence, Predicate predicate)
+{
+    QFuture<qsizetype> future = startFindFirst(QThreadPool::globalInstance(), sequence,
+                                               predicate);
+    return future.result();
+}
+
+// blockingFindFirst() on iterators
+template <typename Iterator, typename Predicate>
+qsizetype blockingFindFirst(QThreadPool *pool, Iterator begin, Iterator end, Predicate predicate)
+{
+    QFuture<qsizetype> future = startFindFirst(pool, begin, end, predicate);
+    return future.result();
+}
+
+template <typename Iterator, typename Predicate>
+qsizetype blockingFindFirst(Iterator begin, Iterator end, Predicate predicate)
+{
+    QFuture<qsizetype> future = startFindFirst(QThreadPool::globalInstance(), begin, end,
+                                               predicate);
+    return future.result();
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
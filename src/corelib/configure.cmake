@@ -194,6 +194,27 @@ eventfd_write(fd, value);
 }
 ")
 
+# epoll
+qt_config_compile_test(epoll
+    LABEL "epoll"
+    CODE
+"
+#include <sys/epoll.h>
+
+int main(int argc, char **argv)
+{
+    (void)argc; (void)argv;
+    /* BEGIN TEST: */
+int fd = epoll_create1(EPOLL_CLOEXEC);
+struct epoll_event ev = {};
+ev.events = EPOLLIN;
+epoll_ctl(fd, EPOLL_CTL_ADD, 0, &ev);
+epoll_wait(fd, &ev, 1, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # futimens
 qt_config_compile_test(futimens
     LABEL "futimens()"
@@ -300,6 +321,30 @@ inotify_rm_watch(0, 1);
 }
 ")
 
+# io_uring
+qt_config_compile_test(io_uring
+    LABEL "io_uring"
+    CODE
+"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main(int argc, char **argv)
+{
+    (void)argc; (void)argv;
+    /* BEGIN TEST: */
+struct io_uring_params params = {};
+struct io_uring_getevents_arg arg = {};
+params.flags = IORING_SETUP_CLAMP;
+int fd = syscall(__NR_io_uring_setup, 1, &params);
+syscall(__NR_io_uring_enter, fd, 0, 0, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+(void)(params.features & (IORING_FEAT_EXT_ARG | IORING_FEAT_NODROP));
+    /* END TEST: */
+    return 0;
+}
+")
+
 # ipc_sysv
 qt_config_compile_test(ipc_sysv
     LABEL "SysV IPC"
@@ -559,6 +604,10 @@ qt_feature("eventfd" PUBLIC
     CONDITION NOT WASM AND TEST_eventfd
 )
 qt_feature_definition("eventfd" "QT_NO_EVENTFD" NEGATE VALUE "1")
+qt_feature("epoll" PRIVATE
+    LABEL "epoll"
+    CONDITION LINUX AND TEST_epoll
+)
 qt_feature("futimens" PRIVATE
     LABEL "futimens()"
     CONDITION NOT WIN32 AND TEST_futimens
@@ -596,6 +645,10 @@ qt_feature("inotify" PUBLIC PRIVATE
     CONDITION TEST_inotify
 )
 qt_feature_definition("inotify" "QT_NO_INOTIFY" NEGATE VALUE "1")
+qt_feature("io_uring" PRIVATE
+    LABEL "io_uring"
+    CONDITION LINUX AND TEST_io_uring
+)
 qt_feature("ipc_posix"
     LABEL "Using POSIX IPC"
     AUTODETECT NOT WIN32
@@ -63,3 +63,15 @@
 //! [1]
     {"Array":[true,999,"string"],"Key":"Value","null":null}
 //! [1]
+
+//! [2]
+    QFile file("catalog.json");
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    const uchar *mapped = file.map(0, file.size());
+    const QByteArray json = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped),
+                                                    file.size());
+    const QJsonDocument catalog = QJsonDocument::fromJson(json, nullptr,
+                                                          QJsonDocument::ReferenceStrings);
+    // file must stay open and mapped while catalog is in use
+//! [2]
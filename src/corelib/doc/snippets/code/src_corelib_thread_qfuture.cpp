@@ -252,3 +252,14 @@ auto resultFuture = testFuture.then([](int res) {
     // Block 6
 });
 //! [16]
+
+//! [17]
+QFuture<QByteArray> download(QNetworkReply *reply);
+QFuture<Image> decode(const QByteArray &data);
+
+QFuture<Image> fetchImage(QNetworkReply *reply)
+{
+    QByteArray data = co_await download(reply);
+    co_return co_await QtFuture::resumeOn(QThreadPool::globalInstance(), decode(data));
+}
+//! [17]
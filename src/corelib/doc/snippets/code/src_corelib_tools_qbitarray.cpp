@@ -191,3 +191,9 @@ ba.fill(true, 1, 2);            // ba: [ 0, 1, 0, 0 ]
 ba.fill(true, 1, 3);            // ba: [ 0, 1, 1, 0 ]
 ba.fill(true, 1, 4);            // ba: [ 0, 1, 1, 1 ]
 //! [15]
+
+//! [16]
+QBitArray selection = matchingRows(table);
+for (int row = selection.findNextSetBit(); row != -1; row = selection.findNextSetBit(row + 1))
+    process(table.row(row));
+//! [16]
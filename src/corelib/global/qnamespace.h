@@ -1292,7 +1292,9 @@ namespace Qt {
         DirectConnection,
         QueuedConnection,
         BlockingQueuedConnection,
-        UniqueConnection =  0x80
+        UniqueConnection =  0x80,
+        BatchedConnection = 0x100,
+        CoalescedConnection = 0x200
     };
 
     enum ShortcutContext {
@@ -151,6 +151,11 @@ unix|integrity {
 
     qtConfig(poll_select): SOURCES += kernel/qpoll.cpp
 
+    qtConfig(io_uring) {
+        SOURCES += kernel/qiouring_linux.cpp
+        HEADERS += kernel/qiouring_linux_p.h
+    }
+
     qtConfig(glib) {
         SOURCES += \
             kernel/qeventdispatcher_glib.cpp
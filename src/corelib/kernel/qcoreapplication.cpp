@@ -123,6 +123,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 
 QT_BEGIN_NAMESPACE
 
@@ -340,6 +341,8 @@ bool QCoreApplicationPrivate::is_app_closing = false;
 Q_CORE_EXPORT uint qGlobalPostedEventsCount()
 {
     QThreadData *currentThreadData = QThreadData::current();
+    const auto locker = qt_scoped_lock(currentThreadData->postEventList.mutex);
+    currentThreadData->addPendingEvents();
     return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset;
 }
 
@@ -488,6 +491,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->addPendingEvents();
         for (int i = 0; i < thisThreadData->postEventList.size(); ++i) {
             const QPostEvent &pe = thisThreadData->postEventList.at(i);
             if (pe.event) {
@@ -1493,6 +1497,7 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     if (!object) {
         locker.threadData = QThreadData::current();
         locker.locker = qt_unique_lock(locker.threadData->postEventList.mutex);
+        locker.threadData->addPendingEvents();
         return locker;
     }
 
@@ -1515,6 +1520,7 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     }
 
     Q_ASSERT(locker.threadData);
+    locker.threadData->addPendingEvents();
     return locker;
 }
 
@@ -1553,6 +1559,12 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // queued calls bypass compressEvent(), see there
+    if (priority == Qt::NormalEventPriority && event->type() == QEvent::MetaCall) {
+        QCoreApplicationPrivate::postEventWithoutLock(receiver, event);
+        return;
+    }
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1610,9 +1622,52 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         dispatcher->wakeUp();
 }
 
+/*!
+  \internal
+
+  Posts \a event for \a receiver with the default priority without taking
+  the mutex of the post event list, for queued calls. They are never
+  compressed, so they only need to be in the list by the time somebody
+  looks at it with the mutex held.
+*/
+void QCoreApplicationPrivate::postEventWithoutLock(QObject *receiver, QEvent *event)
+{
+    auto &threadData = QObjectPrivate::get(receiver)->threadData;
+    QThreadData *data = threadData.loadAcquire();
+    if (!data) {
+        // posting during destruction? just delete the event to prevent a leak
+        delete event;
+        return;
+    }
+
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+    event->posted = true;
+    data->postEventList.pushPendingEvent(new QPostEventList::PendingEvent{ receiver, event, nullptr });
+
+    // If the receiver has just been moved to another thread, moveToThread()
+    // may have looked at the pending events before this one was pushed. The
+    // fence pairs with the one in QObject::moveToThread(): if it missed the
+    // event, we see the new thread and pass the event on ourselves.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (threadData.loadRelaxed() != data) {
+        const auto locker = qt_scoped_lock(data->postEventList.mutex);
+        data->addPendingEvents();
+    }
+
+    QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+    if (dispatcher)
+        dispatcher->wakeUp();
+}
+
 /*!
   \internal
   Returns \c true if \a event was compressed away (possibly deleted) and should not be added to the list.
+
+  Queued calls, that is QEvent::MetaCall events posted with
+  Qt::NormalEventPriority, are never passed to this function, not even to
+  reimplementations of it: postEvent() hands them to
+  postEventWithoutLock(), which does not lock the post event list that
+  this function would need.
 */
 bool QCoreApplication::compressEvent(QEvent *event, QObject *receiver, QPostEventList *postedEvents)
 {
@@ -1707,6 +1762,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->addPendingEvents();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1924,6 +1980,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->addPendingEvents();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -59,6 +59,10 @@
 #  include <sys/eventfd.h>
 #endif
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#endif
+
 // VxWorks doesn't correctly set the _POSIX_... options
 #if defined(Q_OS_VXWORKS)
 #  if defined(_POSIX_MONOTONIC_CLOCK) && (_POSIX_MONOTONIC_CLOCK <= 0)
@@ -226,12 +230,34 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+#if QT_CONFIG(io_uring)
+    // Opt-in: socket notifier changes are queued in the submission ring and
+    // handed to the kernel together with the wait, in a single system call
+    // per iteration. Kernels without (a new enough) io_uring, or where it is
+    // disabled, silently fall back to epoll or poll().
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_IO_URING") > 0 && ioUring.init(256))
+        return;
+#endif
+
+#if QT_CONFIG(epoll)
+    // Opt-in: with thousands of socket notifiers, rebuilding the pollfd array
+    // on every iteration dominates; an epoll set is updated incrementally
+    // instead and only its descriptor is handed to poll().
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0) {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (Q_UNLIKELY(epollFd < 0))
+            qErrnoWarning("QEventDispatcherUNIXPrivate(): Unable to create epoll set, using poll()");
+    }
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
-    // cleanup timers
-    qDeleteAll(timerList);
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
 }
 
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
@@ -249,45 +275,287 @@ int QEventDispatcherUNIXPrivate::activateTimers()
     return timerList.activateTimers();
 }
 
+void QEventDispatcherUNIXPrivate::markPendingSocketNotifierSet(int fd, const QSocketNotifierSetUNIX &sn_set,
+                                                               short revents)
+{
+    static const struct {
+        QSocketNotifier::Type type;
+        short flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
+        { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
+        { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
+    };
+
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = sn_set.notifiers[n.type];
+
+        if (!notifier)
+            continue;
+
+        if (revents & POLLNVAL) {
+            qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
+                     fd, socketType(n.type));
+            notifier->setEnabled(false);
+        }
+
+        if (revents & n.flags)
+            setSocketNotifierPending(notifier);
+    }
+}
+
 void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
 {
     for (const pollfd &pfd : qAsConst(pollfds)) {
         if (pfd.fd < 0 || pfd.revents == 0)
             continue;
 
+#if QT_CONFIG(epoll)
+        if (pfd.fd == epollFd) {
+            markPendingEpollNotifiers();
+            continue;
+        }
+#endif
+
         auto it = socketNotifiers.find(pfd.fd);
         Q_ASSERT(it != socketNotifiers.end());
 
-        const QSocketNotifierSetUNIX &sn_set = it.value();
+        markPendingSocketNotifierSet(it.key(), it.value(), pfd.revents);
+    }
+
+    pollfds.clear();
+}
+
+void QEventDispatcherUNIXPrivate::socketNotifierEventsChanged(int fd, short oldEvents, short newEvents)
+{
+    if (oldEvents == newEvents)
+        return;
+
+#if QT_CONFIG(io_uring)
+    if (ioUring.isValid()) {
+        updateIoUringNotifier(fd, oldEvents, newEvents);
+        return;
+    }
+#endif
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0) {
+        updateEpollNotifier(fd, oldEvents, newEvents);
+        return;
+    }
+#endif
+
+    // with poll(), the descriptor set is rebuilt on every iteration
+    Q_UNUSED(fd);
+}
 
-        static const struct {
-            QSocketNotifier::Type type;
-            short flags;
-        } notifiers[] = {
-            { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
-            { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
-            { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
-        };
+#if QT_CONFIG(io_uring)
+enum : quint64 {
+    // user data of requests that are not about a socket notifier; valid
+    // descriptors never have all of the low 32 bits set
+    IoUringThreadPipeTag = ~Q_UINT64_C(0),
+    IoUringRemoveTag = ~Q_UINT64_C(0) - 1
+};
 
-        for (const auto &n : notifiers) {
-            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+quint64 QEventDispatcherUNIXPrivate::nextIoUringUserData(int fd)
+{
+    // the generation tells completions of since cancelled requests apart
+    // from those of the request currently armed for the same descriptor
+    if (++ioUringGeneration == 0)
+        ++ioUringGeneration;
+    return (quint64(ioUringGeneration) << 32) | quint32(fd);
+}
 
-            if (!notifier)
+void QEventDispatcherUNIXPrivate::updateIoUringNotifier(int fd, short oldEvents, short newEvents)
+{
+    Q_UNUSED(oldEvents);
+
+    // A poll request holds a reference to the file itself, so it must be
+    // cancelled explicitly: closing the descriptor does not end it.
+    auto it = ioUringPolls.find(fd);
+    if (it != ioUringPolls.end() && it->userData) {
+        ioUring.queuePollRemove(it->userData, IoUringRemoveTag);
+        it->userData = 0;
+    }
+
+    if (!newEvents) {
+        if (it != ioUringPolls.end())
+            ioUringPolls.erase(it);
+        return;
+    }
+
+    if (it == ioUringPolls.end())
+        it = ioUringPolls.insert(fd, IoUringPoll());
+    it->events = newEvents;
+    it->userData = nextIoUringUserData(fd);
+    ioUring.queuePollAdd(fd, newEvents, it->userData);
+}
+
+int QEventDispatcherUNIXPrivate::processIoUringEvents(const timespec *timeout, bool includeNotifiers)
+{
+    if (!ioUringThreadPipeArmed) {
+        const pollfd pfd = threadPipe.prepare();
+        ioUring.queuePollAdd(pfd.fd, pfd.events, IoUringThreadPipeTag);
+        ioUringThreadPipeArmed = true;
+    }
+
+    if (includeNotifiers) {
+        // poll requests are one-shot; re-arming them keeps the level-triggered
+        // semantics of poll() for notifiers whose data was not fully consumed
+        for (int fd : qAsConst(ioUringRearm)) {
+            auto it = ioUringPolls.find(fd);
+            if (it == ioUringPolls.end() || it->userData)
                 continue;
+            it->userData = nextIoUringUserData(fd);
+            ioUring.queuePollAdd(fd, it->events, it->userData);
+        }
+        ioUringRearm.clear();
+    }
 
-            if (pfd.revents & POLLNVAL) {
-                qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
-                         it.key(), socketType(n.type));
-                notifier->setEnabled(false);
-            }
+    const bool wait = !timeout || timeout->tv_sec || timeout->tv_nsec;
+    if (ioUring.submitAndWait(wait ? 1 : 0, timeout) == -1
+            && errno != ETIME && errno != EINTR && errno != EBUSY) {
+        perror("io_uring_enter");
+    }
 
-            if (pfd.revents & n.flags)
-                setSocketNotifierPending(notifier);
+    int nevents = 0;
+    ioUring.processCompletions([&](quint64 userData, int result) {
+        if (userData == IoUringRemoveTag)
+            return;
+
+        if (userData == IoUringThreadPipeTag) {
+            ioUringThreadPipeArmed = false;
+            pollfd pfd = threadPipe.prepare();
+            pfd.revents = result > 0 ? short(result) : 0;
+            nevents += threadPipe.check(pfd);
+            return;
         }
+
+        const int fd = int(quint32(userData));
+        auto it = ioUringPolls.find(fd);
+        if (it == ioUringPolls.end() || it->userData != userData)
+            return; // the notifier was changed or removed in the meantime
+
+        it->userData = 0;
+        ioUringRearm.append(fd);
+
+        if (!includeNotifiers || result == -ECANCELED)
+            return;
+
+        auto sn = socketNotifiers.constFind(fd);
+        if (sn == socketNotifiers.cend())
+            return;
+
+        short revents = short(result);
+        if (result < 0)
+            revents = (result == -EBADF) ? POLLNVAL : POLLERR;
+        markPendingSocketNotifierSet(fd, sn.value(), revents);
+    });
+
+    if (includeNotifiers)
+        nevents += activateSocketNotifiers();
+
+    return nevents;
+}
+#endif // QT_CONFIG(io_uring)
+
+#if QT_CONFIG(epoll)
+static inline uint32_t epollEventsFromPollEvents(short events)
+{
+    uint32_t result = 0;
+    if (events & POLLIN)
+        result |= EPOLLIN;
+    if (events & POLLOUT)
+        result |= EPOLLOUT;
+    if (events & POLLPRI)
+        result |= EPOLLPRI;
+    return result;
+}
+
+static inline short pollEventsFromEpollEvents(uint32_t events)
+{
+    short result = 0;
+    if (events & EPOLLIN)
+        result |= POLLIN;
+    if (events & EPOLLOUT)
+        result |= POLLOUT;
+    if (events & EPOLLPRI)
+        result |= POLLPRI;
+    if (events & EPOLLERR)
+        result |= POLLERR;
+    if (events & EPOLLHUP)
+        result |= POLLHUP;
+    return result;
+}
+
+void QEventDispatcherUNIXPrivate::updateEpollNotifier(int fd, short oldEvents, short newEvents)
+{
+    Q_ASSERT(epollFd >= 0);
+
+    if (epollUnsupportedFds.contains(fd)) {
+        if (!newEvents)
+            epollUnsupportedFds.remove(fd);
+        return;
     }
 
-    pollfds.clear();
+    int ret;
+    if (!newEvents) {
+        // the descriptor may already be closed, which removed it from the set
+        ret = epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        if (ret == -1 && errno != EBADF && errno != ENOENT)
+            qErrnoWarning("QEventDispatcherUNIX: Unable to remove socket %d from epoll set", fd);
+        return;
+    }
+
+    // level-triggered, so that notifiers behave exactly as with poll()
+    epoll_event ev = {};
+    ev.events = epollEventsFromPollEvents(newEvents);
+    ev.data.fd = fd;
+
+    if (oldEvents) {
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+        // closing a descriptor drops it from the set; its number may since have been reused
+        if (ret == -1 && errno == ENOENT)
+            ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    } else {
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+        if (ret == -1 && errno == EEXIST)
+            ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+    }
+
+    if (ret == -1) {
+        if (errno == EPERM) {
+            // regular files and some devices cannot be watched by epoll,
+            // fall back to passing them to poll() on every iteration
+            epollUnsupportedFds.insert(fd);
+        } else {
+            qErrnoWarning("QEventDispatcherUNIX: Unable to add socket %d to epoll set", fd);
+        }
+    }
+}
+
+void QEventDispatcherUNIXPrivate::markPendingEpollNotifiers()
+{
+    // Anything not collected here is still level-triggered and will be
+    // reported again on the next iteration.
+    epoll_event events[256];
+
+    int nevents;
+    EINTR_LOOP(nevents, epoll_wait(epollFd, events, int(sizeof(events) / sizeof(events[0])), 0));
+    if (nevents == -1) {
+        perror("epoll_wait");
+        return;
+    }
+
+    for (int i = 0; i < nevents; ++i) {
+        const int fd = events[i].data.fd;
+        auto it = socketNotifiers.constFind(fd);
+        if (it == socketNotifiers.cend())
+            continue;
+
+        markPendingSocketNotifierSet(fd, it.value(), pollEventsFromEpollEvents(events[i].events));
+    }
 }
+#endif // QT_CONFIG(epoll)
 
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
 {
@@ -411,7 +679,9 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+    const short oldEvents = sn_set.events();
     sn_set.notifiers[type] = notifier;
+    d->socketNotifierEventsChanged(sockfd, oldEvents, sn_set.events());
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -450,7 +720,9 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+    const short oldEvents = sn_set.events();
     sn_set.notifiers[type] = nullptr;
+    d->socketNotifierEventsChanged(sockfd, oldEvents, sn_set.events());
 
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
@@ -487,18 +759,43 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
         tm = &wait_tm;
 
+    int nevents = 0;
+
+#if QT_CONFIG(io_uring)
+    if (d->ioUring.isValid()) {
+        nevents += d->processIoUringEvents(tm, include_notifiers);
+        if (include_timers)
+            nevents += d->activateTimers();
+        return (nevents > 0);
+    }
+#endif
+
     d->pollfds.clear();
-    d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
 
-    if (include_notifiers)
-        for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
-            d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0) {
+        // the epoll set is kept up to date by (un)registerSocketNotifier(),
+        // so only its own descriptor needs to be polled
+        d->pollfds.reserve(2 + (include_notifiers ? d->epollUnsupportedFds.size() : 0));
+
+        if (include_notifiers && !d->socketNotifiers.isEmpty()) {
+            d->pollfds.append(qt_make_pollfd(d->epollFd, POLLIN));
+            for (int fd : qAsConst(d->epollUnsupportedFds))
+                d->pollfds.append(qt_make_pollfd(fd, d->socketNotifiers.value(fd).events()));
+        }
+    } else
+#endif
+    {
+        d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
+
+        if (include_notifiers)
+            for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
+                d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+    }
 
     // This must be last, as it's popped off the end below
     d->pollfds.append(d->threadPipe.prepare());
 
-    int nevents = 0;
-
     switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
     case -1:
         perror("qt_safe_poll");
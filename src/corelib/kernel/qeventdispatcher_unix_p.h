@@ -53,10 +53,14 @@
 
 #include "QtCore/qabstracteventdispatcher.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qset.h"
 #include "private/qabstracteventdispatcher_p.h"
 #include "private/qcore_unix_p.h"
 #include "QtCore/qvarlengtharray.h"
 #include "private/qtimerinfo_unix_p.h"
+#if QT_CONFIG(io_uring)
+#  include "private/qiouring_linux_p.h"
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -139,6 +143,39 @@ public:
     void markPendingSocketNotifiers();
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
+    void markPendingSocketNotifierSet(int fd, const QSocketNotifierSetUNIX &sn_set, short revents);
+    void socketNotifierEventsChanged(int fd, short oldEvents, short newEvents);
+
+#if QT_CONFIG(io_uring)
+    struct IoUringPoll
+    {
+        quint64 userData; // of the armed poll request, 0 if not armed
+        short events;
+    };
+
+    quint64 nextIoUringUserData(int fd);
+    void updateIoUringNotifier(int fd, short oldEvents, short newEvents);
+    int processIoUringEvents(const timespec *timeout, bool includeNotifiers);
+
+    // when valid, socket notifiers are watched through one-shot poll requests
+    // that are queued in the submission ring and re-armed after they complete
+    QIoUring ioUring;
+    QHash<int, IoUringPoll> ioUringPolls;
+    QList<int> ioUringRearm;
+    quint32 ioUringGeneration = 0;
+    bool ioUringThreadPipeArmed = false;
+#endif
+
+#if QT_CONFIG(epoll)
+    void updateEpollNotifier(int fd, short oldEvents, short newEvents);
+    void markPendingEpollNotifiers();
+
+    // when >= 0, socket notifiers are kept in this epoll set instead of
+    // being collected into pollfds on every iteration
+    int epollFd = -1;
+    // descriptors that epoll refuses (e.g. regular files), still polled directly
+    QSet<int> epollUnsupportedFds;
+#endif
 
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
@@ -0,0 +1,244 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qiouring_linux_p.h"
+
+#include <private/qcore_unix_p.h>
+
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+QT_BEGIN_NAMESPACE
+
+static int io_uring_setup(unsigned entries, io_uring_params *params)
+{
+    return int(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags,
+                          const void *arg, size_t argSize)
+{
+    return int(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+}
+
+QIoUring::~QIoUring()
+{
+    if (sqes)
+        munmap(sqes, sqesSize);
+    if (cqRing && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    if (sqRing)
+        munmap(sqRing, sqRingSize);
+    if (ringFd >= 0)
+        qt_safe_close(ringFd);
+}
+
+bool QIoUring::init(unsigned entries)
+{
+    Q_ASSERT(ringFd == -1);
+
+    io_uring_params params = {};
+    params.flags = IORING_SETUP_CLAMP;
+
+    // ENOSYS on old kernels, EPERM when disabled by sysctl or a seccomp filter
+    int fd = io_uring_setup(entries, &params);
+    if (fd < 0)
+        return false;
+
+    // We need the timeout argument of io_uring_enter() (Linux 5.11) to submit
+    // and wait in one call, and must never lose a completion.
+    const unsigned requiredFeatures = IORING_FEAT_EXT_ARG | IORING_FEAT_NODROP;
+    if ((params.features & requiredFeatures) != requiredFeatures) {
+        qt_safe_close(fd);
+        return false;
+    }
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  fd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        sqRing = nullptr;
+        qt_safe_close(fd);
+        return false;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        cqRing = sqRing;
+    } else {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      fd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            cqRing = nullptr;
+            munmap(sqRing, sqRingSize);
+            sqRing = nullptr;
+            qt_safe_close(fd);
+            return false;
+        }
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         fd, IORING_OFF_SQES);
+    if (sqesMap == MAP_FAILED) {
+        if (cqRing != sqRing)
+            munmap(cqRing, cqRingSize);
+        munmap(sqRing, sqRingSize);
+        sqRing = cqRing = nullptr;
+        qt_safe_close(fd);
+        return false;
+    }
+    sqes = static_cast<io_uring_sqe *>(sqesMap);
+
+    char *sq = static_cast<char *>(sqRing);
+    sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sqFlags = reinterpret_cast<unsigned *>(sq + params.sq_off.flags);
+    sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sqEntries = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_entries);
+    sqeTail = *sqTail;
+
+    // we always fill the SQE at the same index as the ring slot,
+    // so the indirection array can be set up once
+    unsigned *sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    for (unsigned i = 0; i < sqEntries; ++i)
+        sqArray[i] = i;
+
+    char *cq = static_cast<char *>(cqRing);
+    cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    ringFd = fd;
+    return true;
+}
+
+unsigned QIoUring::pendingSubmissions() const noexcept
+{
+    return sqeTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+}
+
+int QIoUring::enter(unsigned toSubmit, unsigned minComplete, unsigned flags, const timespec *timeout)
+{
+    io_uring_getevents_arg arg = {};
+    __kernel_timespec ts;
+    if (timeout) {
+        ts.tv_sec = timeout->tv_sec;
+        ts.tv_nsec = timeout->tv_nsec;
+        arg.ts = quintptr(&ts);
+    }
+
+    // not restarted on EINTR: the caller recalculates its timeout anyway
+    return io_uring_enter(ringFd, toSubmit, minComplete, flags | IORING_ENTER_EXT_ARG,
+                          &arg, sizeof(arg));
+}
+
+io_uring_sqe *QIoUring::nextSubmission()
+{
+    Q_ASSERT(isValid());
+
+    if (pendingSubmissions() >= sqEntries) {
+        // the submission queue is full, hand what we have to the kernel
+        publishSubmissions();
+        if (enter(pendingSubmissions(), 0, 0, nullptr) == -1 || pendingSubmissions() >= sqEntries)
+            return nullptr;
+    }
+
+    // the entry is only made visible to the kernel by publishSubmissions(),
+    // once the caller has filled it in
+    io_uring_sqe *sqe = &sqes[sqeTail & sqMask];
+    memset(sqe, 0, sizeof(*sqe));
+    ++sqeTail;
+    return sqe;
+}
+
+void QIoUring::publishSubmissions() noexcept
+{
+    // the release store orders the writes to the SQEs before the new tail
+    __atomic_store_n(sqTail, sqeTail, __ATOMIC_RELEASE);
+}
+
+void QIoUring::queuePollAdd(int fd, short events, quint64 userData)
+{
+    io_uring_sqe *sqe = nextSubmission();
+    if (Q_UNLIKELY(!sqe)) {
+        qErrnoWarning("QIoUring: Unable to queue poll request for descriptor %d", fd);
+        return;
+    }
+
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    quint32 mask = quint16(events);
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    // the kernel reads poll32_events as two swapped half-words
+    mask = (mask << 16) | (mask >> 16);
+#endif
+    sqe->poll32_events = mask;
+    sqe->user_data = userData;
+}
+
+void QIoUring::queuePollRemove(quint64 targetUserData, quint64 userData)
+{
+    io_uring_sqe *sqe = nextSubmission();
+    if (Q_UNLIKELY(!sqe)) {
+        qErrnoWarning("QIoUring: Unable to queue poll removal");
+        return;
+    }
+
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = targetUserData;
+    sqe->user_data = userData;
+}
+
+int QIoUring::submitAndWait(unsigned minComplete, const timespec *timeout)
+{
+    Q_ASSERT(isValid());
+    publishSubmissions();
+    return enter(pendingSubmissions(), minComplete, IORING_ENTER_GETEVENTS, timeout);
+}
+
+QT_END_NAMESPACE
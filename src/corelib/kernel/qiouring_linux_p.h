@@ -0,0 +1,146 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QIOURING_LINUX_P_H
+#define QIOURING_LINUX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+#include <linux/io_uring.h>
+#include <time.h>
+
+QT_REQUIRE_CONFIG(io_uring);
+
+QT_BEGIN_NAMESPACE
+
+// Minimal io_uring submission/completion ring, talking to the kernel
+// through the raw system calls so that no liburing is needed.
+class Q_CORE_EXPORT QIoUring
+{
+    Q_DISABLE_COPY_MOVE(QIoUring)
+public:
+    QIoUring() = default;
+    ~QIoUring();
+
+    // Returns false if the kernel lacks io_uring (or a feature we rely on),
+    // in which case the caller must fall back to readiness-based polling.
+    bool init(unsigned entries);
+    bool isValid() const noexcept { return ringFd >= 0; }
+
+    // Returns a zeroed entry for the caller to fill in, which the kernel
+    // only sees once submitAndWait() publishes it.
+    io_uring_sqe *nextSubmission();
+    void queuePollAdd(int fd, short events, quint64 userData);
+    void queuePollRemove(quint64 targetUserData, quint64 userData);
+
+    // Submits everything queued so far and, in the same system call, waits
+    // for at least minComplete completions or until timeout expires
+    // (a null timeout waits forever).
+    int submitAndWait(unsigned minComplete, const timespec *timeout);
+
+    template <typename Visitor>
+    int processCompletions(Visitor visitor);
+
+private:
+    int enter(unsigned toSubmit, unsigned minComplete, unsigned flags, const timespec *timeout);
+    void publishSubmissions() noexcept;
+    unsigned pendingSubmissions() const noexcept;
+
+    int ringFd = -1;
+
+    void *sqRing = nullptr;
+    size_t sqRingSize = 0;
+    void *cqRing = nullptr;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqFlags = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned sqeTail = 0; // includes the entries not published to the kernel yet
+
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe *cqes = nullptr;
+};
+
+template <typename Visitor>
+int QIoUring::processCompletions(Visitor visitor)
+{
+    int processed = 0;
+    for (;;) {
+        // we are the only consumer, so our own head needs no synchronization,
+        // but the kernel's tail must be read with acquire semantics
+        unsigned head = *cqHead;
+        const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for ( ; head != tail; ++head, ++processed) {
+            const io_uring_cqe &cqe = cqes[head & cqMask];
+            visitor(quint64(cqe.user_data), int(cqe.res));
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+        // completions that did not fit into the ring are held back by the
+        // kernel until we ask for them
+        if (!(__atomic_load_n(sqFlags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW))
+            break;
+        if (enter(0, 0, IORING_ENTER_GETEVENTS, nullptr) == -1)
+            break;
+    }
+    return processed;
+}
+
+QT_END_NAMESPACE
+
+#endif // QIOURING_LINUX_P_H
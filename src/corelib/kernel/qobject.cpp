@@ -154,6 +154,129 @@ static inline QBasicMutex *signalSlotLock(const QObject *o)
     return &_q_ObjectMutexPool[uint(quintptr(o)) % sizeof(_q_ObjectMutexPool)/sizeof(QBasicMutex)];
 }
 
+static inline ushort batchingMode(int type)
+{
+    if (type & Qt::CoalescedConnection)
+        return 2;
+    if (type & Qt::BatchedConnection)
+        return 1;
+    return 0;
+}
+
+/*
+    The queued calls of a connection made with Qt::BatchedConnection or
+    Qt::CoalescedConnection that have not been delivered yet. The arguments
+    of all calls are stored one after the other in a single buffer.
+
+    The connection appends to its batch until the QBatchedMetaCallEvent
+    posted for it closes it, when it is delivered or deleted; the next
+    emission then starts a new batch. Everything but ref_, closed and posting
+    is guarded by signalSlotLock(receiver) until the batch is closed.
+
+    The event is posted after the lock has been released. posting is set
+    until then, and ~QObject() waits for it before it lets the receiver go.
+*/
+struct QMetaCallBatch
+{
+    QMetaCallBatch(const int *argumentTypes, bool coalesce);
+    ~QMetaCallBatch()
+    {
+        clear();
+        free(data);
+    }
+
+    void ref() { ref_.ref(); }
+    void deref()
+    {
+        if (!ref_.deref())
+            delete this;
+    }
+
+    void *argument(int call, int index) const
+    {
+        return data + call * stride + offsets[index];
+    }
+
+    void append(void **argv);
+    void clear();
+
+    QAtomicInt ref_ = 1;
+    QAtomicInt closed = 0;
+    QAtomicInt posting = 0;
+    const bool coalesce;
+    bool relocatable = true;
+    int stride = 0;
+    int count = 0;
+    int capacity = 0;
+    char *data = nullptr;
+    QVarLengthArray<int, 4> types;
+    QVarLengthArray<int, 4> offsets;
+};
+
+QMetaCallBatch::QMetaCallBatch(const int *argumentTypes, bool coalesce)
+    : coalesce(coalesce)
+{
+    int offset = 0;
+    int maxAlignment = 1;
+    for (int i = 0; argumentTypes[i]; ++i) {
+        const int type = argumentTypes[i];
+        const int size = QMetaType::sizeOf(type);
+        // the alignment of a type divides its size
+        const int alignment = size ? qMin(size & -size, int(alignof(std::max_align_t))) : 1;
+        offset = (offset + alignment - 1) & -alignment;
+        types.append(type);
+        offsets.append(offset);
+        offset += size;
+        maxAlignment = qMax(maxAlignment, alignment);
+        if (!(QMetaType::typeFlags(type) & QMetaType::MovableType))
+            relocatable = false;
+    }
+    stride = (offset + maxAlignment - 1) & -maxAlignment;
+}
+
+void QMetaCallBatch::append(void **argv)
+{
+    if (coalesce)
+        clear();
+
+    if (count == capacity) {
+        const int newCapacity = capacity ? 2 * capacity : (coalesce ? 1 : 4);
+        if (stride) {
+            char *newData;
+            if (relocatable) {
+                newData = static_cast<char *>(realloc(data, size_t(newCapacity) * stride));
+                Q_CHECK_PTR(newData);
+            } else {
+                newData = static_cast<char *>(malloc(size_t(newCapacity) * stride));
+                Q_CHECK_PTR(newData);
+                for (int call = 0; call < count; ++call) {
+                    for (int i = 0; i < types.size(); ++i) {
+                        const size_t offset = size_t(call) * stride + offsets[i];
+                        QMetaType::construct(types[i], newData + offset, data + offset);
+                        QMetaType::destruct(types[i], data + offset);
+                    }
+                }
+                free(data);
+            }
+            data = newData;
+        }
+        capacity = newCapacity;
+    }
+
+    for (int i = 0; i < types.size(); ++i)
+        QMetaType::construct(types[i], argument(count, i), argv[i + 1]);
+    ++count;
+}
+
+void QMetaCallBatch::clear()
+{
+    for (int call = 0; call < count; ++call) {
+        for (int i = 0; i < types.size(); ++i)
+            QMetaType::destruct(types[i], argument(call, i));
+    }
+    count = 0;
+}
+
 #if QT_VERSION < 0x60000
 extern "C" Q_CORE_EXPORT void qt_addObject(QObject *)
 {}
@@ -220,7 +343,7 @@ QObjectPrivate::~QObjectPrivate()
         }
     }
 
-    if (postedEvents)
+    if (postedEvents || thisThreadData->postEventList.hasPendingEvents())
         QCoreApplication::removePostedEvents(q_ptr, 0);
 
     thisThreadData->deref();
@@ -1046,6 +1169,14 @@ QObject::~QObject()
                 node->isSlotObject = false;
             }
 
+            // an emission in another thread may still be posting a batch of
+            // queued calls to us, see queued_activate()
+            QMetaCallBatch *postingBatch = nullptr;
+            if (node->batch && node->batch->posting.loadRelaxed()) {
+                postingBatch = node->batch;
+                postingBatch->ref();
+            }
+
             senderData->removeConnection(node);
             if (needToUnlock)
                 m->unlock();
@@ -1055,6 +1186,13 @@ QObject::~QObject()
                 slotObj->destroyIfLastRef();
                 locker.relock();
             }
+            if (postingBatch) {
+                locker.unlock();
+                while (postingBatch->posting.loadAcquire())
+                    QThread::yieldCurrentThread();
+                postingBatch->deref();
+                locker.relock();
+            }
         }
 
         // invalidate all connections on the object and make sure
@@ -1089,6 +1227,8 @@ QObjectPrivate::Connection::~Connection()
     }
     if (isSlotObject)
         slotObj->destroyIfLastRef();
+    if (batch)
+        batch->deref();
 }
 
 
@@ -1568,8 +1708,14 @@ void QObject::moveToThread(QThread *targetThread)
     currentData->ref();
 
     // move the object
+    currentData->addPendingEvents();
     d_func()->setThreadData_helper(currentData, targetData);
 
+    // Events pushed for the object while it was being moved are passed on
+    // to targetData. The fence pairs with the one in postEventWithoutLock().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    currentData->addPendingEvents();
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -2816,7 +2962,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const char *sign
     }
 
     int *types = nullptr;
-    if ((type == Qt::QueuedConnection)
+    if ((type & ~(Qt::BatchedConnection | Qt::CoalescedConnection)) == Qt::QueuedConnection
             && !(types = queuedConnectionTypes(signalTypes.constData(), signalTypes.size()))) {
         return QMetaObject::Connection(nullptr);
     }
@@ -2897,7 +3043,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const QMetaMetho
     }
 
     int *types = nullptr;
-    if ((type == Qt::QueuedConnection)
+    if ((type & ~(Qt::BatchedConnection | Qt::CoalescedConnection)) == Qt::QueuedConnection
             && !(types = queuedConnectionTypes(signal.parameterTypes())))
         return QMetaObject::Connection(nullptr);
 
@@ -3338,6 +3484,9 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     QOrderedMutexLocker locker(signalSlotLock(sender),
                                signalSlotLock(receiver));
 
+    const ushort batching = batchingMode(type);
+    type &= ~(Qt::BatchedConnection | Qt::CoalescedConnection);
+
     QObjectPrivate::ConnectionData *scd  = QObjectPrivate::get(s)->connections.loadRelaxed();
     if (type & Qt::UniqueConnection && scd) {
         if (scd->signalVectorCount() > signal_index) {
@@ -3364,6 +3513,7 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->method_relative = method_index;
     c->method_offset = method_offset;
     c->connectionType = type;
+    c->batching = batching;
     c->isSlotObject = false;
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
@@ -3632,6 +3782,72 @@ void QMetaObject::connectSlotsByName(QObject *o)
     }
 }
 
+/*
+    Delivers the calls of a QMetaCallBatch.
+*/
+class QBatchedMetaCallEvent : public QAbstractMetaCallEvent
+{
+public:
+    // with signalSlotLock(receiver) held
+    QBatchedMetaCallEvent(const QObjectPrivate::Connection *c, const QObject *sender, int signalId)
+        : QAbstractMetaCallEvent(sender, signalId),
+          batch(c->batch),
+          slotObj(c->isSlotObject ? c->slotObj : nullptr),
+          callFunction(c->isSlotObject ? nullptr : c->callFunction),
+          method_offset(c->method_offset),
+          method_relative(c->method_relative)
+    {
+        batch->ref();
+        if (slotObj)
+            slotObj->ref();
+    }
+
+    ~QBatchedMetaCallEvent() override
+    {
+        // in case the event is removed without being delivered
+        batch->closed.storeRelaxed(1);
+        batch->deref();
+        if (slotObj)
+            slotObj->destroyIfLastRef();
+    }
+
+    void placeMetaCall(QObject *object) override;
+
+private:
+    QMetaCallBatch *batch;
+    QtPrivate::QSlotObjectBase *slotObj;
+    QObjectPrivate::StaticMetaCallFunction callFunction;
+    ushort method_offset;
+    ushort method_relative;
+};
+
+void QBatchedMetaCallEvent::placeMetaCall(QObject *object)
+{
+    {
+        // from now on, emissions start a new batch
+        QBasicMutexLocker locker(signalSlotLock(object));
+        batch->closed.storeRelaxed(1);
+    }
+
+    QPointer<QObject> guard(object);
+    QVarLengthArray<void *, 8> args(batch->types.size() + 1);
+    args[0] = nullptr; // return value
+    for (int call = 0; call < batch->count && guard; ++call) {
+        for (int i = 0; i < batch->types.size(); ++i)
+            args[i + 1] = batch->argument(call, i);
+
+        if (slotObj) {
+            slotObj->call(object, args.data());
+        } else if (callFunction && method_offset <= object->metaObject()->methodOffset()) {
+            callFunction(object, QMetaObject::InvokeMetaMethod, method_relative, args.data());
+        } else {
+            QMetaObject::metacall(object, QMetaObject::InvokeMetaMethod,
+                                  method_offset + method_relative, args.data());
+        }
+    }
+    batch->clear();
+}
+
 /*!
     \internal
 
@@ -3662,6 +3878,33 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         // the connection has been disconnected before we got the lock
         return;
     }
+
+    if (c->batching) {
+        // The arguments are copied with the lock held, as the calls can be
+        // delivered as soon as it is released.
+        if (c->batch && !c->batch->closed.loadRelaxed()) {
+            c->batch->append(argv);
+            return;
+        }
+        if (c->batch)
+            c->batch->deref();
+        QMetaCallBatch *batch = new QMetaCallBatch(argumentTypes, c->batching == 2);
+        c->batch = batch;
+        batch->append(argv);
+        QObject *receiver = c->receiver.loadRelaxed();
+        QBatchedMetaCallEvent *ev = new QBatchedMetaCallEvent(c, sender, signal);
+
+        // Don't post with the lock held. Until posting is reset, ~QObject()
+        // waits before it lets the receiver go.
+        batch->ref();
+        batch->posting.storeRelaxed(1);
+        locker.unlock();
+        QCoreApplication::postEvent(receiver, ev);
+        batch->posting.storeRelease(0);
+        batch->deref();
+        return;
+    }
+
     if (c->isSlotObject)
         c->slotObj->ref();
     locker.unlock();
@@ -4936,6 +5179,9 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     QOrderedMutexLocker locker(signalSlotLock(sender),
                                signalSlotLock(receiver));
 
+    const ushort batching = batchingMode(type);
+    type = static_cast<Qt::ConnectionType>(type & ~(Qt::BatchedConnection | Qt::CoalescedConnection));
+
     if (type & Qt::UniqueConnection && slot && QObjectPrivate::get(s)->connections.loadRelaxed()) {
         QObjectPrivate::ConnectionData *connections = QObjectPrivate::get(s)->connections.loadRelaxed();
         if (connections->signalVectorCount() > signal_index) {
@@ -4961,6 +5207,7 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     c->receiver.storeRelaxed(r);
     c->slotObj = slotObj;
     c->connectionType = type;
+    c->batching = batching;
     c->isSlotObject = true;
     if (types) {
         c->argumentTypes.storeRelaxed(types);
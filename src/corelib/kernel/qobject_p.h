@@ -95,6 +95,8 @@ public:
     static void (*setWidgetParent)(QObject *, QObject *); // Used by the QML engine to specify parents for widgets. Set by QtWidgets.
 };
 
+struct QMetaCallBatch;
+
 class Q_CORE_EXPORT QObjectPrivate : public QObjectData
 {
     Q_DECLARE_PUBLIC(QObject)
@@ -156,7 +158,10 @@ public:
         ushort connectionType : 3; // 0 == auto, 1 == direct, 2 == queued, 4 == blocking
         ushort isSlotObject : 1;
         ushort ownArgumentTypes : 1;
-        Connection() : ref_(2), ownArgumentTypes(true) {
+        ushort batching : 2; // 0 == none, 1 == batched, 2 == coalesced
+        // the queued calls not delivered yet, if batching; guarded by signalSlotLock(receiver)
+        QMetaCallBatch *batch = nullptr;
+        Connection() : ref_(2), ownArgumentTypes(true), batching(0) {
             //ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
         }
         ~Connection();
@@ -51,6 +51,11 @@
 #  include <QThread>
 #endif
 
+#include <qalgorithms.h>
+#include <qvarlengtharray.h>
+
+#include <algorithm>
+
 #include <sys/times.h>
 
 QT_BEGIN_NAMESPACE
@@ -62,6 +67,38 @@ Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
  * timerBitVec array is used for keeping track of timer identifiers.
  */
 
+static inline quint64 toMsecs(const timespec &t)
+{
+    return quint64(t.tv_sec) * 1000 + quint64(t.tv_nsec) / (1000 * 1000);
+}
+
+// The timers of a wheel slot, and the due timers, are circular lists;
+// head->prev is the tail, so that appending keeps the registration order.
+static void timerListAppend(QTimerInfo *&head, QTimerInfo *t)
+{
+    if (!head) {
+        head = t->next = t->prev = t;
+    } else {
+        t->next = head;
+        t->prev = head->prev;
+        head->prev->next = t;
+        head->prev = t;
+    }
+}
+
+static void timerListRemove(QTimerInfo *&head, QTimerInfo *t)
+{
+    if (t->next == t) {
+        head = nullptr;
+    } else {
+        t->prev->next = t->next;
+        t->next->prev = t->prev;
+        if (head == t)
+            head = t->next;
+    }
+    t->next = t->prev = nullptr;
+}
+
 QTimerInfoList::QTimerInfoList()
 {
 #if (_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC) && !defined(Q_OS_NACL)
@@ -83,7 +120,17 @@ QTimerInfoList::QTimerInfoList()
     }
 #endif
 
-    firstTimerInfo = nullptr;
+    std::fill_n(wheel, Levels * SlotsPerLevel, nullptr);
+    std::fill_n(occupied, Levels, 0);
+    wheelTime = toMsecs(updateCurrentTime());
+    dueTimers = nullptr;
+    firstWaitingTimer = nullptr;
+    firstWaitingTimerValid = true;
+}
+
+QTimerInfoList::~QTimerInfoList()
+{
+    qDeleteAll(timers);
 }
 
 timespec QTimerInfoList::updateCurrentTime()
@@ -151,10 +198,9 @@ bool QTimerInfoList::timeChanged(timespec *delta)
 void QTimerInfoList::timerRepair(const timespec &diff)
 {
     // repair all timers
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
+    for (QTimerInfo *t : qAsConst(timers))
         t->timeout = t->timeout + diff;
-    }
+    rebuildWheel();
 }
 
 void QTimerInfoList::repairTimersIfNeeded()
@@ -175,17 +221,155 @@ void QTimerInfoList::repairTimersIfNeeded()
 #endif
 
 /*
-  insert timer info into list
+  insert timer info into the wheel
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
+    if (std::all_of(occupied, occupied + Levels, [](quint64 bits) { return bits == 0; })) {
+        // nothing to cascade, so skip ahead; this keeps new timers on low levels
+        wheelTime = qMax(wheelTime, toMsecs(currentTime));
+    }
+
+    // The level is that of the most significant digit (in base 64) in which
+    // the timeout differs from the wheel's time. That also makes the slots
+    // of each level ordered by time, and all of them later than the slots of
+    // the levels below. A slot is cascaded down once the wheel reaches it.
+    const quint64 tick = qMax(toMsecs(ti->timeout), wheelTime);
+    const quint64 diff = tick ^ wheelTime;
+    const int level = diff ? (63 - int(qCountLeadingZeroBits(diff))) / LevelBits : 0;
+    const int index = int(tick >> (level * LevelBits)) & (SlotsPerLevel - 1);
+
+    ti->slot = level * SlotsPerLevel + index;
+    timerListAppend(wheel[ti->slot], ti);
+    occupied[level] |= Q_UINT64_C(1) << index;
+
+    updateFirstWaitingTimer(ti);
+}
+
+void QTimerInfoList::updateFirstWaitingTimer(QTimerInfo *t)
+{
+    if (firstWaitingTimerValid && !t->activateRef
+            && (!firstWaitingTimer || t->timeout < firstWaitingTimer->timeout)) {
+        firstWaitingTimer = t;
+    }
+}
+
+void QTimerInfoList::wheelRemove(QTimerInfo *t)
+{
+    if (t->slot == DueSlot) {
+        timerListRemove(dueTimers, t);
+    } else {
+        timerListRemove(wheel[t->slot], t);
+        if (!wheel[t->slot])
+            occupied[t->slot / SlotsPerLevel] &= ~(Q_UINT64_C(1) << (t->slot % SlotsPerLevel));
+    }
+
+    if (t == firstWaitingTimer)
+        firstWaitingTimerValid = false;
+}
+
+void QTimerInfoList::rebuildWheel()
+{
+    std::fill_n(wheel, Levels * SlotsPerLevel, nullptr);
+    std::fill_n(occupied, Levels, 0);
+    wheelTime = toMsecs(currentTime);
+    firstWaitingTimerValid = false;
+
+    for (QTimerInfo *t : qAsConst(timers)) {
+        if (t->slot != DueSlot)
+            timerInsert(t);
+    }
+}
+
+/*
+  Advance the wheel to \a now, moving the timers that have expired to the
+  list of due timers, in the order of their timeouts.
+*/
+void QTimerInfoList::collectExpiredTimers(timespec now)
+{
+    const quint64 nowTick = toMsecs(now);
+    QVarLengthArray<QTimerInfo *, 64> expired;
+
+    int level = 0;
+    while (level < Levels) {
+        if (!occupied[level]) {
+            ++level;
+            continue;
+        }
+
+        // the first non-empty slot of the lowest non-empty level holds the
+        // earliest timers
+        const int index = int(qCountTrailingZeroBits(occupied[level]));
+        const int shift = level * LevelBits;
+        const quint64 levelMask = shift + LevelBits < 64
+                ? (Q_UINT64_C(1) << (shift + LevelBits)) - 1
+                : ~Q_UINT64_C(0);
+        const quint64 slotStart = (wheelTime & ~levelMask) | (quint64(index) << shift);
+        if (slotStart > nowTick)
+            break;
+
+        QTimerInfo *&slot = wheel[level * SlotsPerLevel + index];
+        QTimerInfo *list = slot;
+        slot = nullptr;
+        occupied[level] &= ~(Q_UINT64_C(1) << index);
+        wheelTime = slotStart;
+
+        if (level > 0) {
+            // cascade: now that the wheel is at the start of the slot, its
+            // timers go to the levels below
+            while (QTimerInfo *t = list) {
+                timerListRemove(list, t);
+                timerInsert(t);
+            }
+            level = 0;
+            continue;
+        }
+
+        while (QTimerInfo *t = list) {
+            timerListRemove(list, t);
+            if (now < t->timeout) {
+                // due later within the current millisecond
+                timerInsert(t);
+            } else {
+                if (t == firstWaitingTimer)
+                    firstWaitingTimerValid = false;
+                expired.append(t);
+            }
+        }
+
+        // anything left is in a later millisecond
+        if (slotStart == nowTick)
             break;
     }
-    insert(index+1, ti);
+    wheelTime = qMax(wheelTime, nowTick);
+
+    std::stable_sort(expired.begin(), expired.end(), [](const QTimerInfo *a, const QTimerInfo *b) {
+        return a->timeout < b->timeout;
+    });
+    for (QTimerInfo *t : qAsConst(expired)) {
+        t->slot = DueSlot;
+        timerListAppend(dueTimers, t);
+    }
+}
+
+QTimerInfo *QTimerInfoList::findFirstWaitingTimer()
+{
+    for (int level = 0; level < Levels; ++level) {
+        for (quint64 bits = occupied[level]; bits; bits &= bits - 1) {
+            QTimerInfo * const head = wheel[level * SlotsPerLevel + qCountTrailingZeroBits(bits)];
+            QTimerInfo *first = nullptr;
+            QTimerInfo *t = head;
+            do {
+                if (!t->activateRef && (!first || t->timeout < first->timeout))
+                    first = t;
+                t = t->next;
+            } while (t != head);
+
+            if (first)
+                return first;
+        }
+    }
+    return nullptr;
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -390,11 +574,23 @@ bool QTimerInfoList::timerWait(timespec &tm)
 
     // Find first waiting timer not already active
     QTimerInfo *t = nullptr;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
-            break;
+    if (QTimerInfo * const head = dueTimers) {
+        QTimerInfo *due = head;
+        do {
+            if (!due->activateRef) {
+                t = due;
+                break;
+            }
+            due = due->next;
+        } while (due != head);
+    }
+
+    if (!t) {
+        if (!firstWaitingTimerValid) {
+            firstWaitingTimer = findFirstWaitingTimer();
+            firstWaitingTimerValid = true;
         }
+        t = firstWaitingTimer;
     }
 
     if (!t)
@@ -423,16 +619,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timers.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -451,6 +644,8 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
     t->timerType = timerType;
     t->obj = object;
     t->activateRef = nullptr;
+    t->next = t->prev = nullptr;
+    t->slot = DueSlot;
 
     timespec expected = updateCurrentTime() + interval;
 
@@ -493,6 +688,7 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
             ++t->timeout.tv_sec;
     }
 
+    timers.insert(timerId, t);
     timerInsert(t);
 
 #ifdef QTIMERINFO_DEBUG
@@ -505,42 +701,37 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
 #endif
 }
 
+void QTimerInfoList::removeTimer(QTimerInfo *t)
+{
+    wheelRemove(t);
+    if (t->activateRef)
+        *(t->activateRef) = nullptr;
+    delete t;
+}
+
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
+    QTimerInfo *t = timers.take(timerId);
+    if (!t)
+        return false; // id not found
+
     // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    removeTimer(t);
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
+    for (auto it = timers.begin(); it != timers.end(); ) {
+        QTimerInfo *t = it.value();
         if (t->obj == object) {
             // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            // move back one so that we don't skip the new current item
-            --i;
+            it = timers.erase(it);
+            removeTimer(t);
+        } else {
+            ++it;
         }
     }
     return true;
@@ -549,8 +740,7 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < count(); ++i) {
-        const QTimerInfo * const t = at(i);
+    for (const QTimerInfo *t : timers) {
         if (t->obj == object) {
             list << QAbstractEventDispatcher::TimerInfo(t->id,
                                                         (t->timerType == Qt::VeryCoarseTimer
@@ -570,42 +760,23 @@ int QTimerInfoList::activateTimers()
     if (qt_disable_lowpriority_timers || isEmpty())
         return 0; // nothing to do
 
-    int n_act = 0, maxCount = 0;
-    firstTimerInfo = nullptr;
+    int n_act = 0;
 
     timespec currentTime = updateCurrentTime();
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << currentTime;
     repairTimersIfNeeded();
 
-
-    // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
-        maxCount++;
-    }
+    // Move the expired timers to the due list. Timers are put back into the
+    // wheel before being activated, so none is sent twice by one call, while
+    // a nested call (from a nested event loop) continues with the due list.
+    collectExpiredTimers(currentTime);
 
     //fire the timers.
-    while (maxCount--) {
-        if (isEmpty())
-            break;
-
-        QTimerInfo *currentTimerInfo = constFirst();
-        if (currentTime < currentTimerInfo->timeout)
-            break; // no timer has expired
-
-        if (!firstTimerInfo) {
-            firstTimerInfo = currentTimerInfo;
-        } else if (firstTimerInfo == currentTimerInfo) {
-            // avoid sending the same timer multiple times
-            break;
-        } else if (currentTimerInfo->interval <  firstTimerInfo->interval
-                   || currentTimerInfo->interval == firstTimerInfo->interval) {
-            firstTimerInfo = currentTimerInfo;
-        }
+    while (dueTimers) {
+        QTimerInfo *currentTimerInfo = dueTimers;
 
         // remove from list
-        removeFirst();
+        timerListRemove(dueTimers, currentTimerInfo);
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -638,16 +809,19 @@ int QTimerInfoList::activateTimers()
         if (!currentTimerInfo->activateRef) {
             // send event, but don't allow it to recurse
             currentTimerInfo->activateRef = &currentTimerInfo;
+            if (currentTimerInfo == firstWaitingTimer)
+                firstWaitingTimerValid = false;
 
             QTimerEvent e(currentTimerInfo->id);
             QCoreApplication::sendEvent(currentTimerInfo->obj, &e);
 
-            if (currentTimerInfo)
+            if (currentTimerInfo) {
                 currentTimerInfo->activateRef = nullptr;
+                updateFirstWaitingTimer(currentTimerInfo);
+            }
         }
     }
 
-    firstTimerInfo = nullptr;
     // qDebug() << "Thread" << QThread::currentThreadId() << "activated" << n_act << "timers";
     return n_act;
 }
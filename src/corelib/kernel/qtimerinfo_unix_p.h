@@ -56,6 +56,7 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -70,6 +71,12 @@ struct QTimerInfo {
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
 
+    // position in QTimerInfoList: a circular list per wheel slot, or the
+    // list of expired timers waiting to be activated
+    QTimerInfo *next;
+    QTimerInfo *prev;
+    int slot;
+
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
     float cumulativeError;
@@ -77,8 +84,12 @@ struct QTimerInfo {
 #endif
 };
 
-class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
+// Timers are kept in a hierarchical timing wheel: registering and
+// unregistering a timer is O(1), regardless of how many are active.
+class Q_CORE_EXPORT QTimerInfoList
 {
+    Q_DISABLE_COPY_MOVE(QTimerInfoList)
+
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
     timespec previousTime;
     clock_t previousTicks;
@@ -89,11 +100,39 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     void timerRepair(const timespec &);
 #endif
 
-    // state variables used by activateTimers()
-    QTimerInfo *firstTimerInfo;
+    // Each level has 64 slots and covers 64 times the range of the level
+    // below it; level 0 has one slot per millisecond. Enough levels to cover
+    // any 64-bit millisecond time, so no overflow list is needed.
+    enum {
+        LevelBits = 6,
+        SlotsPerLevel = 1 << LevelBits,
+        Levels = (64 + LevelBits - 1) / LevelBits,
+        DueSlot = -1
+    };
+
+    QHash<int, QTimerInfo *> timers;                // all timers, by id
+    QTimerInfo *wheel[Levels * SlotsPerLevel];
+    quint64 occupied[Levels];                       // bitmap of non-empty slots
+    quint64 wheelTime;                              // in milliseconds
+    QTimerInfo *dueTimers;                          // expired, in activation order
+
+    // cache for timerWait(), which runs on every event loop iteration
+    QTimerInfo *firstWaitingTimer;
+    bool firstWaitingTimerValid;
+
+    void wheelRemove(QTimerInfo *t);
+    void rebuildWheel();
+    void collectExpiredTimers(timespec now);
+    QTimerInfo *findFirstWaitingTimer();
+    void updateFirstWaitingTimer(QTimerInfo *t);
+    void removeTimer(QTimerInfo *t);
 
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
+
+    bool isEmpty() const { return timers.isEmpty(); }
+    qsizetype size() const { return timers.size(); }
 
     timespec currentTime;
     timespec updateCurrentTime();
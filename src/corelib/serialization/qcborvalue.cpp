@@ -770,7 +770,7 @@ static QCborValue::Type convertToExtendedType(QCborContainerPrivate *d)
 {
     qint64 tag = d->elements.at(0).value;
     auto &e = d->elements[1];
-    const ByteData *b = d->byteData(e);
+    const ByteData b = d->byteData(e);
 
     auto replaceByteData = [&](const char *buf, qsizetype len, Element::ValueFlags f) {
         d->data.clear();
@@ -787,7 +787,7 @@ static QCborValue::Type convertToExtendedType(QCborContainerPrivate *d)
             e.type == QCborValue::String && (e.flags & Element::StringIsUtf16) == 0) {
             // The data is supposed to be US-ASCII. If it isn't (contains UTF-8),
             // QDateTime::fromString will fail anyway.
-            dt = QDateTime::fromString(b->asLatin1(), Qt::ISODateWithMs);
+            dt = QDateTime::fromString(b.asLatin1(), Qt::ISODateWithMs);
         } else if (tag == qint64(QCborKnownTags::UnixTime_t)) {
             qint64 msecs;
             bool ok = false;
@@ -826,8 +826,8 @@ static QCborValue::Type convertToExtendedType(QCborContainerPrivate *d)
             if (b) {
                 // normalize to a short (decoded) form, so as to save space
                 QUrl url(e.flags & Element::StringIsUtf16 ?
-                             b->asQStringRaw() :
-                             b->toUtf8String(), QUrl::StrictMode);
+                             b.asQStringRaw() :
+                             b.toUtf8String(), QUrl::StrictMode);
                 if (url.isValid()) {
                     QByteArray encoded = url.toString(QUrl::DecodeReserved).toUtf8();
                     replaceByteData(encoded, encoded.size(), {});
@@ -852,7 +852,7 @@ static QCborValue::Type convertToExtendedType(QCborContainerPrivate *d)
             // force the size to 16
             char buf[sizeof(QUuid)] = {};
             if (b)
-                memcpy(buf, b->byte(), qMin(sizeof(buf), size_t(b->len)));
+                memcpy(buf, b.byte(), qMin(sizeof(buf), size_t(b.len)));
             replaceByteData(buf, sizeof(buf), {});
 
             return QCborValue::Uuid;
@@ -1012,12 +1012,16 @@ void QCborContainerPrivate::replaceAt_complex(Element &e, const QCborValue &valu
         // String data, copy contents
         e = value.container->elements.at(value.n);
 
-        // Copy string data, if any
-        if (const ByteData *b = value.container->byteData(value.n)) {
+        // Copy string data, if any, unless it is in the JSON text that this
+        // container refers to as well
+        const bool sameSource = (e.flags & Element::StringIsExternal)
+                && sourceData.constData() == value.container->sourceData.constData();
+        if (const ByteData b = value.container->byteData(value.n); b && !sameSource) {
+            e.flags &= ~Element::StringIsExternal;
             if (this == value.container)
-                e.value = addByteData(b->toByteArray(), b->len);
+                e.value = addByteData(b.toByteArray(), b.len);
             else
-                e.value = addByteData(b->byte(), b->len);
+                e.value = addByteData(b.byte(), b.len);
         }
 
         if (disp == MoveContainer)
@@ -1037,7 +1041,7 @@ Q_NEVER_INLINE void QCborContainerPrivate::appendAsciiString(QStringView s)
     e.flags = Element::HasByteData | Element::StringIsAscii;
     elements.append(e);
 
-    char *ptr = data.data() + e.value + sizeof(ByteData);
+    char *ptr = data.data() + e.value + sizeof(ByteDataHeader);
     uchar *l = reinterpret_cast<uchar *>(ptr);
     qt_to_latin1_unchecked(l, s.utf16(), len);
 }
@@ -1050,10 +1054,14 @@ QCborValue QCborContainerPrivate::extractAt_complex(Element e)
     auto b = byteData(e);
     auto container = new QCborContainerPrivate;
 
-    if (b->len + qsizetype(sizeof(*b)) < data.size() / 4) {
+    if (e.flags & Element::StringIsExternal) {
+        // keep referring to the same JSON text
+        container->sourceData = sourceData;
+        container->elements.append(e);
+    } else if (b.len + qsizetype(sizeof(ByteDataHeader)) < data.size() / 4) {
         // make a shallow copy of the byte data
-        container->appendByteData(b->byte(), b->len, e.type, e.flags);
-        usedData -= b->len + qsizetype(sizeof(*b));
+        container->appendByteData(b.byte(), b.len, e.type, e.flags);
+        usedData -= b.len + qsizetype(sizeof(ByteDataHeader));
         compact(elements.size());
     } else {
         // just share with the original byte data
@@ -1122,11 +1130,11 @@ static int compareElementRecursive(const QCborContainerPrivate *c1, const Elemen
                                 e2.flags & Element::IsContainer ? e2.container : nullptr);
 
     // string data?
-    const ByteData *b1 = c1 ? c1->byteData(e1) : nullptr;
-    const ByteData *b2 = c2 ? c2->byteData(e2) : nullptr;
+    const ByteData b1 = c1 ? c1->byteData(e1) : ByteData();
+    const ByteData b2 = c2 ? c2->byteData(e2) : ByteData();
     if (b1 || b2) {
-        auto len1 = b1 ? b1->len : 0;
-        auto len2 = b2 ? b2->len : 0;
+        auto len1 = b1 ? b1.len : 0;
+        auto len2 = b2 ? b2.len : 0;
 
         if (e1.flags & Element::StringIsUtf16)
             len1 /= 2;
@@ -1153,7 +1161,7 @@ static int compareElementRecursive(const QCborContainerPrivate *c1, const Elemen
             // Case 1: both UTF-16, so lengths are comparable.
             // (we can't use memcmp in little-endian machines)
             if (len1 == len2)
-                return QtPrivate::compareStrings(b1->asStringView(), b2->asStringView());
+                return QtPrivate::compareStrings(b1.asStringView(), b2.asStringView());
             return len1 < len2 ? -1 : 1;
         }
 
@@ -1161,15 +1169,15 @@ static int compareElementRecursive(const QCborContainerPrivate *c1, const Elemen
             // Cases 4, 5 and 6: neither is UTF-16, so lengths are comparable too
             // (this case includes byte arrays too)
             if (len1 == len2)
-                return memcmp(b1->byte(), b2->byte(), size_t(len1));
+                return memcmp(b1.byte(), b2.byte(), size_t(len1));
             return len1 < len2 ? -1 : 1;
         }
 
         if (!(e1.flags & Element::StringIsAscii) || !(e2.flags & Element::StringIsAscii)) {
             // Case 2: one of them is UTF-8 and the other is UTF-16, so lengths
             // are NOT comparable. We need to convert to UTF-16 first...
-            auto string = [](const Element &e, const ByteData *b) {
-                return e.flags & Element::StringIsUtf16 ? b->asQStringRaw() : b->toUtf8String();
+            auto string = [](const Element &e, const ByteData &b) {
+                return e.flags & Element::StringIsUtf16 ? b.asQStringRaw() : b.toUtf8String();
             };
 
             QString s1 = string(e1, b1);
@@ -1183,8 +1191,8 @@ static int compareElementRecursive(const QCborContainerPrivate *c1, const Elemen
         if (len1 != len2)
             return len1 < len2 ? -1 : 1;
         if (e1.flags & Element::StringIsUtf16)
-            return QtPrivate::compareStrings(b1->asStringView(), b2->asLatin1());
-        return QtPrivate::compareStrings(b1->asLatin1(), b2->asStringView());
+            return QtPrivate::compareStrings(b1.asStringView(), b2.asLatin1());
+        return QtPrivate::compareStrings(b1.asLatin1(), b2.asStringView());
     }
 
     return compareElementNoData(e1, e2);
@@ -1365,21 +1373,21 @@ static void encodeToCbor(QCborStreamWriter &writer, const QCborContainerPrivate
     } else {
         // just one element
         auto e = d->elements.at(idx);
-        const ByteData *b = d->byteData(idx);
+        const ByteData b = d->byteData(idx);
         switch (e.type) {
         case QCborValue::Integer:
             return writer.append(qint64(e.value));
 
         case QCborValue::ByteArray:
             if (b)
-                return writer.appendByteString(b->byte(), b->len);
+                return writer.appendByteString(b.byte(), b.len);
             return writer.appendByteString("", 0);
 
         case QCborValue::String:
             if (b) {
                 if (e.flags & Element::StringIsUtf16)
-                    return writer.append(b->asStringView());
-                return writer.appendTextString(b->byte(), b->len);
+                    return writer.append(b.asStringView());
+                return writer.appendTextString(b.byte(), b.len);
             }
             return writer.append(QLatin1String());
 
@@ -1560,8 +1568,8 @@ void QCborContainerPrivate::decodeStringFromCbor(QCborStreamReader &reader)
     auto addByteData_local = [this](QByteArray::size_type len) -> qint64 {
         // this duplicates a lot of addByteData, but with overflow checking
         QByteArray::size_type newSize;
-        QByteArray::size_type increment = sizeof(QtCbor::ByteData);
-        QByteArray::size_type alignment = alignof(QtCbor::ByteData);
+        QByteArray::size_type increment = sizeof(QtCbor::ByteDataHeader);
+        QByteArray::size_type alignment = alignof(QtCbor::ByteDataHeader);
         QByteArray::size_type offset = data.size();
 
         // calculate the increment we want
@@ -1616,7 +1624,7 @@ void QCborContainerPrivate::decodeStringFromCbor(QCborStreamReader &reader)
 
     // read chunks
     bool isAscii = (e.type == QCborValue::String);
-    auto r = reader.readStringChunk(dataPtr() + e.value + sizeof(ByteData), len);
+    auto r = reader.readStringChunk(dataPtr() + e.value + sizeof(ByteDataHeader), len);
     while (r.status == QCborStreamReader::Ok) {
         if (e.type == QCborValue::String && len) {
             // verify UTF-8 string validity
@@ -1652,7 +1660,7 @@ void QCborContainerPrivate::decodeStringFromCbor(QCborStreamReader &reader)
 
     // update size
     if (r.status == QCborStreamReader::EndOfString && e.flags & Element::HasByteData) {
-        auto b = new (dataPtr() + e.value) ByteData;
+        auto b = new (dataPtr() + e.value) ByteDataHeader;
         b->len = data.size() - e.value - int(sizeof(*b));
         usedData += b->len;
 
@@ -2009,13 +2017,13 @@ QDateTime QCborValue::toDateTime(const QDateTime &defaultValue) const
         return defaultValue;
 
     Q_ASSERT(n == -1);
-    const ByteData *byteData = container->byteData(1);
+    const ByteData byteData = container->byteData(1);
     if (!byteData)
         return defaultValue; // date/times are never empty, so this must be invalid
 
     // Our data must be US-ASCII.
     Q_ASSERT((container->elements.at(1).flags & Element::StringIsUtf16) == 0);
-    return QDateTime::fromString(byteData->asLatin1(), Qt::ISODateWithMs);
+    return QDateTime::fromString(byteData.asLatin1(), Qt::ISODateWithMs);
 }
 
 #ifndef QT_BOOTSTRAPPED
@@ -2033,11 +2041,11 @@ QUrl QCborValue::toUrl(const QUrl &defaultValue) const
         return defaultValue;
 
     Q_ASSERT(n == -1);
-    const ByteData *byteData = container->byteData(1);
+    const ByteData byteData = container->byteData(1);
     if (!byteData)
         return QUrl();  // valid, empty URL
 
-    return QUrl::fromEncoded(byteData->asByteArrayView());
+    return QUrl::fromEncoded(byteData.asByteArrayView());
 }
 #endif
 
@@ -2076,11 +2084,11 @@ QUuid QCborValue::toUuid(const QUuid &defaultValue) const
         return defaultValue;
 
     Q_ASSERT(n == -1);
-    const ByteData *byteData = container->byteData(1);
+    const ByteData byteData = container->byteData(1);
     if (!byteData)
         return defaultValue; // UUIDs must always be 16 bytes, so this must be invalid
 
-    return QUuid::fromRfc4122(byteData->asByteArrayView());
+    return QUuid::fromRfc4122(byteData.asByteArrayView());
 }
 
 /*!
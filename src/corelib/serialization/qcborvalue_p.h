@@ -68,7 +68,8 @@ struct Element
         IsContainer                 = 0x0001,
         HasByteData                 = 0x0002,
         StringIsUtf16               = 0x0004,
-        StringIsAscii               = 0x0008
+        StringIsAscii               = 0x0008,
+        StringIsExternal            = 0x0010
     };
     Q_DECLARE_FLAGS(ValueFlags, ValueFlag)
 
@@ -97,14 +98,28 @@ struct Element
 Q_DECLARE_OPERATORS_FOR_FLAGS(Element::ValueFlags)
 static_assert(sizeof(Element) == 16);
 
-struct ByteData
+// How byte data is stored in QCborContainerPrivate::data: the length,
+// followed by the bytes.
+struct ByteDataHeader
 {
     QByteArray::size_type len;
 
     const char *byte() const        { return reinterpret_cast<const char *>(this + 1); }
     char *byte()                    { return reinterpret_cast<char *>(this + 1); }
-    const QChar *utf16() const      { return reinterpret_cast<const QChar *>(this + 1); }
-    QChar *utf16()                  { return reinterpret_cast<QChar *>(this + 1); }
+};
+static_assert(std::is_trivial<ByteDataHeader>::value);
+static_assert(std::is_standard_layout<ByteDataHeader>::value);
+
+// The byte data of an element, wherever it is stored
+struct ByteData
+{
+    const char *ptr;
+    QByteArray::size_type len;
+
+    explicit operator bool() const  { return ptr != nullptr; }
+
+    const char *byte() const        { return ptr; }
+    const QChar *utf16() const      { return reinterpret_cast<const QChar *>(ptr); }
 
     QByteArray toByteArray() const  { return QByteArray(byte(), len); }
     QString toString() const        { return QString(utf16(), len / 2); }
@@ -133,6 +148,18 @@ public:
     QByteArray data;
     QList<QtCbor::Element> elements;
 
+    // Strings flagged StringIsExternal are not stored in data, but are the
+    // unescaped strings of the JSON text in sourceData (see
+    // QJsonDocument::ReferenceStrings). The element's value holds the offset
+    // of the string in the low ExternalOffsetBits bits, and its length in
+    // the bits above.
+    QByteArray sourceData;
+    enum : qint64 {
+        ExternalOffsetBits = 40,
+        ExternalOffsetMask = (Q_INT64_C(1) << ExternalOffsetBits) - 1,
+        MaxExternalLength = (Q_INT64_C(1) << (63 - ExternalOffsetBits)) - 1
+    };
+
     void deref() { if (!ref.deref()) delete this; }
     void compact(qsizetype reserved);
     static QCborContainerPrivate *clone(QCborContainerPrivate *d, qsizetype reserved = -1);
@@ -148,16 +175,16 @@ public:
         qptrdiff offset = data.size();
 
         // align offset
-        offset += alignof(QtCbor::ByteData) - 1;
-        offset &= ~(alignof(QtCbor::ByteData) - 1);
+        offset += alignof(QtCbor::ByteDataHeader) - 1;
+        offset &= ~(alignof(QtCbor::ByteDataHeader) - 1);
 
-        qptrdiff increment = qptrdiff(sizeof(QtCbor::ByteData)) + len;
+        qptrdiff increment = qptrdiff(sizeof(QtCbor::ByteDataHeader)) + len;
 
         usedData += increment;
         data.resize(offset + increment);
 
         char *ptr = data.begin() + offset;
-        auto b = new (ptr) QtCbor::ByteData;
+        auto b = new (ptr) QtCbor::ByteDataHeader;
         b->len = len;
         if (block)
             memcpy(b->byte(), block, len);
@@ -165,20 +192,42 @@ public:
         return offset;
     }
 
-    const QtCbor::ByteData *byteData(QtCbor::Element e) const
+    // Appends a string of len bytes starting at offset in sourceData, if
+    // the element can represent it
+    bool appendExternalString(qsizetype offset, qsizetype len,
+                              QtCbor::Element::ValueFlags extraFlags = {})
+    {
+        Q_ASSERT(offset >= 0 && len >= 0 && offset + len <= sourceData.size());
+        if (offset > ExternalOffsetMask || len > MaxExternalLength)
+            return false;
+        elements.append(QtCbor::Element(offset | (qint64(len) << ExternalOffsetBits),
+                                        QCborValue::String,
+                                        QtCbor::Element::HasByteData
+                                        | QtCbor::Element::StringIsExternal | extraFlags));
+        return true;
+    }
+
+    QtCbor::ByteData byteData(QtCbor::Element e) const
     {
         if ((e.flags & QtCbor::Element::HasByteData) == 0)
-            return nullptr;
+            return {};
+
+        if (e.flags & QtCbor::Element::StringIsExternal) {
+            const qsizetype offset = e.value & ExternalOffsetMask;
+            const qsizetype len = e.value >> ExternalOffsetBits;
+            Q_ASSERT(offset + len <= sourceData.size());
+            return { sourceData.constData() + offset, QByteArray::size_type(len) };
+        }
 
         size_t offset = size_t(e.value);
-        Q_ASSERT((offset % alignof(QtCbor::ByteData)) == 0);
-        Q_ASSERT(offset + sizeof(QtCbor::ByteData) <= size_t(data.size()));
+        Q_ASSERT((offset % alignof(QtCbor::ByteDataHeader)) == 0);
+        Q_ASSERT(offset + sizeof(QtCbor::ByteDataHeader) <= size_t(data.size()));
 
-        auto b = reinterpret_cast<const QtCbor::ByteData *>(data.constData() + offset);
+        auto b = reinterpret_cast<const QtCbor::ByteDataHeader *>(data.constData() + offset);
         Q_ASSERT(offset + sizeof(*b) + size_t(b->len) <= size_t(data.size()));
-        return b;
+        return { b->byte(), b->len };
     }
-    const QtCbor::ByteData *byteData(qsizetype idx) const
+    QtCbor::ByteData byteData(qsizetype idx) const
     {
         return byteData(elements.at(idx));
     }
@@ -208,8 +257,9 @@ public:
             e.container->deref();
             e.container = nullptr;
             e.flags = {};
-        } else if (auto b = byteData(e)) {
-            usedData -= b->len + sizeof(QtCbor::ByteData);
+        } else if ((e.flags & QtCbor::Element::StringIsExternal) == 0) {
+            if (auto b = byteData(e))
+                usedData -= b.len + sizeof(QtCbor::ByteDataHeader);
         }
         replaceAt_internal(e, value, disp);
     }
@@ -282,7 +332,7 @@ public:
         const auto data = byteData(e);
         if (!data)
             return QByteArray();
-        return data->toByteArray();
+        return data.toByteArray();
     }
     QString stringAt(qsizetype idx) const
     {
@@ -291,10 +341,10 @@ public:
         if (!data)
             return QString();
         if (e.flags & QtCbor::Element::StringIsUtf16)
-            return data->toString();
+            return data.toString();
         if (e.flags & QtCbor::Element::StringIsAscii)
-            return data->asLatin1();
-        return data->toUtf8String();
+            return data.asLatin1();
+        return data.toUtf8String();
     }
 
     static void resetValue(QCborValue &v)
@@ -362,14 +412,14 @@ public:
         return e;
     }
 
-    static int compareUtf8(const QtCbor::ByteData *b, const QLatin1String &s)
+    static int compareUtf8(QtCbor::ByteData b, const QLatin1String &s)
     {
-        return QUtf8::compareUtf8(b->byte(), b->len, s);
+        return QUtf8::compareUtf8(b.byte(), b.len, s);
     }
 
-    static int compareUtf8(const QtCbor::ByteData *b, QStringView s)
+    static int compareUtf8(QtCbor::ByteData b, QStringView s)
     {
-        return QUtf8::compareUtf8(b->byte(), b->len, s.data(), s.size());
+        return QUtf8::compareUtf8(b.byte(), b.len, s.data(), s.size());
     }
 
     template<typename String>
@@ -378,12 +428,12 @@ public:
         if (e.type != QCborValue::String)
             return int(e.type) - int(QCborValue::String);
 
-        const QtCbor::ByteData *b = byteData(e);
+        const QtCbor::ByteData b = byteData(e);
         if (!b)
             return s.isEmpty() ? 0 : -1;
 
         if (e.flags & QtCbor::Element::StringIsUtf16)
-            return QtPrivate::compareStrings(b->asStringView(), s);
+            return QtPrivate::compareStrings(b.asStringView(), s);
         return compareUtf8(b, s);
     }
 
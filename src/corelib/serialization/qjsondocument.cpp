@@ -510,8 +510,57 @@ QByteArray QJsonDocument::toJson(JsonFormat format) const
  \sa toJson(), QJsonParseError, isNull()
  */
 QJsonDocument QJsonDocument::fromJson(const QByteArray &json, QJsonParseError *error)
+{
+    return fromJson(json, error, CopyStrings);
+}
+
+/*!
+    \enum QJsonDocument::ParseMode
+    \since 6.0
+
+    This value defines how fromJson() stores the strings of the document.
+
+    \value CopyStrings         The strings are copied out of the JSON text,
+                               which is not needed anymore once fromJson()
+                               returns.
+    \value ReferenceStrings    The strings that contain no escape sequences
+                               are not copied, but refer to the JSON text,
+                               and are only decoded when they are accessed.
+                               The document and all values obtained from it
+                               keep a reference to the JSON text.
+*/
+
+/*!
+    \since 6.0
+    \overload
+
+    Parses \a json as a UTF-8 encoded JSON document, storing its strings as
+    specified by \a mode, and creates a QJsonDocument from it.
+
+    With ReferenceStrings, parsing a document that consists mostly of
+    strings takes less time and memory, since the member names and string
+    values are neither copied nor decoded until they are used. This suits
+    large, read-mostly documents, and particularly a file mapped into
+    memory:
+
+    \snippet code/src_corelib_serialization_qjsondocument.cpp 2
+
+    In that case, the document does not own the data of \a json, which must
+    remain valid and unmodified for as long as the document, or any
+    QJsonValue, QJsonObject or QJsonArray obtained from it, exists.
+
+    Strings copied into other documents, or into values of this document
+    when it is modified, are copied the usual way. The whole of \a json is
+    kept in memory for as long as one of them refers to it.
+
+    \sa toJson(), QJsonParseError, isNull()
+ */
+QJsonDocument QJsonDocument::fromJson(const QByteArray &json, QJsonParseError *error,
+                                      ParseMode mode)
 {
     QJsonPrivate::Parser parser(json.constData(), json.length());
+    if (mode == ReferenceStrings)
+        parser.setSourceData(json);
     QJsonDocument result;
     const QCborValue val = parser.parse(error);
     if (val.isArray() || val.isMap()) {
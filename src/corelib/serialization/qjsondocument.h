@@ -69,7 +69,8 @@ struct Q_CORE_EXPORT QJsonParseError
         MissingObject,
         DeepNesting,
         DocumentTooLarge,
-        GarbageAtEnd
+        GarbageAtEnd,
+        PrematureEndOfData
     };
 
     QString    errorString() const;
@@ -133,7 +134,13 @@ public:
         Compact
     };
 
+    enum ParseMode {
+        CopyStrings,
+        ReferenceStrings
+    };
+
     static QJsonDocument fromJson(const QByteArray &json, QJsonParseError *error = nullptr);
+    static QJsonDocument fromJson(const QByteArray &json, QJsonParseError *error, ParseMode mode);
 
 #if !defined(QT_JSON_READONLY) || defined(Q_CLANG_QDOC)
     QByteArray toJson() const; //### Merge in Qt6
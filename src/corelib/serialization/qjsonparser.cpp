@@ -47,6 +47,7 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -80,6 +81,7 @@ QT_BEGIN_NAMESPACE
 #define JSONERR_DEEP_NEST   QT_TRANSLATE_NOOP("QJsonParseError", "too deeply nested document")
 #define JSONERR_DOC_LARGE   QT_TRANSLATE_NOOP("QJsonParseError", "too large document")
 #define JSONERR_GARBAGEEND  QT_TRANSLATE_NOOP("QJsonParseError", "garbage at the end of the document")
+#define JSONERR_PREMATURE_END QT_TRANSLATE_NOOP("QJsonParseError", "premature end of data")
 
 /*!
     \class QJsonParseError
@@ -114,6 +116,8 @@ QT_BEGIN_NAMESPACE
     \value DeepNesting              The JSON document is too deeply nested for the parser to parse it
     \value DocumentTooLarge         The JSON document is too large for the parser to parse it
     \value GarbageAtEnd             The parsed document contains additional garbage characters at the end
+    \value PrematureEndOfData       The data ended in the middle of a value. Only reported by
+                                    QJsonStreamReader, where more data may still arrive (since 6.0)
 
 */
 
@@ -189,6 +193,9 @@ QString QJsonParseError::errorString() const
     case GarbageAtEnd:
         sz = JSONERR_GARBAGEEND;
         break;
+    case PrematureEndOfData:
+        sz = JSONERR_PREMATURE_END;
+        break;
     }
 #ifndef QT_BOOTSTRAPPED
     return QCoreApplication::translate("QJsonParseError", sz);
@@ -226,10 +233,195 @@ Parser::Parser(const char *json, int length)
     : head(json), json(json)
     , nestingLevel(0)
     , lastError(QJsonParseError::NoError)
+    , index(json, length)
 {
     end = json + length;
 }
 
+/*
+    The parser runs in two stages. The first stage classifies the input in
+    blocks of 64 bytes, using SIMD instructions where available, and records
+    one bit per byte for whitespace, for the characters that end the
+    unescaped part of a string (quote and backslash) and for bytes outside
+    of US-ASCII. The second stage is the recursive descent parser below,
+    which builds the tree and uses those bitmaps to skip over whitespace and
+    over the plain ASCII content of strings instead of looking at every
+    character.
+
+    The index is computed for a window of WindowBlocks blocks at a time, just
+    ahead of the parser, so that it stays in the cache and its size does not
+    depend on the size of the document.
+*/
+
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(AVX2) && !defined(QT_BOOTSTRAPPED)
+#  define JSONPARSER_AVX2
+#endif
+
+using StructuralBlock = StructuralIndex::Block;
+
+static void classifyScalar(const uchar *p, qsizetype n, StructuralBlock *block) noexcept
+{
+    quint64 space = 0;
+    quint64 quoteOrEscape = 0;
+    quint64 nonAscii = 0;
+    for (qsizetype i = 0; i < n; ++i) {
+        const quint64 bit = Q_UINT64_C(1) << i;
+        switch (p[i]) {
+        case 0x20: case 0x09: case 0x0a: case 0x0d:
+            space |= bit;
+            break;
+        case 0x22: case 0x5c:
+            quoteOrEscape |= bit;
+            break;
+        default:
+            if (p[i] >= 0x80)
+                nonAscii |= bit;
+            break;
+        }
+    }
+    *block = { space, quoteOrEscape, nonAscii };
+}
+
+#if defined(JSONPARSER_AVX2)
+static QT_FUNCTION_TARGET(AVX2)
+void classifyAvx2(const uchar *p, qsizetype count, StructuralBlock *blocks) noexcept
+{
+    const __m256i spaces = _mm256_set1_epi8(0x20);
+    const __m256i tabs = _mm256_set1_epi8(0x09);
+    const __m256i lineFeeds = _mm256_set1_epi8(0x0a);
+    const __m256i returns = _mm256_set1_epi8(0x0d);
+    const __m256i quotes = _mm256_set1_epi8(0x22);
+    const __m256i backslashes = _mm256_set1_epi8(0x5c);
+    for (qsizetype n = 0; n < count; ++n, p += 64) {
+        quint64 bits[3] = {};
+        for (int i = 0; i < 64; i += 32) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+            const __m256i space = _mm256_or_si256(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(v, spaces), _mm256_cmpeq_epi8(v, tabs)),
+                        _mm256_or_si256(_mm256_cmpeq_epi8(v, lineFeeds),
+                                        _mm256_cmpeq_epi8(v, returns)));
+            const __m256i quoteOrEscape = _mm256_or_si256(_mm256_cmpeq_epi8(v, quotes),
+                                                          _mm256_cmpeq_epi8(v, backslashes));
+            bits[0] |= quint64(uint(_mm256_movemask_epi8(space))) << i;
+            bits[1] |= quint64(uint(_mm256_movemask_epi8(quoteOrEscape))) << i;
+            bits[2] |= quint64(uint(_mm256_movemask_epi8(v))) << i;
+        }
+        blocks[n] = { bits[0], bits[1], bits[2] };
+    }
+}
+#endif
+
+// classifies count complete blocks of 64 bytes each
+static void classify(const uchar *p, qsizetype count, StructuralBlock *blocks) noexcept
+{
+#if defined(JSONPARSER_AVX2)
+    if (qCpuHasFeature(AVX2))
+        return classifyAvx2(p, count, blocks);
+#endif
+#if defined(__SSE2__)
+    const __m128i spaces = _mm_set1_epi8(0x20);
+    const __m128i tabs = _mm_set1_epi8(0x09);
+    const __m128i lineFeeds = _mm_set1_epi8(0x0a);
+    const __m128i returns = _mm_set1_epi8(0x0d);
+    const __m128i quotes = _mm_set1_epi8(0x22);
+    const __m128i backslashes = _mm_set1_epi8(0x5c);
+    for (qsizetype n = 0; n < count; ++n, p += 64) {
+        quint64 bits[3] = {};
+        for (int i = 0; i < 64; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            const __m128i space = _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(v, spaces), _mm_cmpeq_epi8(v, tabs)),
+                        _mm_or_si128(_mm_cmpeq_epi8(v, lineFeeds), _mm_cmpeq_epi8(v, returns)));
+            const __m128i quoteOrEscape = _mm_or_si128(_mm_cmpeq_epi8(v, quotes),
+                                                       _mm_cmpeq_epi8(v, backslashes));
+            bits[0] |= quint64(uint(_mm_movemask_epi8(space))) << i;
+            bits[1] |= quint64(uint(_mm_movemask_epi8(quoteOrEscape))) << i;
+            bits[2] |= quint64(uint(_mm_movemask_epi8(v))) << i;
+        }
+        blocks[n] = { bits[0], bits[1], bits[2] };
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vaddv is only available on Aarch64
+    const uint8x16_t bitMask = { 1, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7,
+                                 1, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7 };
+    const auto movemask = [&bitMask](uint8x16_t v) {
+        const uint8x16_t masked = vandq_u8(v, bitMask);
+        return quint64(vaddv_u8(vget_low_u8(masked)))
+                | quint64(vaddv_u8(vget_high_u8(masked))) << 8;
+    };
+    for (qsizetype n = 0; n < count; ++n, p += 64) {
+        quint64 bits[3] = {};
+        for (int i = 0; i < 64; i += 16) {
+            const uint8x16_t v = vld1q_u8(p + i);
+            const uint8x16_t space = vorrq_u8(
+                        vorrq_u8(vceqq_u8(v, vdupq_n_u8(0x20)), vceqq_u8(v, vdupq_n_u8(0x09))),
+                        vorrq_u8(vceqq_u8(v, vdupq_n_u8(0x0a)), vceqq_u8(v, vdupq_n_u8(0x0d))));
+            const uint8x16_t quoteOrEscape = vorrq_u8(vceqq_u8(v, vdupq_n_u8(0x22)),
+                                                      vceqq_u8(v, vdupq_n_u8(0x5c)));
+            bits[0] |= movemask(space) << i;
+            bits[1] |= movemask(quoteOrEscape) << i;
+            bits[2] |= movemask(vcgeq_u8(v, vdupq_n_u8(0x80))) << i;
+        }
+        blocks[n] = { bits[0], bits[1], bits[2] };
+    }
+#else
+    for (qsizetype n = 0; n < count; ++n, p += 64)
+        classifyScalar(p, 64, blocks + n);
+#endif
+}
+
+void StructuralIndex::fill(qsizetype firstBlock)
+{
+    const qsizetype start = firstBlock * BlockSize;
+    const qsizetype available = length - start;
+    Q_ASSERT(available > 0);
+    const qsizetype count = qMin<qsizetype>(WindowBlocks, (available + BlockSize - 1) / BlockSize);
+    const qsizetype complete = qMin<qsizetype>(count, available / BlockSize);
+
+    classify(json + start, complete, blocks);
+    if (complete < count)
+        classifyScalar(json + start + complete * BlockSize, available % BlockSize, blocks + complete);
+
+    windowStart = firstBlock;
+    windowEnd = firstBlock + count;
+}
+
+// Returns the position of the first byte in [pos, limit) whose bit is set
+// (or clear, if Invert is true) or limit if there is none.
+template <quint64 StructuralIndex::Block::*Bits, bool Invert>
+qsizetype StructuralIndex::find(qsizetype pos, qsizetype limit)
+{
+    Q_ASSERT(pos >= 0);
+    Q_ASSERT(limit <= length);
+    quint64 mask = ~Q_UINT64_C(0) << (pos % BlockSize);
+    for (qsizetype n = pos / BlockSize; n * BlockSize < limit; ++n) {
+        if (n < windowStart || n >= windowEnd)
+            fill(n);
+        quint64 bits = blocks[n - windowStart].*Bits;
+        if (Invert)
+            bits = ~bits;
+        bits &= mask;
+        if (bits)
+            return qMin(n * BlockSize + qCountTrailingZeroBits(bits), limit);
+        mask = ~Q_UINT64_C(0);
+    }
+    return limit;
+}
+
+qsizetype StructuralIndex::nextNonSpace(qsizetype pos)
+{
+    return find<&Block::space, true>(pos, length);
+}
+
+qsizetype StructuralIndex::nextQuoteOrEscape(qsizetype pos)
+{
+    return find<&Block::quoteOrEscape, false>(pos, length);
+}
+
+qsizetype StructuralIndex::nextNonAscii(qsizetype pos, qsizetype limit)
+{
+    return find<&Block::nonAscii, false>(pos, limit);
+}
+
 
 
 /*
@@ -285,16 +477,12 @@ void Parser::eatBOM()
 
 bool Parser::eatSpace()
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
-        ++json;
-    }
+    if (json >= end)
+        return false;
+    // most tokens are not preceded by whitespace at all
+    if (*json > Space)
+        return true;
+    json = head + index.nextNonSpace(json - head);
     return (json < end);
 }
 
@@ -395,8 +583,8 @@ static void sortContainer(QCborContainerPrivate *container)
         Q_ASSERT(aKey.flags & QtCbor::Element::HasByteData);
         Q_ASSERT(bKey.flags & QtCbor::Element::HasByteData);
 
-        const QtCbor::ByteData *aData = container->byteData(aKey);
-        const QtCbor::ByteData *bData = container->byteData(bKey);
+        const QtCbor::ByteData aData = container->byteData(aKey);
+        const QtCbor::ByteData bData = container->byteData(bKey);
 
         if (!aData)
             return bData ? -1 : 0;
@@ -411,31 +599,31 @@ static void sortContainer(QCborContainerPrivate *container)
 
         if (aKey.flags & QtCbor::Element::StringIsAscii) {
             if (bKey.flags & QtCbor::Element::StringIsAscii)
-                return QtPrivate::compareStrings(aData->asLatin1(), bData->asLatin1());
+                return QtPrivate::compareStrings(aData.asLatin1(), bData.asLatin1());
             if (bKey.flags & QtCbor::Element::StringIsUtf16)
-                return QtPrivate::compareStrings(aData->asLatin1(), bData->asStringView());
+                return QtPrivate::compareStrings(aData.asLatin1(), bData.asStringView());
 
-            return QCborContainerPrivate::compareUtf8(aData, bData->asLatin1());
+            return QCborContainerPrivate::compareUtf8(aData, bData.asLatin1());
         }
 
         if (aKey.flags & QtCbor::Element::StringIsUtf16) {
             if (bKey.flags & QtCbor::Element::StringIsAscii)
-                return QtPrivate::compareStrings(aData->asStringView(), bData->asLatin1());
+                return QtPrivate::compareStrings(aData.asStringView(), bData.asLatin1());
             if (bKey.flags & QtCbor::Element::StringIsUtf16)
-                return QtPrivate::compareStrings(aData->asStringView(), bData->asStringView());
+                return QtPrivate::compareStrings(aData.asStringView(), bData.asStringView());
 
             // Nasty case. a is UTF-16 and b is UTF-8
-            return QtPrivate::compareStrings(aData->asStringView(), bData->toUtf8String());
+            return QtPrivate::compareStrings(aData.asStringView(), bData.toUtf8String());
         }
 
         if (bKey.flags & QtCbor::Element::StringIsAscii)
-            return QCborContainerPrivate::compareUtf8(aData, bData->asLatin1());
+            return QCborContainerPrivate::compareUtf8(aData, bData.asLatin1());
 
         // Nasty case. a is UTF-8 and b is UTF-16
         if (bKey.flags & QtCbor::Element::StringIsUtf16)
-            return QtPrivate::compareStrings(aData->toUtf8String(), bData->asStringView());
+            return QtPrivate::compareStrings(aData.toUtf8String(), bData.asStringView());
 
-        return QCborContainerPrivate::compareUtf8(aData, bData->asLatin1());
+        return QCborContainerPrivate::compareUtf8(aData, bData.asLatin1());
     };
 
     std::sort(Forward(container->elements.begin()), Forward(container->elements.end()),
@@ -784,78 +972,6 @@ bool Parser::parseNumber()
 
         unescaped = %x20-21 / %x23-5B / %x5D-10FFFF
  */
-static inline bool addHexDigit(char digit, uint *result)
-{
-    *result <<= 4;
-    if (digit >= '0' && digit <= '9')
-        *result |= (digit - '0');
-    else if (digit >= 'a' && digit <= 'f')
-        *result |= (digit - 'a') + 10;
-    else if (digit >= 'A' && digit <= 'F')
-        *result |= (digit - 'A') + 10;
-    else
-        return false;
-    return true;
-}
-
-static inline bool scanEscapeSequence(const char *&json, const char *end, uint *ch)
-{
-    ++json;
-    if (json >= end)
-        return false;
-
-    DEBUG << "scan escape" << (char)*json;
-    uint escaped = *json++;
-    switch (escaped) {
-    case '"':
-        *ch = '"'; break;
-    case '\\':
-        *ch = '\\'; break;
-    case '/':
-        *ch = '/'; break;
-    case 'b':
-        *ch = 0x8; break;
-    case 'f':
-        *ch = 0xc; break;
-    case 'n':
-        *ch = 0xa; break;
-    case 'r':
-        *ch = 0xd; break;
-    case 't':
-        *ch = 0x9; break;
-    case 'u': {
-        *ch = 0;
-        if (json > end - 4)
-            return false;
-        for (int i = 0; i < 4; ++i) {
-            if (!addHexDigit(*json, ch))
-                return false;
-            ++json;
-        }
-        return true;
-    }
-    default:
-        // this is not as strict as one could be, but allows for more Json files
-        // to be parsed correctly.
-        *ch = escaped;
-        return true;
-    }
-    return true;
-}
-
-static inline bool scanUtf8Char(const char *&json, const char *end, uint *result)
-{
-    const auto *usrc = reinterpret_cast<const uchar *>(json);
-    const auto *uend = reinterpret_cast<const uchar *>(end);
-    const uchar b = *usrc++;
-    int res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, result, usrc, uend);
-    if (res < 0)
-        return false;
-
-    json = reinterpret_cast<const char *>(usrc);
-    return true;
-}
-
 bool Parser::parseString()
 {
     const char *start = json;
@@ -865,6 +981,17 @@ bool Parser::parseString()
     BEGIN << "parse string" << json;
     bool isUtf8 = true;
     bool isAscii = true;
+
+    // Skip over the part up to the first quote or backslash, which is plain
+    // ASCII or at least valid UTF-8; the loop below checks which of the two
+    // ended it, and finds the position of any encoding error.
+    const char *stop = head + index.nextQuoteOrEscape(json - head);
+    json = head + index.nextNonAscii(json - head, stop - head);
+    if (json < stop && QUtf8::isValidUtf8(json, stop - json).isValidUtf8) {
+        isAscii = false;
+        json = stop;
+    }
+
     while (json < end) {
         uint ch = 0;
         if (*json == '"')
@@ -894,6 +1021,16 @@ bool Parser::parseString()
 
     // no escape sequences, we are done
     if (isUtf8) {
+        if (!sourceData.isNull()) {
+            if (container->sourceData.isNull())
+                container->sourceData = sourceData;
+            if (container->appendExternalString(start - head, json - start - 1,
+                                                isAscii ? QtCbor::Element::StringIsAscii
+                                                        : QtCbor::Element::ValueFlags())) {
+                END;
+                return true;
+            }
+        }
         if (isAscii)
             container->appendAsciiString(start, json - start - 1);
         else
@@ -53,17 +53,127 @@
 
 #include <QtCore/private/qglobal_p.h>
 #include <QtCore/private/qcborvalue_p.h>
+#include <QtCore/private/qstringconverter_p.h>
 #include <QtCore/qjsondocument.h>
 
 QT_BEGIN_NAMESPACE
 
 namespace QJsonPrivate {
 
+inline bool addHexDigit(char digit, uint *result)
+{
+    *result <<= 4;
+    if (digit >= '0' && digit <= '9')
+        *result |= (digit - '0');
+    else if (digit >= 'a' && digit <= 'f')
+        *result |= (digit - 'a') + 10;
+    else if (digit >= 'A' && digit <= 'F')
+        *result |= (digit - 'A') + 10;
+    else
+        return false;
+    return true;
+}
+
+inline bool scanEscapeSequence(const char *&json, const char *end, uint *ch)
+{
+    ++json;
+    if (json >= end)
+        return false;
+
+    uint escaped = *json++;
+    switch (escaped) {
+    case '"':
+        *ch = '"'; break;
+    case '\\':
+        *ch = '\\'; break;
+    case '/':
+        *ch = '/'; break;
+    case 'b':
+        *ch = 0x8; break;
+    case 'f':
+        *ch = 0xc; break;
+    case 'n':
+        *ch = 0xa; break;
+    case 'r':
+        *ch = 0xd; break;
+    case 't':
+        *ch = 0x9; break;
+    case 'u': {
+        *ch = 0;
+        if (json > end - 4)
+            return false;
+        for (int i = 0; i < 4; ++i) {
+            if (!addHexDigit(*json, ch))
+                return false;
+            ++json;
+        }
+        return true;
+    }
+    default:
+        // this is not as strict as one could be, but allows for more Json files
+        // to be parsed correctly.
+        *ch = escaped;
+        return true;
+    }
+    return true;
+}
+
+inline bool scanUtf8Char(const char *&json, const char *end, uint *result)
+{
+    const auto *usrc = reinterpret_cast<const uchar *>(json);
+    const auto *uend = reinterpret_cast<const uchar *>(end);
+    const uchar b = *usrc++;
+    int res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, result, usrc, uend);
+    if (res < 0)
+        return false;
+
+    json = reinterpret_cast<const char *>(usrc);
+    return true;
+}
+
+class StructuralIndex
+{
+public:
+    StructuralIndex(const char *json, qsizetype length)
+        : json(reinterpret_cast<const uchar *>(json)), length(length)
+    {}
+
+    qsizetype nextNonSpace(qsizetype pos);
+    qsizetype nextQuoteOrEscape(qsizetype pos);
+    qsizetype nextNonAscii(qsizetype pos, qsizetype limit);
+
+    struct Block {
+        quint64 space;
+        quint64 quoteOrEscape;
+        quint64 nonAscii;
+    };
+
+private:
+    enum { BlockSize = 64, WindowBlocks = 256 };
+
+    template <quint64 Block::*Bits, bool Invert> qsizetype find(qsizetype pos, qsizetype limit);
+    void fill(qsizetype firstBlock);
+
+    const uchar *json;
+    qsizetype length;
+    qsizetype windowStart = 0;
+    qsizetype windowEnd = 0;
+    Block blocks[WindowBlocks];
+};
+
 class Parser
 {
 public:
     Parser(const char *json, int length);
 
+    // makes the strings refer to data, which holds the JSON text being
+    // parsed, instead of copying them
+    void setSourceData(const QByteArray &data)
+    {
+        Q_ASSERT(data.constData() == head);
+        sourceData = data;
+    }
+
     QCborValue parse(QJsonParseError *error);
 
 private:
@@ -84,6 +194,8 @@ private:
     int nestingLevel;
     QJsonParseError::ParseError lastError;
     QExplicitlySharedDataPointer<QCborContainerPrivate> container;
+    StructuralIndex index;
+    QByteArray sourceData;
 };
 
 }
@@ -0,0 +1,883 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qjsonstreamreader.h"
+
+#include <QtCore/qiodevice.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include "qjsonparser_p.h"
+#include <private/qnumeric_p.h>
+#include <private/qstringconverter_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.0
+
+    \brief The QJsonStreamReader class is a simple JSON stream decoder that
+    operates on either a QByteArray or QIODevice.
+
+    This class can be used to decode a stream of JSON content directly from
+    either a QByteArray or a QIODevice, without first building a
+    QJsonDocument. It reads the input in chunks as it goes and only keeps the
+    part of the input that it has not consumed yet in memory, so that it can
+    process documents of any size, as well as streams that contain more than
+    one document, like newline-delimited JSON.
+
+    QJsonStreamReader uses the same model as QCborStreamReader: the reader is
+    positioned on one item at a time, whose type() is queried and whose value
+    is obtained with one of the toBool(), toInteger(), toDouble(),
+    readString() or readValue() functions. Calling next() advances to the
+    next item at the same level. Arrays and objects are entered with
+    enterContainer() and left with leaveContainer(). Inside an object, the
+    items alternate between the member names, which are strings for which
+    isKey() returns \c true, and the values.
+
+    \snippet code/src_corelib_serialization_qjsonstream.cpp 0
+
+    At the top level, the reader accepts any number of JSON values separated
+    by whitespace. hasNext() returns \c false once all of them have been
+    read.
+
+    \section1 Incremental parsing
+
+    When the input ends before the current value is complete, the reader
+    reports a QJsonParseError::PrematureEndOfData error. If more data
+    becomes available later, reading can continue: the data is added with
+    addData() or becomes available on the device, and reparse() repositions
+    the reader on the incomplete item. A number at the top level is
+    considered complete when the input ends, since nothing else can
+    terminate it.
+
+    \sa QJsonStreamWriter, QJsonDocument, QCborStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::Type
+
+    This enumeration contains all possible JSON types as decoded by
+    QJsonStreamReader.
+
+    \value Null         The value \c null.
+    \value Bool         The values \c true and \c false.
+    \value Integer      A number that can be represented as a 64-bit integer.
+    \value Double       Any other number.
+    \value String       A string, which includes the names of object members.
+    \value Array        An array of values.
+    \value Object       An object, whose items alternate between member names and values.
+    \value Invalid      No item could be decoded, either because the reader
+                        is at the end of the data or of a container, or
+                        because an error occurred.
+*/
+
+static const int nestingLimit = 1024;
+static const qsizetype MinimumReadSize = 64 * 1024;
+
+static inline bool isJsonSpace(char c)
+{
+    return c == 0x20 || c == 0x09 || c == 0x0a || c == 0x0d;
+}
+
+static inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+class QJsonStreamReaderPrivate
+{
+public:
+    struct Container
+    {
+        QJsonStreamReader::Type type;
+        qsizetype count;
+    };
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qint64 bufferOffset = 0;        // offset of buffer[0] in the stream
+    qsizetype pos = 0;              // position right after the previous item
+    qsizetype itemStart = 0;
+    qsizetype itemEnd = 0;
+    QVarLengthArray<Container, 16> containers;
+
+    QJsonStreamReader::Type type = QJsonStreamReader::Invalid;
+    bool atContainerEnd = false;
+    bool hasEscapes = false;
+    bool boolean = false;
+    qint64 integer = 0;
+    double real = 0;
+
+    QJsonParseError::ParseError error = QJsonParseError::NoError;
+    qint64 errorOffset = -1;
+
+    void reset()
+    {
+        buffer.clear();
+        bufferOffset = 0;
+        pos = itemStart = itemEnd = 0;
+        containers.clear();
+    }
+
+    bool fill();
+    bool ensure(qsizetype n)
+    {
+        while (n >= buffer.size()) {
+            if (!fill())
+                return false;
+        }
+        return true;
+    }
+    bool skipSpace(qsizetype *p);
+    qsizetype stringEnd(qsizetype p);
+
+    void setError(QJsonParseError::ParseError e, qsizetype at)
+    {
+        error = e;
+        errorOffset = bufferOffset + at;
+        type = QJsonStreamReader::Invalid;
+    }
+
+    // unlike setError(), leaves the reader on the current item
+    bool setPrematureEnd()
+    {
+        error = QJsonParseError::PrematureEndOfData;
+        errorOffset = bufferOffset + buffer.size();
+        return false;
+    }
+
+    void preparse();
+    void scanLiteral(qsizetype p, const char *literal, qsizetype len);
+    void scanNumber(qsizetype p);
+    bool findContainerEnd(qsizetype *end);
+    void advance(qsizetype to);
+    QString decodeString();
+};
+
+bool QJsonStreamReaderPrivate::fill()
+{
+    if (!device)
+        return false;
+
+    // read at least as much as we have buffered, so that a large item
+    // only needs a logarithmic number of attempts to parse it
+    const qsizetype oldSize = buffer.size();
+    const qsizetype toRead = qMax(MinimumReadSize, oldSize);
+    buffer.resize(oldSize + toRead);
+    const qint64 n = device->read(buffer.data() + oldSize, toRead);
+    buffer.resize(oldSize + qMax(n, qint64(0)));
+    return n > 0;
+}
+
+// advances *p to the next non-whitespace character; returns false if the
+// data ended first
+bool QJsonStreamReaderPrivate::skipSpace(qsizetype *p)
+{
+    while (ensure(*p)) {
+        const char *data = buffer.constData();
+        const qsizetype size = buffer.size();
+        while (*p < size && isJsonSpace(data[*p]))
+            ++*p;
+        if (*p < size)
+            return true;
+    }
+    return false;
+}
+
+// returns the position after the closing quote of the string starting at p,
+// or -1 if the data ended first
+qsizetype QJsonStreamReaderPrivate::stringEnd(qsizetype p)
+{
+    Q_ASSERT(buffer.at(p) == '"');
+    hasEscapes = false;
+    qsizetype i = p + 1;
+    while (ensure(i)) {
+        const char *data = buffer.constData();
+        const qsizetype size = buffer.size();
+        while (i < size && data[i] != '"' && data[i] != '\\')
+            ++i;
+        if (i == size)
+            continue;
+        if (data[i] == '"')
+            return i + 1;
+        hasEscapes = true;
+        i += 2;
+    }
+    return -1;
+}
+
+void QJsonStreamReaderPrivate::preparse()
+{
+    type = QJsonStreamReader::Invalid;
+    atContainerEnd = false;
+    error = QJsonParseError::NoError;
+    errorOffset = -1;
+
+    qsizetype p = pos;
+    if (containers.isEmpty()) {
+        // end of the data, and not an error at the top level
+        if (!skipSpace(&p)) {
+            pos = p;
+            return;
+        }
+    } else {
+        const Container &c = containers.last();
+        const char close = c.type == QJsonStreamReader::Array ? ']' : '}';
+        const bool isObject = c.type == QJsonStreamReader::Object;
+
+        if (!skipSpace(&p))
+            return setError(QJsonParseError::PrematureEndOfData, p);
+        if (isObject && c.count % 2) {
+            if (buffer.at(p) != ':')
+                return setError(QJsonParseError::MissingNameSeparator, p);
+            ++p;
+            if (!skipSpace(&p))
+                return setError(QJsonParseError::PrematureEndOfData, p);
+        } else if (buffer.at(p) == close) {
+            atContainerEnd = true;
+            itemStart = p;
+            itemEnd = p + 1;
+            return;
+        } else if (c.count) {
+            if (buffer.at(p) != ',') {
+                return setError(isObject ? QJsonParseError::UnterminatedObject
+                                         : QJsonParseError::MissingValueSeparator, p);
+            }
+            ++p;
+            if (!skipSpace(&p))
+                return setError(QJsonParseError::PrematureEndOfData, p);
+            if (buffer.at(p) == close)
+                return setError(QJsonParseError::MissingObject, p);
+        }
+        if (isObject && c.count % 2 == 0 && buffer.at(p) != '"')
+            return setError(QJsonParseError::UnterminatedObject, p);
+    }
+
+    itemStart = p;
+    switch (buffer.at(p)) {
+    case '[':
+        itemEnd = p + 1;
+        type = QJsonStreamReader::Array;
+        return;
+    case '{':
+        itemEnd = p + 1;
+        type = QJsonStreamReader::Object;
+        return;
+    case '"':
+        itemEnd = stringEnd(p);
+        if (itemEnd < 0)
+            return setError(QJsonParseError::PrematureEndOfData, buffer.size());
+        type = QJsonStreamReader::String;
+        return;
+    case 't':
+        boolean = true;
+        return scanLiteral(p, "true", 4);
+    case 'f':
+        boolean = false;
+        return scanLiteral(p, "false", 5);
+    case 'n':
+        return scanLiteral(p, "null", 4);
+    case ',':
+        return setError(QJsonParseError::IllegalValue, p);
+    case ']':
+    case '}':
+        return setError(QJsonParseError::MissingObject, p);
+    default:
+        return scanNumber(p);
+    }
+}
+
+void QJsonStreamReaderPrivate::scanLiteral(qsizetype p, const char *literal, qsizetype len)
+{
+    if (!ensure(p + len - 1))
+        return setError(QJsonParseError::PrematureEndOfData, buffer.size());
+    if (memcmp(buffer.constData() + p, literal, len) != 0)
+        return setError(QJsonParseError::IllegalValue, p);
+    itemEnd = p + len;
+    type = *literal == 'n' ? QJsonStreamReader::Null : QJsonStreamReader::Bool;
+}
+
+/*
+    Same grammar and conversions as QJsonPrivate::Parser::parseNumber(), so
+    that numbers decode to the same values as in a QJsonDocument.
+*/
+void QJsonStreamReaderPrivate::scanNumber(qsizetype p)
+{
+    const auto at = [this](qsizetype n) { return ensure(n) ? buffer.at(n) : '\0'; };
+
+    qsizetype i = p;
+    bool isInt = true;
+    char c;
+
+    // minus
+    if (at(i) == '-')
+        ++i;
+
+    // int = zero / ( digit1-9 *DIGIT )
+    if (at(i) == '0') {
+        ++i;
+    } else {
+        while (isDigit(at(i)))
+            ++i;
+    }
+
+    // frac = decimal-point 1*DIGIT
+    if (at(i) == '.') {
+        ++i;
+        while (isDigit(c = at(i))) {
+            isInt = isInt && c == '0';
+            ++i;
+        }
+    }
+
+    // exp = e [ minus / plus ] 1*DIGIT
+    c = at(i);
+    if (c == 'e' || c == 'E') {
+        isInt = false;
+        ++i;
+        c = at(i);
+        if (c == '-' || c == '+')
+            ++i;
+        while (isDigit(at(i)))
+            ++i;
+    }
+
+    // nothing but the end of the data can terminate a number at the top level
+    if (!ensure(i) && (!containers.isEmpty() || i == p))
+        return setError(QJsonParseError::PrematureEndOfData, i);
+
+    const QByteArray number = QByteArray::fromRawData(buffer.constData() + p, i - p);
+    itemEnd = i;
+
+    if (isInt) {
+        bool ok;
+        integer = number.toLongLong(&ok);
+        if (ok) {
+            type = QJsonStreamReader::Integer;
+            return;
+        }
+    }
+
+    bool ok;
+    real = number.toDouble(&ok);
+    if (!ok)
+        return setError(QJsonParseError::IllegalNumber, p);
+
+    if (convertDoubleTo(real, &integer)) {
+        type = QJsonStreamReader::Integer;
+    } else {
+        type = QJsonStreamReader::Double;
+    }
+}
+
+// Finds the end of the array or object at itemStart, without decoding it.
+// On failure, a PrematureEndOfData error leaves the reader on the current
+// item, so that the caller can try again once more data is available.
+bool QJsonStreamReaderPrivate::findContainerEnd(qsizetype *end)
+{
+    Q_ASSERT(type == QJsonStreamReader::Array || type == QJsonStreamReader::Object);
+    error = QJsonParseError::NoError;
+    errorOffset = -1;
+
+    QVarLengthArray<char, 16> closers;
+    qsizetype i = itemStart;
+    while (ensure(i)) {
+        const char c = buffer.at(i);
+        switch (c) {
+        case '[':
+        case '{':
+            if (closers.size() == nestingLimit) {
+                setError(QJsonParseError::DeepNesting, i);
+                return false;
+            }
+            closers.append(c == '[' ? ']' : '}');
+            break;
+        case ']':
+        case '}':
+            if (closers.last() != c) {
+                setError(closers.last() == ']' ? QJsonParseError::UnterminatedArray
+                                                 : QJsonParseError::UnterminatedObject, i);
+                return false;
+            }
+            closers.removeLast();
+            if (closers.isEmpty()) {
+                *end = i + 1;
+                return true;
+            }
+            break;
+        case '"':
+            i = stringEnd(i);
+            if (i < 0)
+                return setPrematureEnd();
+            continue;
+        }
+        ++i;
+    }
+    return setPrematureEnd();
+}
+
+// moves to the item that follows the one that ends at the given position
+void QJsonStreamReaderPrivate::advance(qsizetype to)
+{
+    pos = to;
+    if (!containers.isEmpty())
+        ++containers.last().count;
+
+    // drop the data that has been consumed, but only when that is a large
+    // enough part of the buffer that moving the rest is worth it
+    if (pos >= MinimumReadSize && pos >= buffer.size() / 2) {
+        buffer.remove(0, pos);
+        bufferOffset += pos;
+        pos = 0;
+    }
+    preparse();
+}
+
+QString QJsonStreamReaderPrivate::decodeString()
+{
+    Q_ASSERT(type == QJsonStreamReader::String);
+    const char *data = buffer.constData();
+    const char *json = data + itemStart + 1;
+    const char *end = data + itemEnd - 1;
+
+    if (!hasEscapes) {
+        if (!QUtf8::isValidUtf8(json, end - json).isValidUtf8) {
+            setError(QJsonParseError::IllegalUTF8String, itemStart);
+            return QString();
+        }
+        return QString::fromUtf8(json, end - json);
+    }
+
+    QString result;
+    result.reserve(end - json);
+    while (json < end) {
+        uint ch = 0;
+        if (*json == '\\') {
+            const char *escape = json;
+            if (!QJsonPrivate::scanEscapeSequence(json, end, &ch)) {
+                setError(QJsonParseError::IllegalEscapeSequence, escape - data);
+                return QString();
+            }
+        } else if (!QJsonPrivate::scanUtf8Char(json, end, &ch)) {
+            setError(QJsonParseError::IllegalUTF8String, json - data);
+            return QString();
+        }
+        result.append(QChar::fromUcs4(ch));
+    }
+    return result;
+}
+
+/*!
+    Creates a QJsonStreamReader that has no data to read. Use addData() or
+    setDevice() to provide it with input.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Creates a QJsonStreamReader that reads the \a len bytes of JSON content
+    starting at \a data. The data is copied.
+*/
+QJsonStreamReader::QJsonStreamReader(const char *data, qsizetype len)
+    : QJsonStreamReader(QByteArray(data, len))
+{
+}
+
+/*!
+    Creates a QJsonStreamReader that reads the JSON content in \a data.
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : d(new QJsonStreamReaderPrivate)
+{
+    d->buffer = data;
+    d->preparse();
+}
+
+/*!
+    Creates a QJsonStreamReader that reads the JSON content from \a device.
+    The device must be open for reading and must remain valid for as long as
+    the reader uses it.
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : d(new QJsonStreamReaderPrivate)
+{
+    setDevice(device);
+}
+
+/*!
+    Destroys the QJsonStreamReader. The device, if any, is not closed.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Makes the reader read from \a device, discarding any data and state it
+    had, and positions it on the first item.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    d->reset();
+    d->device = device;
+    d->preparse();
+}
+
+/*!
+    Returns the device the reader reads from, or \nullptr if it reads from
+    data added with addData().
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Appends \a data to the input of a reader that does not read from a
+    device. If the reader was waiting for more data, it reparses the current
+    item.
+
+    \sa reparse()
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+/*!
+    \overload
+
+    Appends the \a len bytes starting at \a data to the input. The data is
+    copied.
+*/
+void QJsonStreamReader::addData(const char *data, qsizetype len)
+{
+    Q_ASSERT_X(!d->device, "QJsonStreamReader::addData",
+               "cannot add data to a reader that reads from a device");
+    d->buffer.append(data, len);
+    if (d->type == Invalid && !d->atContainerEnd
+            && (d->error == QJsonParseError::NoError
+                || d->error == QJsonParseError::PrematureEndOfData)) {
+        d->preparse();
+    }
+}
+
+/*!
+    Decodes the current item again. Call this function after more data has
+    become available on the device or has been added with addData(), when
+    the last operation failed with a QJsonParseError::PrematureEndOfData
+    error.
+*/
+void QJsonStreamReader::reparse()
+{
+    d->preparse();
+}
+
+/*!
+    Discards all data and state, and detaches the reader from its device.
+    The reader is left with nothing to read.
+
+    \sa setDevice(), addData()
+*/
+void QJsonStreamReader::clear()
+{
+    setDevice(nullptr);
+}
+
+/*!
+    Returns the error of the last operation, or a QJsonParseError whose
+    \c error is QJsonParseError::NoError if it succeeded. The \c offset
+    member is the offset of the error from the start of the stream.
+
+    \sa currentOffset()
+*/
+QJsonParseError QJsonStreamReader::lastError() const
+{
+    QJsonParseError error;
+    error.error = d->error;
+    error.offset = int(d->errorOffset);
+    return error;
+}
+
+/*!
+    Returns the offset from the start of the stream of the current item, or
+    of the position the reader would continue from if there is no current
+    item.
+*/
+qint64 QJsonStreamReader::currentOffset() const
+{
+    if (d->type != Invalid || d->atContainerEnd)
+        return d->bufferOffset + d->itemStart;
+    return d->bufferOffset + d->pos;
+}
+
+/*!
+    Returns the number of arrays and objects the reader has entered.
+
+    \sa enterContainer(), parentContainerType()
+*/
+int QJsonStreamReader::containerDepth() const
+{
+    return int(d->containers.size());
+}
+
+/*!
+    Returns Array or Object for the innermost container the reader is in, or
+    Invalid at the top level.
+
+    \sa containerDepth()
+*/
+QJsonStreamReader::Type QJsonStreamReader::parentContainerType() const
+{
+    return d->containers.isEmpty() ? Invalid : d->containers.last().type;
+}
+
+/*!
+    Returns \c true if the reader is positioned on an item, and \c false if
+    it is at the end of the current container, at the end of the data or an
+    error occurred.
+
+    \sa next(), leaveContainer()
+*/
+bool QJsonStreamReader::hasNext() const noexcept
+{
+    return d->type != Invalid;
+}
+
+/*!
+    Advances to the next item at the same level, skipping over the contents
+    of the current item if it is an array or an object. Returns \c true on
+    success.
+
+    If the input ends inside an array or object that is being skipped, the
+    reader stays on it and lastError() reports a
+    QJsonParseError::PrematureEndOfData error; calling next() again once
+    more data is available continues.
+
+    \sa hasNext(), enterContainer()
+*/
+bool QJsonStreamReader::next()
+{
+    if (d->type == Invalid)
+        return false;
+
+    qsizetype end = d->itemEnd;
+    if (isContainer() && !d->findContainerEnd(&end))
+        return false;
+    d->advance(end);
+    return d->error == QJsonParseError::NoError;
+}
+
+/*!
+    Returns the type of the current item.
+*/
+QJsonStreamReader::Type QJsonStreamReader::type() const noexcept
+{
+    return d->type;
+}
+
+/*!
+    Returns \c true if the current item is the name of an object member.
+*/
+bool QJsonStreamReader::isKey() const
+{
+    return isString() && parentContainerType() == Object
+            && d->containers.last().count % 2 == 0;
+}
+
+/*!
+    Enters the array or object the reader is positioned on and positions the
+    reader on its first item. Returns \c true on success.
+
+    \sa leaveContainer(), containerDepth()
+*/
+bool QJsonStreamReader::enterContainer()
+{
+    Q_ASSERT(isContainer());
+    if (d->containers.size() == nestingLimit) {
+        d->setError(QJsonParseError::DeepNesting, d->itemStart);
+        return false;
+    }
+    d->containers.append({ d->type, 0 });
+    d->pos = d->itemEnd;
+    d->preparse();
+    return d->error == QJsonParseError::NoError;
+}
+
+/*!
+    Leaves the current array or object, skipping the items that have not
+    been read yet, and positions the reader on the item that follows it.
+    Returns \c true on success.
+
+    \sa enterContainer(), hasNext()
+*/
+bool QJsonStreamReader::leaveContainer()
+{
+    Q_ASSERT(!d->containers.isEmpty());
+    while (hasNext()) {
+        if (!next())
+            return false;
+    }
+    if (!d->atContainerEnd)
+        return false;
+    d->containers.removeLast();
+    d->advance(d->itemEnd);
+    return d->error == QJsonParseError::NoError;
+}
+
+/*!
+    Decodes the current string item and advances to the next item. Returns
+    a null QString if the string is not valid, in which case lastError()
+    reports why.
+
+    \sa readValue(), next()
+*/
+QString QJsonStreamReader::readString()
+{
+    Q_ASSERT(isString());
+    QString result = d->decodeString();
+    if (d->error == QJsonParseError::NoError)
+        next();
+    return result;
+}
+
+/*!
+    Decodes the current item, including all of its contents if it is an
+    array or an object, and advances to the next item. Returns an undefined
+    QJsonValue if the item is not valid, in which case lastError() reports
+    why.
+
+    Reading a value of an array of records is a convenient way of
+    processing one record at a time:
+
+    \snippet code/src_corelib_serialization_qjsonstream.cpp 1
+
+    \sa readString(), next()
+*/
+QJsonValue QJsonStreamReader::readValue()
+{
+    QJsonValue result;
+    qsizetype end = d->itemEnd;
+    switch (type()) {
+    case Null:
+        break;
+    case Bool:
+        result = d->boolean;
+        break;
+    case Integer:
+        result = d->integer;
+        break;
+    case Double:
+        result = d->real;
+        break;
+    case String:
+        result = d->decodeString();
+        break;
+    case Array:
+    case Object: {
+        if (!d->findContainerEnd(&end))
+            return QJsonValue(QJsonValue::Undefined);
+        if (end - d->itemStart > std::numeric_limits<int>::max()) {
+            d->setError(QJsonParseError::DocumentTooLarge, d->itemStart);
+            return QJsonValue(QJsonValue::Undefined);
+        }
+        QJsonParseError error;
+        QJsonPrivate::Parser parser(d->buffer.constData() + d->itemStart, int(end - d->itemStart));
+        const QCborValue value = parser.parse(&error);
+        if (error.error != QJsonParseError::NoError) {
+            d->setError(error.error, d->itemStart + error.offset);
+            return QJsonValue(QJsonValue::Undefined);
+        }
+        result = value.toJsonValue();
+        break;
+    }
+    case Invalid:
+        return QJsonValue(QJsonValue::Undefined);
+    }
+
+    if (d->error != QJsonParseError::NoError)
+        return QJsonValue(QJsonValue::Undefined);
+    d->advance(end);
+    return result;
+}
+
+/*!
+    Returns the value of the current Bool item.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    Q_ASSERT(isBool());
+    return d->boolean;
+}
+
+/*!
+    Returns the value of the current Integer item.
+
+    \sa toDouble()
+*/
+qint64 QJsonStreamReader::toInteger() const
+{
+    Q_ASSERT(isInteger());
+    return d->integer;
+}
+
+/*!
+    Returns the value of the current number item. Integer items are
+    converted to double.
+
+    \sa toInteger()
+*/
+double QJsonStreamReader::toDouble() const
+{
+    Q_ASSERT(isNumber());
+    return isInteger() ? double(d->integer) : d->real;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
@@ -0,0 +1,434 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qjsonstreamwriter.h"
+
+#include <QtCore/qcborvalue.h>
+#include <QtCore/qiodevice.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include "qjsonwriter_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.0
+
+    \brief The QJsonStreamWriter class is a simple JSON encoder operating on a
+    one-way stream.
+
+    This class can be used to write JSON content directly to either a
+    QByteArray or a QIODevice, without first building a QJsonDocument. The
+    output is formatted by the same code as QJsonDocument::toJson(), so
+    writing the values of a document one by one produces the same output as
+    converting the document as a whole.
+
+    Values are written with the append() overloads. Arrays and objects are
+    started with startArray() and startObject() and ended with endArray()
+    and endObject(). Inside an object, the items appended alternate between
+    the member names, which must be strings, and the values.
+
+    \snippet code/src_corelib_serialization_qjsonstream.cpp 2
+
+    More than one value can be written at the top level. In the
+    QJsonDocument::Compact format, they are separated by newlines, which
+    produces newline-delimited JSON; in the QJsonDocument::Indented format,
+    each of them ends with a newline.
+
+    When writing to a device, the output is buffered and written to the
+    device each time a value at the top level is complete, when the buffer
+    is full, when flush() is called and when the writer is destroyed.
+
+    \sa QJsonStreamReader, QJsonDocument, QCborStreamWriter
+*/
+
+static const qsizetype BufferSize = 16 * 1024;
+
+class QJsonStreamWriterPrivate
+{
+public:
+    struct Container
+    {
+        bool isObject;
+        qsizetype count;
+    };
+
+    QIODevice *device = nullptr;
+    QByteArray *data = nullptr;
+    QByteArray buffer;
+    QVarLengthArray<Container, 16> containers;
+    qsizetype topLevelCount = 0;
+    bool compact = false;
+
+    QByteArray &output() { return data ? *data : buffer; }
+
+    bool isKeyNext() const
+    {
+        return !containers.isEmpty() && containers.last().isObject
+                && containers.last().count % 2 == 0;
+    }
+
+    void beginValue(bool isString);
+    void endValue();
+    void endContainer(char close);
+    void append(const QCborValue &value);
+    void flush();
+};
+
+// writes the separator and indentation that precede an item
+void QJsonStreamWriterPrivate::beginValue(bool isString)
+{
+    Q_ASSERT_X(isString || !isKeyNext(), "QJsonStreamWriter",
+               "the names of object members must be strings");
+    Q_UNUSED(isString);
+
+    QByteArray &json = output();
+    if (containers.isEmpty()) {
+        if (compact && topLevelCount)
+            json += '\n';
+        ++topLevelCount;
+        return;
+    }
+
+    Container &c = containers.last();
+    if (!c.isObject || c.count % 2 == 0) {
+        if (c.count)
+            json += compact ? "," : ",\n";
+        if (!compact)
+            json += QByteArray(4 * containers.size(), ' ');
+    }
+    ++c.count;
+}
+
+void QJsonStreamWriterPrivate::endValue()
+{
+    if (containers.isEmpty()) {
+        if (!compact)
+            output() += '\n';
+        flush();
+    } else if (buffer.size() >= BufferSize) {
+        flush();
+    }
+}
+
+void QJsonStreamWriterPrivate::endContainer(char close)
+{
+    const Container c = containers.last();
+    containers.removeLast();
+    QByteArray &json = output();
+    if (!compact) {
+        if (c.count)
+            json += '\n';
+        json += QByteArray(4 * containers.size(), ' ');
+    }
+    json += close;
+    endValue();
+}
+
+void QJsonStreamWriterPrivate::append(const QCborValue &value)
+{
+    beginValue(false);
+    const int indent = compact ? 0 : int(containers.size());
+    QJsonPrivate::Writer::valueToJson(value, output(), indent, compact);
+    endValue();
+}
+
+void QJsonStreamWriterPrivate::flush()
+{
+    if (device && !buffer.isEmpty()) {
+        device->write(buffer);
+        buffer.clear();
+    }
+}
+
+/*!
+    Creates a QJsonStreamWriter that writes to \a device. The device must
+    be open for writing and must remain valid for as long as the writer uses
+    it.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : d(new QJsonStreamWriterPrivate)
+{
+    d->device = device;
+}
+
+/*!
+    Creates a QJsonStreamWriter that appends its output to \a data, which
+    must remain valid for as long as the writer uses it.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data)
+    : d(new QJsonStreamWriterPrivate)
+{
+    d->data = data;
+}
+
+/*!
+    Writes the buffered output to the device, if any, and destroys the
+    QJsonStreamWriter. Containers that have not been ended are left
+    incomplete.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    d->flush();
+}
+
+/*!
+    Makes the writer write to \a device from now on, after writing the
+    buffered output to the previous device.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    d->flush();
+    d->device = device;
+    d->data = nullptr;
+}
+
+/*!
+    Returns the device the writer writes to, or \nullptr if it writes to a
+    QByteArray.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+    Sets the output format to \a format. The default is
+    QJsonDocument::Indented. The format should only be changed between
+    values at the top level.
+
+    \sa format()
+*/
+void QJsonStreamWriter::setFormat(QJsonDocument::JsonFormat format)
+{
+    d->compact = format == QJsonDocument::Compact;
+}
+
+/*!
+    Returns the output format.
+
+    \sa setFormat()
+*/
+QJsonDocument::JsonFormat QJsonStreamWriter::format() const
+{
+    return d->compact ? QJsonDocument::Compact : QJsonDocument::Indented;
+}
+
+/*!
+    Appends the boolean value \a b.
+*/
+void QJsonStreamWriter::append(bool b)
+{
+    d->append(QCborValue(b));
+}
+
+/*!
+    \fn void QJsonStreamWriter::append(int i)
+    \overload
+
+    Appends the number \a i.
+*/
+
+/*!
+    \overload
+
+    Appends the number \a i.
+*/
+void QJsonStreamWriter::append(qint64 i)
+{
+    d->append(QCborValue(i));
+}
+
+/*!
+    \overload
+
+    Appends the number \a d. Infinities and NaN cannot be represented in
+    JSON and are written as \c null, like QJsonDocument::toJson() does.
+*/
+void QJsonStreamWriter::append(double d)
+{
+    this->d->append(QCborValue(d));
+}
+
+/*!
+    \overload
+
+    Appends the string \a str. Inside an object, this is either the name of
+    a member or its value.
+*/
+void QJsonStreamWriter::append(QLatin1String str)
+{
+    append(QString(str));
+}
+
+/*!
+    \overload
+
+    Appends the string \a str. Inside an object, this is either the name of
+    a member or its value.
+*/
+void QJsonStreamWriter::append(QStringView str)
+{
+    const bool isKey = d->isKeyNext();
+    d->beginValue(true);
+    QByteArray &json = d->output();
+    json += '"';
+    json += QJsonPrivate::Writer::escapedString(str);
+    if (isKey) {
+        json += d->compact ? "\":" : "\": ";
+    } else {
+        json += '"';
+        d->endValue();
+    }
+}
+
+/*!
+    \fn void QJsonStreamWriter::append(const QString &str)
+    \overload
+
+    Appends the string \a str. Inside an object, this is either the name of
+    a member or its value.
+*/
+
+/*!
+    \overload
+
+    Appends the UTF-8 string of \a len bytes starting at \a utf8, or up to
+    the terminating null character if \a len is -1.
+*/
+void QJsonStreamWriter::append(const char *utf8, qsizetype len)
+{
+    append(QString::fromUtf8(utf8, len));
+}
+
+/*!
+    \overload
+
+    Appends \a value, including all of its contents if it is an array or an
+    object. An undefined value is written as \c null.
+*/
+void QJsonStreamWriter::append(const QJsonValue &value)
+{
+    if (value.isString())
+        append(value.toString());
+    else
+        d->append(QCborValue::fromJsonValue(value));
+}
+
+/*!
+    \fn void QJsonStreamWriter::append(std::nullptr_t)
+    \overload
+
+    Appends the value \c null.
+*/
+
+/*!
+    Appends the value \c null.
+*/
+void QJsonStreamWriter::appendNull()
+{
+    d->append(QCborValue(QCborValue::Null));
+}
+
+/*!
+    Starts an array. The values appended until the matching endArray() are
+    the elements of the array.
+*/
+void QJsonStreamWriter::startArray()
+{
+    d->beginValue(false);
+    d->output() += d->compact ? "[" : "[\n";
+    d->containers.append({ false, 0 });
+}
+
+/*!
+    Ends the array started by the matching startArray(). Returns \c false,
+    and writes nothing, if the innermost container is not an array.
+*/
+bool QJsonStreamWriter::endArray()
+{
+    if (d->containers.isEmpty() || d->containers.last().isObject)
+        return false;
+    d->endContainer(']');
+    return true;
+}
+
+/*!
+    Starts an object. The items appended until the matching endObject()
+    alternate between the names of the members and their values.
+*/
+void QJsonStreamWriter::startObject()
+{
+    d->beginValue(false);
+    d->output() += d->compact ? "{" : "{\n";
+    d->containers.append({ true, 0 });
+}
+
+/*!
+    Ends the object started by the matching startObject(). Returns \c false,
+    and writes nothing, if the innermost container is not an object or if
+    the value of its last member is missing.
+*/
+bool QJsonStreamWriter::endObject()
+{
+    if (d->containers.isEmpty() || !d->containers.last().isObject
+            || d->containers.last().count % 2)
+        return false;
+    d->endContainer('}');
+    return true;
+}
+
+/*!
+    Writes the buffered output to the device. This function does nothing if
+    the writer writes to a QByteArray.
+*/
+void QJsonStreamWriter::flush()
+{
+    d->flush();
+}
+
+QT_END_NAMESPACE
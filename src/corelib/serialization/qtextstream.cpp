@@ -320,6 +320,16 @@ QT_END_NAMESPACE
 
 QT_BEGIN_NAMESPACE
 
+// Empties \a buffer, but keeps its memory for the next chunk of text unless
+// it grew much larger than the usual chunk.
+static void clearBuffer(QString &buffer)
+{
+    if (buffer.capacity() > 4 * QTEXTSTREAM_BUFFERSIZE)
+        buffer.clear();
+    else
+        buffer.resize(0);
+}
+
 //-------------------------------------------------------------------
 
 /*!
@@ -451,8 +461,14 @@ bool QTextStreamPrivate::fillReadBuffer(qint64 maxBytes)
            qt_prettyDebug(buf, qMin(32,int(bytesRead)) , int(bytesRead)).constData(), int(sizeof(buf)), int(bytesRead));
 #endif
 
+    // decode straight into the free space of the read buffer
     int oldReadBufferSize = readBuffer.size();
-    readBuffer += toUtf16(buf, bytesRead);
+    readBuffer.resize(oldReadBufferSize + toUtf16.requiredSpace(bytesRead));
+    const QStringConverter::ConversionResult decoded =
+            toUtf16.decodeToBuffer(readBuffer.data() + oldReadBufferSize,
+                                   readBuffer.size() - oldReadBufferSize, buf, bytesRead);
+    Q_ASSERT(decoded.consumed == bytesRead);
+    readBuffer.resize(oldReadBufferSize + decoded.written);
 
     // remove all '\r\n' in the string.
     if (readBuffer.size() > oldReadBufferSize && textModeEnabled) {
@@ -528,16 +544,38 @@ void QTextStreamPrivate::flushWriteBuffer()
     }
 #endif
 
-    QByteArray data = fromUtf16(writeBuffer);
-    writeBuffer.clear();
+    // encode the text in chunks into a buffer that is reused between flushes
+    const qsizetype encodedSize = fromUtf16.requiredSpace(QTEXTSTREAM_BUFFERSIZE);
+    if (encodedWriteBuffer.size() < encodedSize)
+        encodedWriteBuffer.resize(encodedSize);
     hasWrittenData = true;
 
     // write raw data to the device
-    qint64 bytesWritten = device->write(data);
+    qint64 bytesWritten = 0;
+    bool writeFailed = false;
+    QStringView text = writeBuffer;
+    while (!text.isEmpty()) {
+        const QStringConverter::ConversionResult encoded =
+                fromUtf16.encodeToBuffer(encodedWriteBuffer.data(), encodedWriteBuffer.size(), text);
+        Q_ASSERT(encoded.consumed);
+        text = text.mid(encoded.consumed);
+        if (!encoded.written)
+            continue;
+
+        const qint64 written = device->write(encodedWriteBuffer.constData(), encoded.written);
 #if defined (QTEXTSTREAM_DEBUG)
-    qDebug("QTextStreamPrivate::flushWriteBuffer(), device->write(\"%s\") == %d",
-           qt_prettyDebug(data.constData(), qMin(data.size(),32), data.size()).constData(), int(bytesWritten));
+        qDebug("QTextStreamPrivate::flushWriteBuffer(), device->write(\"%s\") == %d",
+               qt_prettyDebug(encodedWriteBuffer.constData(), qMin(int(encoded.written), 32),
+                              int(encoded.written)).constData(), int(written));
 #endif
+        if (written > 0)
+            bytesWritten += written;
+        if (written != encoded.written) {
+            writeFailed = true;
+            break;
+        }
+    }
+    clearBuffer(writeBuffer);
 
 #if defined (Q_OS_WIN)
     // reset the text flag
@@ -545,7 +583,7 @@ void QTextStreamPrivate::flushWriteBuffer()
         device->setTextModeEnabled(true);
 #endif
 
-    if (bytesWritten <= 0) {
+    if (writeFailed && bytesWritten == 0) {
         status = QTextStream::WriteFailed;
         return;
     }
@@ -562,7 +600,7 @@ void QTextStreamPrivate::flushWriteBuffer()
     qDebug("QTextStreamPrivate::flushWriteBuffer() wrote %d bytes",
            int(bytesWritten));
 #endif
-    if (!flushed || bytesWritten != qint64(data.size()))
+    if (!flushed || writeFailed)
         status = QTextStream::WriteFailed;
 }
 
@@ -718,7 +756,7 @@ inline void QTextStreamPrivate::consume(int size)
         readBufferOffset += size;
         if (readBufferOffset >= readBuffer.size()) {
             readBufferOffset = 0;
-            readBuffer.clear();
+            clearBuffer(readBuffer);
             saveConverterState(device->pos());
         } else if (readBufferOffset > QTEXTSTREAM_BUFFERSIZE) {
             readBuffer = readBuffer.remove(0,readBufferOffset);
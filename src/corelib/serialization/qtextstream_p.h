@@ -121,6 +121,7 @@ public:
     QStringDecoder savedToUtf16;
 
     QString writeBuffer;
+    QByteArray encodedWriteBuffer; // reused by flushWriteBuffer()
     QString readBuffer;
     int readBufferOffset;
     int readConverterSavedStateOffset; //the offset between readBufferStartDevicePos and that start of the buffer
@@ -0,0 +1,220 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSMALLSTRING_H
+#define QSMALLSTRING_H
+
+#include <QtCore/qstring.h>
+#include <QtCore/qhashfunctions.h>
+
+#include <new>
+
+QT_BEGIN_NAMESPACE
+
+
+class QSmallString
+{
+public:
+    static constexpr qsizetype InlineCapacity = 11;
+
+    QSmallString() noexcept : m_inlineSize(0) {}
+    explicit QSmallString(QStringView str)
+    {
+        if (str.size() <= InlineCapacity)
+            assign(str);
+        else
+            adopt(str.toString());
+    }
+    QSmallString(const QChar *unicode, qsizetype size)
+        : QSmallString(QStringView(unicode, size)) {}
+    explicit QSmallString(QLatin1String str);
+    explicit QSmallString(const QString &str)
+    {
+        if (str.size() <= InlineCapacity)
+            assign(str);
+        else
+            adopt(str);
+    }
+    explicit QSmallString(QString &&str)
+    {
+        if (str.size() <= InlineCapacity)
+            assign(str);
+        else
+            adopt(std::move(str));
+    }
+
+    QSmallString(const QSmallString &other)
+        : m_inlineSize(other.m_inlineSize)
+    {
+        if (isInline())
+            memcpy(m_buffer, other.m_buffer, sizeof(m_buffer));
+        else
+            new (&m_string) QString(other.m_string);
+    }
+    QSmallString(QSmallString &&other) noexcept
+        : m_inlineSize(other.m_inlineSize)
+    {
+        if (isInline()) {
+            memcpy(m_buffer, other.m_buffer, sizeof(m_buffer));
+        } else {
+            new (&m_string) QString(std::move(other.m_string));
+            other.m_string.~QString();
+        }
+        other.m_inlineSize = 0;
+    }
+    QSmallString &operator=(const QSmallString &other)
+    {
+        QSmallString copy(other);
+        swap(copy);
+        return *this;
+    }
+    QSmallString &operator=(QSmallString &&other) noexcept
+    {
+        QSmallString moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+    ~QSmallString()
+    {
+        if (!isInline())
+            m_string.~QString();
+    }
+
+    void swap(QSmallString &other) noexcept
+    {
+        // QString is relocatable, so the representations can be swapped bytewise
+        alignas(QString) char tmp[sizeof(*this)];
+        memcpy(tmp, static_cast<void *>(this), sizeof(*this));
+        memcpy(static_cast<void *>(this), static_cast<const void *>(&other), sizeof(*this));
+        memcpy(static_cast<void *>(&other), tmp, sizeof(*this));
+    }
+
+    bool isInline() const noexcept { return m_inlineSize >= 0; }
+
+    qsizetype size() const noexcept { return isInline() ? qsizetype(m_inlineSize) : m_string.size(); }
+    qsizetype length() const noexcept { return size(); }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    const QChar *data() const noexcept
+    { return isInline() ? reinterpret_cast<const QChar *>(m_buffer) : m_string.constData(); }
+    const QChar *constData() const noexcept { return data(); }
+    const char16_t *utf16() const noexcept { return reinterpret_cast<const char16_t *>(data()); }
+
+    const QChar at(qsizetype i) const
+    { Q_ASSERT(size_t(i) < size_t(size())); return data()[i]; }
+    const QChar operator[](qsizetype i) const { return at(i); }
+
+    typedef const QChar *const_iterator;
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator cbegin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    QStringView view() const noexcept { return QStringView(data(), size()); }
+    QString toString() const
+    { return isInline() ? QString(data(), size()) : m_string; }
+
+    void clear() noexcept
+    {
+        if (!isInline())
+            m_string.~QString();
+        m_inlineSize = 0;
+    }
+
+private:
+    void assign(QStringView str) noexcept
+    {
+        Q_ASSERT(str.size() <= InlineCapacity);
+        m_inlineSize = qint8(str.size());
+        memcpy(m_buffer, str.utf16(), size_t(str.size()) * sizeof(char16_t));
+    }
+    template <typename String>
+    void adopt(String &&str)
+    {
+        new (&m_string) QString(std::forward<String>(str));
+        m_inlineSize = -1;
+    }
+
+    union {
+        QString m_string;
+        char16_t m_buffer[InlineCapacity];
+    };
+    // the number of code units in m_buffer, or -1 if the contents live in m_string
+    qint8 m_inlineSize;
+};
+
+Q_DECLARE_SHARED(QSmallString)
+
+inline QSmallString::QSmallString(QLatin1String str)
+{
+    if (str.size() <= InlineCapacity) {
+        m_inlineSize = qint8(str.size());
+        const uchar *src = reinterpret_cast<const uchar *>(str.data());
+        for (qsizetype i = 0; i < str.size(); ++i)
+            m_buffer[i] = src[i];
+    } else {
+        adopt(QString(str));
+    }
+}
+
+inline bool operator==(const QSmallString &lhs, const QSmallString &rhs) noexcept
+{ return lhs.view() == rhs.view(); }
+inline bool operator!=(const QSmallString &lhs, const QSmallString &rhs) noexcept
+{ return lhs.view() != rhs.view(); }
+inline bool operator< (const QSmallString &lhs, const QSmallString &rhs) noexcept
+{ return lhs.view() <  rhs.view(); }
+inline bool operator<=(const QSmallString &lhs, const QSmallString &rhs) noexcept
+{ return lhs.view() <= rhs.view(); }
+inline bool operator> (const QSmallString &lhs, const QSmallString &rhs) noexcept
+{ return lhs.view() >  rhs.view(); }
+inline bool operator>=(const QSmallString &lhs, const QSmallString &rhs) noexcept
+{ return lhs.view() >= rhs.view(); }
+
+inline bool operator==(const QSmallString &lhs, QLatin1String rhs) noexcept { return lhs.view() == rhs; }
+inline bool operator!=(const QSmallString &lhs, QLatin1String rhs) noexcept { return lhs.view() != rhs; }
+inline bool operator==(QLatin1String lhs, const QSmallString &rhs) noexcept { return lhs == rhs.view(); }
+inline bool operator!=(QLatin1String lhs, const QSmallString &rhs) noexcept { return lhs != rhs.view(); }
+
+inline size_t qHash(const QSmallString &key, size_t seed = 0) noexcept
+{ return qHash(key.view(), seed); }
+
+QT_END_NAMESPACE
+
+#endif // QSMALLSTRING_H
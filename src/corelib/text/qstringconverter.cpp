@@ -374,6 +374,445 @@ static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end,
 }
 #endif
 
+// SIMD helpers for the non-ASCII parts of the text
+//
+// The functions below take over where the ASCII ones above stop. They validate
+// and transcode whole blocks of one-, two- and three-byte UTF-8 sequences (that
+// is, BMP text other than surrogates) and return to the scalar code at the
+// first block that contains anything else: invalid input, four-byte sequences
+// or surrogate pairs. The scalar code then converts that block exactly as
+// before, so the handling of errors does not change.
+//
+// The validation is the lookup algorithm of John Keiser and Daniel Lemire,
+// "Validating UTF-8 In Less Than One Instruction Per Byte" (2020): the high and
+// the low nibble of a byte and the high nibble of the byte that follows it each
+// select the set of errors the pair could be part of, and only the errors that
+// are in all three sets are real. The continuation bytes that are not right
+// after the lead byte are checked separately.
+
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(AVX2) && !defined(QT_BOOTSTRAPPED)
+#  define QUTF8_SIMD_AVX2
+#endif
+
+#if defined(QUTF8_SIMD_AVX2)
+namespace {
+enum Utf8Error : uchar {
+    TooShort = 1 << 0,          // lead byte not followed by a continuation byte
+    TooLong = 1 << 1,           // continuation byte after an ASCII character
+    Overlong3 = 1 << 2,         // E0 80..9F
+    TooLarge = 1 << 3,          // F4 90..BF and F5..FF
+    Surrogate = 1 << 4,         // ED A0..BF
+    Overlong2 = 1 << 5,         // C0 and C1
+    TooLarge1000 = 1 << 6,      // F5..FF followed by 80..8F
+    Overlong4 = 1 << 6,         // F0 80..8F
+    TwoConts = 1 << 7,          // continuation byte after a continuation byte
+    Carry = TooShort | TooLong | TwoConts
+};
+
+// indexed by the high nibble of the first byte of the pair
+alignas(16) static constexpr uchar utf8Byte1High[16] = {
+    // 0_______ ASCII
+    TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+    // 10______ continuation
+    TwoConts, TwoConts, TwoConts, TwoConts,
+    // 1100____ and 1101____ two-byte lead
+    TooShort | Overlong2, TooShort,
+    // 1110____ three-byte lead
+    TooShort | Overlong3 | Surrogate,
+    // 1111____ four-byte lead
+    TooShort | TooLarge | TooLarge1000 | Overlong4
+};
+
+// indexed by the low nibble of the first byte of the pair
+alignas(16) static constexpr uchar utf8Byte1Low[16] = {
+    Carry | Overlong3 | Overlong2 | Overlong4,
+    Carry | Overlong2,
+    Carry,
+    Carry,
+    Carry | TooLarge,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000 | Surrogate,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000
+};
+
+// indexed by the high nibble of the second byte of the pair
+alignas(16) static constexpr uchar utf8Byte2High[16] = {
+    // 0_______ ASCII
+    TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+    // 1000____
+    TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge1000 | Overlong4,
+    // 1001____
+    TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge,
+    // 101_____
+    TooLong | Overlong2 | TwoConts | Surrogate | TooLarge,
+    TooLong | Overlong2 | TwoConts | Surrogate | TooLarge,
+    // 11______ lead
+    TooShort, TooShort, TooShort, TooShort
+};
+
+struct Utf8SimdTables
+{
+    // byte shuffles moving the 16-bit lanes selected by the index to the front
+    uchar compactUtf16[256][16];
+    // byte shuffles packing the UTF-8 sequences of four characters held in
+    // 32-bit lanes, for the index (lane >= 0x80) | (lane >= 0x800) << 4
+    uchar packUtf8[256][16];
+};
+
+static constexpr Utf8SimdTables makeUtf8SimdTables()
+{
+    Utf8SimdTables tables = {};
+    for (int index = 0; index < 256; ++index) {
+        int n = 0;
+        for (int lane = 0; lane < 8; ++lane) {
+            if (index & (1 << lane)) {
+                tables.compactUtf16[index][n++] = uchar(2 * lane);
+                tables.compactUtf16[index][n++] = uchar(2 * lane + 1);
+            }
+        }
+        while (n < 16)
+            tables.compactUtf16[index][n++] = 0x80;
+
+        n = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            const int length = 1 + ((index >> lane) & 1) + ((index >> (lane + 4)) & 1);
+            for (int i = 0; i < length; ++i)
+                tables.packUtf8[index][n++] = uchar(4 * lane + i);
+        }
+        while (n < 16)
+            tables.packUtf8[index][n++] = 0x80;
+    }
+    return tables;
+}
+
+alignas(16) static constexpr Utf8SimdTables utf8SimdTables = makeUtf8SimdTables();
+} // unnamed namespace
+#endif
+
+#if defined(QUTF8_SIMD_AVX2)
+// returns a non-zero byte for each byte of input that is part of an invalid
+// sequence, given the 32 bytes that precede it in previous
+static QT_FUNCTION_TARGET(AVX2)
+__m256i utf8ErrorsAvx2(__m256i input, __m256i previous) noexcept
+{
+    const __m256i byte1High = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8Byte1High)));
+    const __m256i byte1Low = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8Byte1Low)));
+    const __m256i byte2High = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(utf8Byte2High)));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i carried = _mm256_permute2x128_si256(previous, input, 0x21);
+    const __m256i prev1 = _mm256_alignr_epi8(input, carried, 15);
+    const __m256i prev2 = _mm256_alignr_epi8(input, carried, 14);
+    const __m256i prev3 = _mm256_alignr_epi8(input, carried, 13);
+
+    __m256i errors = _mm256_shuffle_epi8(byte1High,
+                                         _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    errors = _mm256_and_si256(errors, _mm256_shuffle_epi8(byte1Low,
+                                                          _mm256_and_si256(prev1, nibble)));
+    errors = _mm256_and_si256(errors, _mm256_shuffle_epi8(byte2High,
+                                                          _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+    // the bytes two after a three- or four-byte lead and three after a
+    // four-byte lead must be continuation bytes, which the tables above
+    // classify as TwoConts
+    const __m256i mustContinue = _mm256_and_si256(
+                _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xe0 - 0x80))),
+                                _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xf0 - 0x80)))),
+                _mm256_set1_epi8(char(0x80)));
+    return _mm256_xor_si256(mustContinue, errors);
+}
+
+static QT_FUNCTION_TARGET(AVX2)
+QUtf8::ValidUtf8Result isValidUtf8Avx2(const uchar *src, const uchar *end) noexcept
+{
+    // the last three bytes of a block may not start sequences longer than
+    // what's left of it
+    const __m256i maxLast = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1,
+                                             -1, -1, -1, -1, -1, -1, -1, -1,
+                                             -1, -1, -1, -1, -1, -1, -1, -1,
+                                             -1, -1, -1, -1, -1, char(0xf0 - 1),
+                                             char(0xe0 - 1), char(0xc0 - 1));
+    __m256i previous = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    __m256i errors = _mm256_setzero_si256();
+    bool isValidAscii = true;
+
+    // the final block is padded with zeroes, which also catches a sequence
+    // that is incomplete at the end of the input
+    alignas(32) uchar tail[32] = {};
+    for (;;) {
+        const bool last = end - src < 32;
+        if (last)
+            memcpy(tail, src, end - src);
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(last ? tail : src));
+        if (!_mm256_movemask_epi8(input)) {
+            errors = _mm256_or_si256(errors, incomplete);
+        } else {
+            isValidAscii = false;
+            errors = _mm256_or_si256(errors, utf8ErrorsAvx2(input, previous));
+            incomplete = _mm256_subs_epu8(input, maxLast);
+        }
+        if (last)
+            break;
+        previous = input;
+        src += 32;
+    }
+
+    if (!_mm256_testz_si256(errors, errors))
+        return { false, false };
+    return { true, isValidAscii };
+}
+
+// decodes the characters starting in the 16 bytes at src that are selected by
+// the bits of leads, reading up to two bytes past them
+static QT_FUNCTION_TARGET(AVX2)
+ushort *decodeUtf8BlockAvx2(ushort *dst, const uchar *src, uint leads) noexcept
+{
+    const __m256i b0 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+    const __m256i b1 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 1)));
+    const __m256i b2 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2)));
+    const __m256i low6 = _mm256_set1_epi16(0x3f);
+
+    // what each byte would decode to if it started a sequence of its length
+    const __m256i twoBytes = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(b0, _mm256_set1_epi16(0x1f)), 6),
+                                             _mm256_and_si256(b1, low6));
+    const __m256i threeBytes = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(b0, 12),
+                                                               _mm256_slli_epi16(_mm256_and_si256(b1, low6), 6)),
+                                               _mm256_and_si256(b2, low6));
+    __m256i utf16 = _mm256_blendv_epi8(b0, twoBytes, _mm256_cmpgt_epi16(b0, _mm256_set1_epi16(0xbf)));
+    utf16 = _mm256_blendv_epi8(utf16, threeBytes, _mm256_cmpgt_epi16(b0, _mm256_set1_epi16(0xdf)));
+
+    // keep only the characters, dropping the continuation bytes
+    const uint low = leads & 0xff;
+    const uint high = (leads >> 8) & 0xff;
+    const __m128i shuffleLow = _mm_load_si128(reinterpret_cast<const __m128i *>(utf8SimdTables.compactUtf16[low]));
+    const __m128i shuffleHigh = _mm_load_si128(reinterpret_cast<const __m128i *>(utf8SimdTables.compactUtf16[high]));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                     _mm_shuffle_epi8(_mm256_castsi256_si128(utf16), shuffleLow));
+    dst += qPopulationCount(low);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                     _mm_shuffle_epi8(_mm256_extracti128_si256(utf16, 1), shuffleHigh));
+    return dst + qPopulationCount(high);
+}
+
+static QT_FUNCTION_TARGET(AVX2)
+void simdDecodeUtf8Avx2(ushort *&dst, const uchar *&nextAscii, const uchar *&src, const uchar *end) noexcept
+{
+    // Leave sparse non-ASCII text, like the accented letters in most Latin
+    // script languages, to the scalar code, which copies the ASCII text in
+    // between with SIMD. The same goes for four-byte sequences, which the
+    // code below can't decode.
+    if (end - src >= 34) {
+        const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        const uint nonAscii = _mm_movemask_epi8(head);
+        const uint fourByteLeads = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(head, _mm_set1_epi8(char(0xf0))), head));
+        if (qPopulationCount(nonAscii) < 8 || (fourByteLeads & 0xff))
+            return;
+    }
+
+    // work on copies that the compiler can keep in registers
+    ushort *out = dst;
+    const uchar *in = src;
+    const uchar *scalarEnd = nullptr;
+
+    // do 32 bytes at a time, reading up to two bytes past them
+    while (end - in >= 34) {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in));
+        if (!_mm256_movemask_epi8(input)) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                                _mm256_cvtepu8_epi16(_mm256_castsi256_si128(input)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out) + 1,
+                                _mm256_cvtepu8_epi16(_mm256_extracti128_si256(input, 1)));
+            in += 32;
+            out += 32;
+            continue;
+        }
+
+        // decode up to the first four-byte sequence, if any, and let the
+        // scalar code decode that one; otherwise, don't decode the sequence
+        // that continues past the block
+        const __m256i fourBytes = _mm256_cmpeq_epi8(_mm256_max_epu8(input, _mm256_set1_epi8(char(0xf0))), input);
+        const uint fourByteLeads = _mm256_movemask_epi8(fourBytes);
+        int n = 32;
+        if (fourByteLeads) {
+            n = qCountTrailingZeroBits(fourByteLeads);
+            if (n < 8) {
+                // not worth checking the block for so few bytes
+                scalarEnd = in + n + 1;
+                break;
+            }
+        }
+
+        // leave blocks with errors to the scalar code
+        const __m256i errors = utf8ErrorsAvx2(input, _mm256_setzero_si256());
+        if (!_mm256_testz_si256(errors, errors))
+            break;
+
+        if (!fourByteLeads) {
+            if (in[31] >= 0xc0)
+                n = 31;
+            else if (in[30] >= 0xe0)
+                n = 30;
+        }
+
+        if (n) {
+            const __m256i continuation = _mm256_cmpgt_epi8(_mm256_set1_epi8(char(0xc0)), input);
+            const uint leads = ~uint(_mm256_movemask_epi8(continuation)) & uint((Q_UINT64_C(1) << n) - 1);
+            out = decodeUtf8BlockAvx2(out, in, leads);
+            out = decodeUtf8BlockAvx2(out, in + 16, leads >> 16);
+            in += n;
+        }
+        if (fourByteLeads) {
+            // at least the four-byte sequence is for the scalar code
+            scalarEnd = in + 1;
+            break;
+        }
+    }
+
+    dst = out;
+    src = in;
+    if (scalarEnd)
+        nextAscii = qMax(nextAscii, scalarEnd);
+    else // have the scalar code go past the block we stopped at
+        nextAscii = end - in < 34 ? end : in + 32;
+}
+
+static QT_FUNCTION_TARGET(AVX2)
+void simdEncodeUtf8Avx2(uchar *&dst, const ushort *&nextAscii, const ushort *&src, const ushort *end) noexcept
+{
+    // leave sparse non-ASCII text to the scalar code, as in simdDecodeUtf8Avx2()
+    if (end - src >= 16) {
+        const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(head, _mm_set1_epi16(short(0xff80))),
+                                              _mm_setzero_si128());
+        if (qPopulationCount(uint(_mm_movemask_epi8(ascii))) > 8)
+            return;
+    }
+
+    // work on copies that the compiler can keep in registers
+    uchar *out = dst;
+    const ushort *in = src;
+    const ushort *scalarEnd = nullptr;
+
+    // do eight characters at a time, but stop before the last sixteen so the
+    // stores stay within the buffer
+    while (end - in >= 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+
+        // encode up to the first surrogate, if any, and let the scalar code
+        // encode the surrogate pair
+        const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(input, _mm_set1_epi16(short(0xf800))),
+                                                   _mm_set1_epi16(short(0xd800)));
+        const uint surrogateBytes = _mm_movemask_epi8(surrogates);
+        const uint count = surrogateBytes ? qCountTrailingZeroBits(surrogateBytes) / 2 : 8;
+        if (count < 4) {
+            // not worth encoding so few characters here
+            scalarEnd = in + count + 1;
+            break;
+        }
+        const uint lanes = (1U << count) - 1;
+
+        const __m256i utf16 = _mm256_cvtepu16_epi32(input);
+        const __m256i twoBytes = _mm256_cmpgt_epi32(utf16, _mm256_set1_epi32(0x7f));
+        const __m256i threeBytes = _mm256_cmpgt_epi32(utf16, _mm256_set1_epi32(0x7ff));
+        const uint two = _mm256_movemask_ps(_mm256_castsi256_ps(twoBytes)) & lanes;
+        const uint three = _mm256_movemask_ps(_mm256_castsi256_ps(threeBytes)) & lanes;
+        if (!two) {
+            // back to ASCII text: leave it to simdEncodeAscii()
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(input, input));
+            in += count;
+            out += count;
+            scalarEnd = in;
+            break;
+        } else {
+            // the bytes of each character's sequence, first byte lowest
+            const __m256i cont = _mm256_set1_epi32(0x80);
+            const __m256i low6 = _mm256_or_si256(_mm256_and_si256(utf16, _mm256_set1_epi32(0x3f)), cont);
+            const __m256i mid6 = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(utf16, 6),
+                                                                  _mm256_set1_epi32(0x3f)), cont);
+            const __m256i seq2 = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(utf16, 6),
+                                                                 _mm256_set1_epi32(0xc0)),
+                                                 _mm256_slli_epi32(low6, 8));
+            const __m256i seq3 = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(utf16, 12),
+                                                                 _mm256_set1_epi32(0xe0)),
+                                                 _mm256_or_si256(_mm256_slli_epi32(mid6, 8),
+                                                                 _mm256_slli_epi32(low6, 16)));
+            __m256i utf8 = _mm256_blendv_epi8(utf16, seq2, twoBytes);
+            utf8 = _mm256_blendv_epi8(utf8, seq3, threeBytes);
+
+            const uint low = (two & 0xf) | (three & 0xf) << 4;
+            const uint high = (two >> 4) | (three & 0xf0);
+            const __m128i shuffleLow = _mm_load_si128(reinterpret_cast<const __m128i *>(utf8SimdTables.packUtf8[low]));
+            const __m128i shuffleHigh = _mm_load_si128(reinterpret_cast<const __m128i *>(utf8SimdTables.packUtf8[high]));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                             _mm_shuffle_epi8(_mm256_castsi256_si128(utf8), shuffleLow));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4 + qPopulationCount(low)),
+                             _mm_shuffle_epi8(_mm256_extracti128_si256(utf8, 1), shuffleHigh));
+        }
+        in += count;
+        out += count + qPopulationCount(two) + qPopulationCount(three);
+        if (count < 8) {
+            // the surrogate pair is for the scalar code
+            scalarEnd = in + 1;
+            break;
+        }
+    }
+
+    dst = out;
+    src = in;
+    if (scalarEnd)
+        nextAscii = qMax(nextAscii, scalarEnd);
+    else // have the scalar code go past the block we stopped at
+        nextAscii = end - in < 16 ? end : in + 8;
+}
+#endif
+
+// Decodes the UTF-8 text at src up to the first block that the scalar code must
+// handle and sets nextAscii to the end of that block. Unlike simdDecodeAscii(),
+// this may leave src before the end even when the input is valid.
+static inline void simdDecodeUtf8(ushort *&dst, const uchar *&nextAscii, const uchar *&src, const uchar *end)
+{
+    // leave short runs of non-ASCII text in ASCII text to the scalar code
+    if (nextAscii - src < 8)
+        return;
+
+#if defined(QUTF8_SIMD_AVX2)
+    if (qCpuHasFeature(AVX2))
+        simdDecodeUtf8Avx2(dst, nextAscii, src, end);
+#else
+    Q_UNUSED(dst);
+    Q_UNUSED(nextAscii);
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#endif
+}
+
+// Encodes the UTF-16 text at src up to the first block that the scalar code
+// must handle and sets nextAscii to the end of that block.
+static inline void simdEncodeUtf8(uchar *&dst, const ushort *&nextAscii, const ushort *&src, const ushort *end)
+{
+    // leave short runs of non-ASCII text in ASCII text to the scalar code
+    if (nextAscii - src < 8)
+        return;
+
+#if defined(QUTF8_SIMD_AVX2)
+    if (qCpuHasFeature(AVX2))
+        simdEncodeUtf8Avx2(dst, nextAscii, src, end);
+#else
+    Q_UNUSED(dst);
+    Q_UNUSED(nextAscii);
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#endif
+}
+
 enum { HeaderDone = 1 };
 
 QByteArray QUtf8::convertFromUnicode(const QChar *uc, qsizetype len)
@@ -388,6 +827,7 @@ QByteArray QUtf8::convertFromUnicode(const QChar *uc, qsizetype len)
         const ushort *nextAscii = end;
         if (simdEncodeAscii(dst, nextAscii, src, end))
             break;
+        simdEncodeUtf8(dst, nextAscii, src, end);
 
         do {
             ushort uc = *src++;
@@ -455,6 +895,7 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
         const ushort *nextAscii = end;
         if (simdEncodeAscii(cursor, nextAscii, src, end))
             break;
+        simdEncodeUtf8(cursor, nextAscii, src, end);
 
         do {
             ushort uc = *src++;
@@ -541,6 +982,7 @@ QChar *QUtf8::convertToUnicode(QChar *buffer, const char *chars, qsizetype len)
             nextAscii = end;
             if (simdDecodeAscii(dst, nextAscii, src, end))
                 break;
+            simdDecodeUtf8(dst, nextAscii, src, end);
 
             do {
                 uchar b = *src++;
@@ -641,8 +1083,11 @@ QChar *QUtf8::convertToUnicode(QChar *out, const char *chars, qsizetype len, QSt
     res = 0;
     const uchar *nextAscii = src;
     while (res >= 0 && src < end) {
-        if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
-            break;
+        if (src >= nextAscii) {
+            if (simdDecodeAscii(dst, nextAscii, src, end))
+                break;
+            simdDecodeUtf8(dst, nextAscii, src, end);
+        }
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -686,6 +1131,12 @@ QUtf8::ValidUtf8Result QUtf8::isValidUtf8(const char *chars, qsizetype len)
 {
     const uchar *src = reinterpret_cast<const uchar *>(chars);
     const uchar *end = src + len;
+
+#if defined(QUTF8_SIMD_AVX2)
+    if (len >= 32 && qCpuHasFeature(AVX2))
+        return isValidUtf8Avx2(src, end);
+#endif
+
     const uchar *nextAscii = src;
     bool isValidAscii = true;
 
@@ -1398,6 +1849,26 @@ static qsizetype toLatin1Len(qsizetype l) { return l + 1; }
 
 
 
+// Returns the length of the longest prefix of an input of inputLength units
+// that can be converted into outSize units of output. requiredSpace is
+// monotonic, but not necessarily linear.
+static qsizetype maxInputLength(qsizetype (*requiredSpace)(qsizetype), qsizetype outSize,
+                                qsizetype inputLength)
+{
+    if (requiredSpace(inputLength) <= outSize)
+        return inputLength;
+    qsizetype low = 0;
+    qsizetype high = inputLength - 1;
+    while (low < high) {
+        const qsizetype middle = high - (high - low) / 2;
+        if (requiredSpace(middle) <= outSize)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+    return low;
+}
+
 /*!
   \class QStringConverterBase
   \internal
@@ -1602,6 +2073,31 @@ QStringConverter::QStringConverter(const char *name, Flags f)
     limitations in the target encoding.
 */
 
+/*!
+    \class QStringConverter::ConversionResult
+    \inmodule QtCore
+    \since 6.0
+
+    \brief The ConversionResult struct describes the result of converting a
+    chunk of text into a caller-provided buffer.
+
+    \sa QStringDecoder::decodeToBuffer(), QStringEncoder::encodeToBuffer()
+*/
+
+/*!
+    \variable QStringConverter::ConversionResult::written
+
+    The number of units written to the output buffer: QChars when decoding,
+    bytes when encoding.
+*/
+
+/*!
+    \variable QStringConverter::ConversionResult::consumed
+
+    The number of units of the input that were converted: bytes when
+    decoding, QChars when encoding.
+*/
+
 /*!
     \fn const char *QStringConverter::name() const
 
@@ -1825,9 +2321,45 @@ const char *QStringConverter::nameForEncoding(QStringConverter::Encoding e)
     \l{requiredSpace} to determine the maximum size requirements to be able to encode
     a QChar buffer of \a length.
 
-    \sa requiredSpace
+    \sa requiredSpace, encodeToBuffer()
+*/
+
+/*!
+    \fn QStringConverter::ConversionResult QStringEncoder::encodeToBuffer(char *out, qsizetype outSize, const QChar *in, qsizetype length)
+    \since 6.0
+    \overload
+
+    Encodes as much of the \a length QChars from \a in as fits into the buffer
+    of \a outSize bytes starting at \a out.
 */
 
+/*!
+    \since 6.0
+
+    Encodes as much of \a in as fits into the buffer of \a outSize bytes
+    starting at \a out, and returns the number of bytes written and the number
+    of QChars of \a in that were consumed.
+
+    Unlike appendToBuffer(), this function never writes past the end of the
+    buffer, so that a single buffer can be reused to encode text of any size
+    in chunks: the text that was not consumed is to be passed to the next
+    call. A surrogate pair is not split between two calls unless the buffer
+    is too small for anything else. The buffer should be able to hold at
+    least requiredSpace(1) bytes; otherwise, nothing is consumed.
+
+    \sa requiredSpace(), appendToBuffer(), QStringDecoder::decodeToBuffer()
+*/
+QStringConverter::ConversionResult QStringEncoder::encodeToBuffer(char *out, qsizetype outSize, QStringView in)
+{
+    qsizetype length = maxInputLength(iface->fromUtf16Len, outSize, in.size());
+    if (length > 1 && length < in.size() && in.at(length - 1).isHighSurrogate())
+        --length;
+    if (!length)
+        return { 0, 0 };
+    const char *end = iface->fromUtf16(out, in.left(length), &state);
+    return { qsizetype(end - out), length };
+}
+
 /*!
     \class QStringDecoder
     \inmodule QtCore
@@ -1930,7 +2462,33 @@ const char *QStringConverter::nameForEncoding(QStringConverter::Encoding e)
     \l{requiredSpace} to determine the maximum size requirements to decode an encoded
     data buffer of \a length.
 
-    \sa requiredSpace
+    \sa requiredSpace, decodeToBuffer()
 */
 
+/*!
+    \since 6.0
+
+    Decodes as much of the \a length bytes from \a in as fits into the buffer
+    of \a outSize QChars starting at \a out, and returns the number of QChars
+    written and the number of bytes of \a in that were consumed.
+
+    Unlike appendToBuffer(), this function never writes past the end of the
+    buffer, so that a single buffer can be reused to decode data of any size
+    in chunks: the data that was not consumed is to be passed to the next
+    call. A multi-byte sequence may be split between two calls; unless the
+    decoder was created with the Stateless flag, it keeps the start of the
+    sequence and completes it in the next call. The buffer should be able to
+    hold at least requiredSpace(1) QChars; otherwise, nothing is consumed.
+
+    \sa requiredSpace(), appendToBuffer(), QStringEncoder::encodeToBuffer()
+*/
+QStringConverter::ConversionResult QStringDecoder::decodeToBuffer(QChar *out, qsizetype outSize, const char *in, qsizetype length)
+{
+    length = maxInputLength(iface->toUtf16Len, outSize, length);
+    if (!length)
+        return { 0, 0 };
+    const QChar *end = iface->toUtf16(out, in, length, &state);
+    return { qsizetype(end - out), length };
+}
+
 QT_END_NAMESPACE
@@ -174,6 +174,11 @@ public:
     }
     bool hasError() const { return state.invalidChars != 0; }
 
+    struct ConversionResult {
+        qsizetype written;
+        qsizetype consumed;
+    };
+
     const char *name() const
     { return isValid() ? iface->name : nullptr; }
 
@@ -239,6 +244,9 @@ public:
     { return iface->fromUtf16Len(inputLength); }
     char *appendToBuffer(char *out, const QChar *in, qsizetype length)
     { return iface->fromUtf16(out, QStringView(in, length), &state); }
+    Q_CORE_EXPORT ConversionResult encodeToBuffer(char *out, qsizetype outSize, QStringView in);
+    ConversionResult encodeToBuffer(char *out, qsizetype outSize, const QChar *in, qsizetype length)
+    { return encodeToBuffer(out, outSize, QStringView(in, length)); }
 private:
     QByteArray encodeAsByteArray(QStringView in)
     {
@@ -308,6 +316,7 @@ public:
     { return iface->toUtf16Len(inputLength); }
     QChar *appendToBuffer(QChar *out, const char *in, qsizetype length)
     { return iface->toUtf16(out, in, length, &state); }
+    Q_CORE_EXPORT ConversionResult decodeToBuffer(QChar *out, qsizetype outSize, const char *in, qsizetype length);
 private:
     QString decodeAsString(const char *in, qsizetype length)
     {
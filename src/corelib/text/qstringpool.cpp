@@ -0,0 +1,335 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qstringpool.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qreadwritelock.h>
+#include <QtCore/qvarlengtharray.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QStringAtom
+    \inmodule QtCore
+    \since 6.0
+    \brief The QStringAtom class identifies a string in a QStringPool.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    A QStringAtom is a handle to the canonical copy of a string that was
+    added to a QStringPool with QStringPool::atom(). Two atoms from the
+    same pool are equal if and only if their strings are equal, so
+    comparing atoms only compares two pointers. The hash value of the
+    string is computed once, when it is added to the pool, and hash()
+    and qHash() use it without looking at the string again.
+
+    Atoms are valid for as long as the pool they come from exists. Atoms
+    from different pools must not be compared.
+
+    A default-constructed QStringAtom is null; it does not refer to any
+    string and only compares equal to other null atoms.
+
+    \sa QStringPool
+*/
+
+/*!
+    \fn QStringAtom::QStringAtom()
+
+    Constructs a null atom.
+
+    \sa isNull()
+*/
+
+/*!
+    \fn bool QStringAtom::isNull() const
+
+    Returns \c true if this atom does not refer to a string; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool QStringAtom::isEmpty() const
+
+    Returns \c true if the string of this atom has no characters or if
+    the atom is null; otherwise returns \c false.
+*/
+
+/*!
+    \fn qsizetype QStringAtom::size() const
+
+    Returns the number of UTF-16 code units in the string of this atom.
+*/
+
+/*!
+    \fn QStringView QStringAtom::view() const
+
+    Returns a view on the string of this atom.
+*/
+
+/*!
+    \fn QString QStringAtom::toString() const
+
+    Returns the canonical copy of the string of this atom. The returned
+    string shares its data with the pool, so this never allocates memory.
+*/
+
+/*!
+    \fn size_t QStringAtom::hash() const
+
+    Returns the hash value of the string of this atom, that is, the same
+    value as qHash(view(), qGlobalQHashSeed()), with the global seed that
+    was in effect when the pool was created.
+*/
+
+/*!
+    \fn bool QStringAtom::operator==(QStringAtom lhs, QStringAtom rhs)
+
+    Returns \c true if \a lhs and \a rhs refer to the same string;
+    otherwise returns \c false.
+*/
+
+/*!
+    \fn bool QStringAtom::operator!=(QStringAtom lhs, QStringAtom rhs)
+
+    Returns \c true if \a lhs and \a rhs refer to different strings;
+    otherwise returns \c false.
+*/
+
+/*!
+    \fn size_t qHash(QStringAtom key, size_t seed = 0)
+    \relates QStringAtom
+
+    Returns the hash value for \a key, using \a seed to seed the
+    calculation. This does not look at the characters of the string, but
+    mixes \a seed into the hash value that was computed for it when it was
+    added to the pool.
+*/
+
+/*!
+    \class QStringPool
+    \inmodule QtCore
+    \since 6.0
+    \brief The QStringPool class keeps one shared copy of each string
+    added to it.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    \threadsafe
+
+    Applications often hold many copies of the same few strings, like the
+    keys of JSON objects, property names, MIME types or the names of HTTP
+    headers. Adding such strings to a QStringPool, also known as
+    interning them, makes all of them share a single copy of the data:
+
+    \snippet code/src_corelib_text_qstringpool.cpp 0
+
+    intern() returns the canonical copy of a string as a QString, which
+    can be stored and used like any other QString. atom() returns a
+    QStringAtom instead, which can be compared and hashed without looking
+    at the characters of the string, and so is well suited as a key of a
+    QHash.
+
+    Strings are never removed from a pool; they are freed when the pool
+    is destroyed. globalInstance() returns a pool that exists until the
+    application exits.
+
+    All functions of QStringPool can be called from multiple threads at
+    the same time. The pool is split into shards, each protected by its
+    own QReadWriteLock, so that looking up strings that are already in
+    the pool only takes a read lock.
+
+    \sa QStringAtom
+*/
+
+namespace {
+// A key of a shard: a view on the string owned by the QStringAtomData,
+// together with its hash, so that QHash does not hash the string again.
+struct Key
+{
+    QStringView view;
+    size_t hash;
+};
+
+bool operator==(const Key &lhs, const Key &rhs) noexcept
+{
+    return lhs.view == rhs.view;
+}
+
+size_t qHash(const Key &key, size_t seed) noexcept
+{
+    return QT_PREPEND_NAMESPACE(qHash)(key.hash, seed);
+}
+}
+
+enum { ShardCount = 16 };
+
+struct alignas(64) QStringPool::Shard
+{
+    mutable QReadWriteLock lock;
+    QHash<Key, QtPrivate::QStringAtomData *> index;
+
+    ~Shard() { qDeleteAll(index); }
+};
+
+/*!
+    Constructs an empty pool.
+*/
+QStringPool::QStringPool()
+    : shards(new Shard[ShardCount]),
+      // fixed for the lifetime of the pool, so that the hash values of its
+      // atoms stay valid when the global seed changes
+      seed(size_t(qGlobalQHashSeed()))
+{
+}
+
+/*!
+    Destroys the pool. All atoms of the pool become invalid; strings
+    returned by intern() remain valid.
+*/
+QStringPool::~QStringPool()
+{
+    delete[] shards;
+}
+
+QStringPool::Shard &QStringPool::shardFor(size_t hash) const noexcept
+{
+    // QHash uses the low bits of the hash to pick a bucket, so use the high
+    // bits to pick the shard
+    return shards[(hash >> (sizeof(size_t) * 8 - 4)) % ShardCount];
+}
+
+/*!
+    Returns the atom for the string \a str, adding a copy of \a str to
+    the pool if it does not contain an equal string yet.
+
+    \sa find(), intern()
+*/
+QStringAtom QStringPool::atom(QStringView str)
+{
+    const Key key{str, QT_PREPEND_NAMESPACE(qHash)(str, seed)};
+    Shard &shard = shardFor(key.hash);
+    {
+        QReadLocker locker(&shard.lock);
+        if (const QtPrivate::QStringAtomData *data = shard.index.value(key))
+            return QStringAtom(data);
+    }
+
+    QWriteLocker locker(&shard.lock);
+    // another thread may have added the string since we looked
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        // the key must refer to our copy of the string, not to the caller's
+        auto data = new QtPrivate::QStringAtomData{str.toString(), key.hash};
+        it = shard.index.insert(Key{data->string, key.hash}, data);
+    }
+    return QStringAtom(it.value());
+}
+
+/*!
+    \overload
+
+    Returns the atom for the Latin-1 string \a str, adding a copy of
+    \a str to the pool if it does not contain an equal string yet.
+*/
+QStringAtom QStringPool::atom(QLatin1String str)
+{
+    QVarLengthArray<char16_t, 256> buffer(str.size());
+    const uchar *src = reinterpret_cast<const uchar *>(str.data());
+    for (qsizetype i = 0; i < str.size(); ++i)
+        buffer[i] = src[i];
+    return atom(QStringView(buffer.constData(), buffer.size()));
+}
+
+/*!
+    Returns the atom for the string \a str if the pool contains it;
+    otherwise returns a null atom. Unlike atom(), this never adds
+    \a str to the pool.
+*/
+QStringAtom QStringPool::find(QStringView str) const
+{
+    const Key key{str, QT_PREPEND_NAMESPACE(qHash)(str, seed)};
+    const Shard &shard = shardFor(key.hash);
+    QReadLocker locker(&shard.lock);
+    return QStringAtom(shard.index.value(key));
+}
+
+/*!
+    \fn QString QStringPool::intern(QStringView str)
+
+    Returns the canonical copy of the string \a str, adding a copy of
+    \a str to the pool if it does not contain an equal string yet. Equal
+    strings returned by this function share their data.
+
+    \sa atom()
+*/
+
+/*!
+    \fn QString QStringPool::intern(QLatin1String str)
+    \overload
+*/
+
+/*!
+    Returns the number of strings in the pool.
+*/
+qsizetype QStringPool::size() const
+{
+    qsizetype count = 0;
+    for (int i = 0; i < ShardCount; ++i) {
+        QReadLocker locker(&shards[i].lock);
+        count += shards[i].index.size();
+    }
+    return count;
+}
+
+Q_GLOBAL_STATIC(QStringPool, globalPool)
+
+/*!
+    Returns a pool shared by the whole application. It exists until the
+    application exits.
+*/
+QStringPool *QStringPool::globalInstance()
+{
+    return globalPool();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,115 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSTRINGPOOL_H
+#define QSTRINGPOOL_H
+
+#include <QtCore/qstring.h>
+#include <QtCore/qhashfunctions.h>
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QtPrivate {
+struct QStringAtomData
+{
+    QString string;
+    size_t hash;
+};
+}
+
+class QStringAtom
+{
+public:
+    constexpr QStringAtom() noexcept = default;
+
+    bool isNull() const noexcept { return !d; }
+    bool isEmpty() const noexcept { return size() == 0; }
+    qsizetype size() const noexcept { return d ? d->string.size() : 0; }
+
+    QStringView view() const noexcept { return d ? QStringView(d->string) : QStringView(); }
+    QString toString() const { return d ? d->string : QString(); }
+    size_t hash() const noexcept { return d ? d->hash : 0; }
+
+    friend bool operator==(QStringAtom lhs, QStringAtom rhs) noexcept { return lhs.d == rhs.d; }
+    friend bool operator!=(QStringAtom lhs, QStringAtom rhs) noexcept { return lhs.d != rhs.d; }
+
+private:
+    friend class QStringPool;
+    explicit QStringAtom(const QtPrivate::QStringAtomData *data) noexcept : d(data) {}
+
+    const QtPrivate::QStringAtomData *d = nullptr;
+};
+
+Q_DECLARE_TYPEINFO(QStringAtom, Q_PRIMITIVE_TYPE);
+
+inline size_t qHash(QStringAtom key, size_t seed = 0) noexcept
+{ return qHash(key.hash(), seed); }
+
+class Q_CORE_EXPORT QStringPool
+{
+public:
+    QStringPool();
+    ~QStringPool();
+
+    QStringAtom atom(QStringView str);
+    QStringAtom atom(QLatin1String str);
+    QStringAtom find(QStringView str) const;
+
+    QString intern(QStringView str) { return atom(str).toString(); }
+    QString intern(QLatin1String str) { return atom(str).toString(); }
+
+    qsizetype size() const;
+
+    static QStringPool *globalInstance();
+
+private:
+    Q_DISABLE_COPY(QStringPool)
+
+    struct Shard;
+    Shard &shardFor(size_t hash) const noexcept;
+
+    Shard *shards;
+    size_t seed;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTRINGPOOL_H
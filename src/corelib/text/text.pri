@@ -15,6 +15,7 @@ HEADERS +=  \
         text/qlocale_tools_p.h \
         text/qlocale_data_p.h \
         text/qregexp.h \
+        text/qsmallstring.h \
         text/qstring.h \
         text/qstringalgorithms.h \
         text/qstringalgorithms_p.h \
@@ -25,6 +26,7 @@ HEADERS +=  \
         text/qstringlist.h \
         text/qstringliteral.h \
         text/qstringmatcher.h \
+        text/qstringpool.h \
         text/qstringview.h \
         text/qstringtokenizer.h \
         text/qtextboundaryfinder.h \
@@ -44,6 +46,7 @@ SOURCES += \
         text/qstringbuilder.cpp \
         text/qstringconverter.cpp \
         text/qstringlist.cpp \
+        text/qstringpool.cpp \
         text/qstringview.cpp \
         text/qstringtokenizer.cpp \
         text/qtextboundaryfinder.cpp \
@@ -0,0 +1,251 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qconcurrentqueue.h"
+#include "qfutex_p.h"
+#include "qmutex.h"
+#include "qwaitcondition.h"
+
+QT_BEGIN_NAMESPACE
+
+using namespace QtFutex;
+
+/*!
+    \class QSpscQueue
+    \inmodule QtCore
+    \since 6.0
+    \brief The QSpscQueue class is a bounded queue for passing values from
+    one thread to another.
+
+    \ingroup thread
+
+    QSpscQueue\<T\> is a fixed-size ring buffer that one producer thread
+    pushes values into and one consumer thread pops values from, without
+    locking. Only one thread at a time may call the functions that push
+    values, and only one thread at a time may call the functions that pop
+    values. Use QMpmcQueue if several threads need to push or pop.
+
+    The capacity of the queue is fixed when it is constructed. tryPush()
+    and tryPop() return immediately if the queue is full or empty, while
+    push() and pop() wait until there is space or a value, or until a
+    deadline expires:
+
+    \snippet code/src_corelib_thread_qconcurrentqueue.cpp 0
+
+    Waiting threads are parked in the operating system; on Linux, the
+    queue uses futexes for this, so that pushing or popping only makes a
+    system call if the other side is actually waiting.
+
+    T must be move-assignable and move- or copy-constructible.
+
+    \sa QMpmcQueue, QSemaphore
+*/
+
+/*!
+    \class QMpmcQueue
+    \inmodule QtCore
+    \since 6.0
+    \brief The QMpmcQueue class is a bounded queue that any number of
+    threads can push values into and pop values from.
+
+    \ingroup thread
+
+    \threadsafe
+
+    QMpmcQueue\<T\> is a fixed-size ring buffer that can be used by many
+    producer and consumer threads at the same time, without locking. Each
+    slot of the ring carries a sequence number that tells producers and
+    consumers whether they may use the slot, so a push or a pop only
+    contends with other pushes or pops for one atomic compare-and-swap.
+
+    The functions are the same as those of QSpscQueue; when there is only
+    one producer and one consumer, QSpscQueue is faster.
+
+    T must be move-constructible and move-assignable without throwing
+    exceptions. A value that is pushed by copy is copied before a slot of the
+    ring is claimed, so its copy constructor may throw.
+
+    \sa QSpscQueue
+*/
+
+/*!
+    \fn template <typename T> QSpscQueue<T>::QSpscQueue(qsizetype capacity)
+    \fn template <typename T> QMpmcQueue<T>::QMpmcQueue(qsizetype capacity)
+
+    Constructs an empty queue that can hold at least \a capacity values.
+    The capacity is rounded up to the next power of two.
+*/
+
+/*!
+    \fn template <typename T> QSpscQueue<T>::~QSpscQueue()
+    \fn template <typename T> QMpmcQueue<T>::~QMpmcQueue()
+
+    Destroys the queue and the values in it. No thread may use the queue
+    anymore at that point.
+*/
+
+/*!
+    \fn template <typename T> qsizetype QSpscQueue<T>::capacity() const
+    \fn template <typename T> qsizetype QMpmcQueue<T>::capacity() const
+
+    Returns the number of values that the queue can hold.
+*/
+
+/*!
+    \fn template <typename T> qsizetype QSpscQueue<T>::size() const
+    \fn template <typename T> qsizetype QMpmcQueue<T>::size() const
+
+    Returns the number of values in the queue. If other threads use the
+    queue at the same time, the value can be outdated by the time it is
+    returned.
+*/
+
+/*!
+    \fn template <typename T> bool QSpscQueue<T>::isEmpty() const
+    \fn template <typename T> bool QMpmcQueue<T>::isEmpty() const
+
+    Returns \c true if the queue holds no values; otherwise returns
+    \c false.
+
+    \sa size()
+*/
+
+/*!
+    \fn template <typename T> bool QSpscQueue<T>::tryPush(const T &value)
+    \fn template <typename T> bool QSpscQueue<T>::tryPush(T &&value)
+    \fn template <typename T> bool QMpmcQueue<T>::tryPush(const T &value)
+    \fn template <typename T> bool QMpmcQueue<T>::tryPush(T &&value)
+
+    Appends \a value to the queue and returns \c true, or returns \c false
+    if the queue is full. \a value is only moved from if the function
+    succeeds.
+
+    \sa push(), tryPop()
+*/
+
+/*!
+    \fn template <typename T> bool QSpscQueue<T>::tryPop(T *value)
+    \fn template <typename T> bool QMpmcQueue<T>::tryPop(T *value)
+
+    Removes the value at the head of the queue, assigns it to \a value and
+    returns \c true, or returns \c false if the queue is empty.
+
+    \sa pop(), tryPush()
+*/
+
+/*!
+    \fn template <typename T> bool QSpscQueue<T>::push(const T &value, QDeadlineTimer deadline)
+    \fn template <typename T> bool QSpscQueue<T>::push(T &&value, QDeadlineTimer deadline)
+    \fn template <typename T> bool QMpmcQueue<T>::push(const T &value, QDeadlineTimer deadline)
+    \fn template <typename T> bool QMpmcQueue<T>::push(T &&value, QDeadlineTimer deadline)
+
+    Appends \a value to the queue, waiting for space to become available
+    if the queue is full. Returns \c true if \a value was appended, or
+    \c false if the queue was still full when \a deadline expired. By
+    default, the function waits forever.
+
+    \sa tryPush(), pop()
+*/
+
+/*!
+    \fn template <typename T> bool QSpscQueue<T>::pop(T *value, QDeadlineTimer deadline)
+    \fn template <typename T> bool QMpmcQueue<T>::pop(T *value, QDeadlineTimer deadline)
+
+    Removes the value at the head of the queue and assigns it to \a value,
+    waiting for a value to become available if the queue is empty.
+    Returns \c true if a value was removed, or \c false if the queue was
+    still empty when \a deadline expired. By default, the function waits
+    forever.
+
+    \sa tryPop(), push()
+*/
+
+namespace QtPrivate {
+
+class QQueueWaiterPrivate
+{
+public:
+    QMutex mutex;
+    QWaitCondition condition;
+};
+
+QQueueWaiter::QQueueWaiter()
+    : d(futexAvailable() ? nullptr : new QQueueWaiterPrivate)
+{
+}
+
+QQueueWaiter::~QQueueWaiter()
+{
+    delete d;
+}
+
+// Waits until the sequence number differs from expectedSequence, which
+// prepareWait() returned. Returns false if the deadline expired.
+bool QQueueWaiter::wait(int expectedSequence, QDeadlineTimer deadline)
+{
+    if (futexAvailable()) {
+        if (deadline.isForever()) {
+            futexWait(sequence, expectedSequence);
+            return true;
+        }
+        const qint64 remaining = deadline.remainingTimeNSecs();
+        return remaining > 0 && futexWait(sequence, expectedSequence, remaining);
+    }
+
+    QMutexLocker locker(&d->mutex);
+    if (sequence.loadRelaxed() != expectedSequence)
+        return true;
+    return d->condition.wait(&d->mutex, deadline);
+}
+
+void QQueueWaiter::wakeAll() noexcept
+{
+    sequence.fetchAndAddRelease(1);
+    if (futexAvailable()) {
+        futexWakeAll(sequence);
+    } else {
+        QMutexLocker locker(&d->mutex);
+        d->condition.wakeAll();
+    }
+}
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
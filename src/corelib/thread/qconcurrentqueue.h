@@ -0,0 +1,314 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QCONCURRENTQUEUE_H
+#define QCONCURRENTQUEUE_H
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qdeadlinetimer.h>
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QtPrivate {
+
+// Parks threads that wait for a queue to change. A thread that found the
+// queue full (or empty) calls prepareWait(), retries, and only then waits for
+// the sequence number to move on. Whoever changes the queue calls notify(),
+// which only has to go out of line if somebody announced that it may wait.
+// The announcement is cleared by the thread that wakes the waiters, so a
+// burst of changes only wakes them once.
+class QQueueWaiterPrivate;
+
+class Q_CORE_EXPORT QQueueWaiter
+{
+public:
+    QQueueWaiter();
+    ~QQueueWaiter();
+
+    int prepareWait() noexcept
+    {
+        waiting.fetchAndStoreOrdered(1);
+        return sequence.loadAcquire();
+    }
+    bool wait(int expectedSequence, QDeadlineTimer deadline);
+
+    void notify() noexcept
+    {
+        // pairs with the ordered store in prepareWait(): either the waiter
+        // sees our change to the queue when it retries, or we see the flag
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (Q_UNLIKELY(waiting.loadRelaxed()) && waiting.fetchAndStoreRelaxed(0))
+            wakeAll();
+    }
+
+private:
+    Q_DISABLE_COPY(QQueueWaiter)
+    void wakeAll() noexcept;
+
+    QAtomicInt sequence;
+    QAtomicInt waiting;
+    QQueueWaiterPrivate *d;     // only used where futexes are not available
+};
+
+template <typename TryOp>
+bool waitUntil(QQueueWaiter &waiter, QDeadlineTimer deadline, TryOp tryOp)
+{
+    while (!tryOp()) {
+        const int sequence = waiter.prepareWait();
+        if (tryOp())
+            return true;
+        if (!waiter.wait(sequence, deadline))
+            return tryOp();
+    }
+    return true;
+}
+
+inline size_t queueCapacity(qsizetype capacity) noexcept
+{
+    size_t n = 2;
+    while (n < size_t(capacity))
+        n *= 2;
+    return n;
+}
+
+} // namespace QtPrivate
+
+template <typename T>
+class QSpscQueue
+{
+public:
+    explicit QSpscQueue(qsizetype capacity)
+        : mask(QtPrivate::queueCapacity(capacity) - 1),
+          buffer(static_cast<T *>(::operator new(sizeof(T) * (mask + 1), std::align_val_t(alignof(T)))))
+    {
+        Q_ASSERT(capacity > 0);
+    }
+    ~QSpscQueue()
+    {
+        for (size_t i = head.loadRelaxed(); i != tail.loadRelaxed(); ++i)
+            buffer[i & mask].~T();
+        ::operator delete(buffer, std::align_val_t(alignof(T)));
+    }
+
+    qsizetype capacity() const noexcept { return qsizetype(mask + 1); }
+    qsizetype size() const noexcept { return qsizetype(tail.loadAcquire() - head.loadAcquire()); }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    bool tryPush(const T &value) { return emplace(value); }
+    bool tryPush(T &&value) { return emplace(std::move(value)); }
+    bool tryPop(T *value)
+    {
+        const size_t h = head.loadRelaxed();
+        if (h == cachedTail) {
+            cachedTail = tail.loadAcquire();
+            if (h == cachedTail)
+                return false;
+        }
+        T *slot = buffer + (h & mask);
+        *value = std::move(*slot);
+        slot->~T();
+        head.storeRelease(h + 1);
+        notFull.notify();
+        return true;
+    }
+
+    bool push(const T &value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    { return QtPrivate::waitUntil(notFull, deadline, [&] { return emplace(value); }); }
+    bool push(T &&value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    { return QtPrivate::waitUntil(notFull, deadline, [&] { return emplace(std::move(value)); }); }
+    bool pop(T *value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    { return QtPrivate::waitUntil(notEmpty, deadline, [&] { return tryPop(value); }); }
+
+private:
+    Q_DISABLE_COPY(QSpscQueue)
+
+    template <typename U>
+    bool emplace(U &&value)
+    {
+        const size_t t = tail.loadRelaxed();
+        if (t - cachedHead > mask) {
+            cachedHead = head.loadAcquire();
+            if (t - cachedHead > mask)
+                return false;
+        }
+        new (buffer + (t & mask)) T(std::forward<U>(value));
+        tail.storeRelease(t + 1);
+        notEmpty.notify();
+        return true;
+    }
+
+    const size_t mask;
+    T *const buffer;
+
+    // the consumer's cache line
+    alignas(64) QAtomicInteger<size_t> head = 0;
+    size_t cachedTail = 0;
+    QtPrivate::QQueueWaiter notFull;
+
+    // the producer's cache line
+    alignas(64) QAtomicInteger<size_t> tail = 0;
+    size_t cachedHead = 0;
+    QtPrivate::QQueueWaiter notEmpty;
+};
+
+template <typename T>
+class QMpmcQueue
+{
+    // Every cell carries a sequence number that tells which lap around the
+    // ring the cell is in: a producer may fill the cell for position pos when
+    // it equals pos, a consumer may empty it when it equals pos + 1.
+    struct Cell {
+        QAtomicInteger<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T *value() noexcept { return reinterpret_cast<T *>(storage); }
+    };
+
+    // Once a cell is claimed, the value must be moved in or out, or the
+    // cell's sequence never advances and the queue gets stuck there.
+    static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+                  "QMpmcQueue requires a type that can be moved without throwing");
+
+public:
+    explicit QMpmcQueue(qsizetype capacity)
+        : mask(QtPrivate::queueCapacity(capacity) - 1),
+          cells(new Cell[mask + 1])
+    {
+        Q_ASSERT(capacity > 0);
+        for (size_t i = 0; i <= mask; ++i)
+            cells[i].sequence.storeRelaxed(i);
+    }
+    ~QMpmcQueue()
+    {
+        for (size_t i = dequeuePos.loadRelaxed(); i != enqueuePos.loadRelaxed(); ++i)
+            cells[i & mask].value()->~T();
+        delete[] cells;
+    }
+
+    qsizetype capacity() const noexcept { return qsizetype(mask + 1); }
+    qsizetype size() const noexcept
+    {
+        const qsizetype n = qsizetype(enqueuePos.loadAcquire() - dequeuePos.loadAcquire());
+        return qBound(qsizetype(0), n, capacity());
+    }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    bool tryPush(const T &value) { return emplace(value); }
+    bool tryPush(T &&value) { return emplace(std::move(value)); }
+    bool tryPop(T *value)
+    {
+        size_t pos = dequeuePos.loadRelaxed();
+        Cell *cell;
+        for (;;) {
+            cell = cells + (pos & mask);
+            const qptrdiff diff = qptrdiff(cell->sequence.loadAcquire()) - qptrdiff(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.testAndSetRelaxed(pos, pos + 1, pos))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.loadRelaxed();
+            }
+        }
+        *value = std::move(*cell->value());
+        cell->value()->~T();
+        cell->sequence.storeRelease(pos + mask + 1);
+        notFull.notify();
+        return true;
+    }
+
+    bool push(const T &value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    { return QtPrivate::waitUntil(notFull, deadline, [&] { return emplace(value); }); }
+    bool push(T &&value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    { return QtPrivate::waitUntil(notFull, deadline, [&] { return emplace(std::move(value)); }); }
+    bool pop(T *value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    { return QtPrivate::waitUntil(notEmpty, deadline, [&] { return tryPop(value); }); }
+
+private:
+    Q_DISABLE_COPY(QMpmcQueue)
+
+    template <typename U>
+    bool emplace(U &&value)
+    {
+        // a copy that may throw is made before a cell is claimed
+        if constexpr (!std::is_nothrow_constructible_v<T, U &&>)
+            return emplace(T(std::forward<U>(value)));
+
+        size_t pos = enqueuePos.loadRelaxed();
+        Cell *cell;
+        for (;;) {
+            cell = cells + (pos & mask);
+            const qptrdiff diff = qptrdiff(cell->sequence.loadAcquire()) - qptrdiff(pos);
+            if (diff == 0) {
+                if (enqueuePos.testAndSetRelaxed(pos, pos + 1, pos))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.loadRelaxed();
+            }
+        }
+        new (cell->value()) T(std::forward<U>(value));
+        cell->sequence.storeRelease(pos + 1);
+        notEmpty.notify();
+        return true;
+    }
+
+    const size_t mask;
+    Cell *const cells;
+
+    alignas(64) QAtomicInteger<size_t> enqueuePos = 0;
+    QtPrivate::QQueueWaiter notEmpty;
+
+    alignas(64) QAtomicInteger<size_t> dequeuePos = 0;
+    QtPrivate::QQueueWaiter notFull;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTQUEUE_H
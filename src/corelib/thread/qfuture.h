@@ -312,6 +312,9 @@ private:
     friend class QtPrivate::FailureHandler;
 #endif
 
+    template<class U>
+    friend class QtPrivate::FutureAwaiter;
+
     using QFuturePrivate =
             std::conditional_t<std::is_same_v<T, void>, QFutureInterfaceBase, QFutureInterface<T>>;
 
@@ -409,4 +412,6 @@ Q_DECLARE_SEQUENTIAL_ITERATOR(Future)
 
 QT_END_NAMESPACE
 
+#include <QtCore/qfuture_coroutine.h>
+
 #endif // QFUTURE_H
@@ -0,0 +1,283 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QFUTURE_H
+#error Do not include qfuture_coroutine.h directly
+#endif
+
+#if 0
+#pragma qt_sync_skip_header_check
+#pragma qt_sync_stop_processing
+#endif
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qfutureinterface.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+template<class T>
+class FutureCoroutinePromise;
+
+template<class Promise>
+struct IsFutureCoroutinePromise : std::false_type
+{
+};
+
+template<class T>
+struct IsFutureCoroutinePromise<FutureCoroutinePromise<T>> : std::true_type
+{
+};
+
+template<class T>
+class FutureCoroutinePromiseBase
+{
+public:
+    FutureCoroutinePromiseBase() { d.reportStarted(); }
+    ~FutureCoroutinePromiseBase()
+    {
+        // The coroutine is destroyed before returning when it gets canceled
+        if (!d.isFinished()) {
+            d.cancel();
+            d.reportFinished();
+        }
+    }
+
+    QFuture<T> get_return_object() { return d.future(); }
+
+    // The coroutine starts running immediately, and its frame is destroyed
+    // as soon as it returns.
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception()
+    {
+#ifndef QT_NO_EXCEPTIONS
+        d.reportException(std::current_exception());
+        d.reportFinished();
+#else
+        std::terminate();
+#endif
+    }
+
+    bool isCanceled() const { return d.isCanceled(); }
+
+protected:
+    QFutureInterface<T> d;
+};
+
+template<class T>
+class FutureCoroutinePromise : public FutureCoroutinePromiseBase<T>
+{
+public:
+    template<class U = T, typename = EnableIfSameOrConvertible<std::decay_t<U>, T>>
+    void return_value(U &&value)
+    {
+        this->d.reportResult(T(std::forward<U>(value)));
+        this->d.reportFinished();
+    }
+};
+
+template<>
+class FutureCoroutinePromise<void> : public FutureCoroutinePromiseBase<void>
+{
+public:
+    void return_void() { d.reportFinished(); }
+};
+
+template<class T>
+class FutureAwaiter
+{
+public:
+    explicit FutureAwaiter(const QFuture<T> &future, QThreadPool *pool = nullptr,
+                           QObject *context = nullptr)
+        : future(future), pool(pool), context(context), hasContext(context != nullptr)
+    {
+    }
+
+    bool await_ready() const
+    {
+        if (!future.isFinished())
+            return false;
+        if (hasContext)
+            return context && context->thread() == QThread::currentThread();
+        return !pool;
+    }
+
+    template<class Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        // Capturing no more than two pointers keeps std::function from
+        // allocating. The awaiter lives in the coroutine frame, which stays
+        // alive until the coroutine is resumed or destroyed.
+        future.d.setContinuation([this, handle] { schedule(handle); });
+    }
+
+    T await_resume()
+    {
+        if constexpr (std::is_void_v<T>) {
+            future.waitForFinished();
+        } else if constexpr (std::is_copy_constructible_v<T>) {
+            return future.result();
+        } else {
+            return future.takeResult();
+        }
+    }
+
+private:
+    // Destroys the coroutine if it was not resumed by the time its
+    // resumption event is discarded, for instance because the context
+    // object was deleted.
+    template<class Promise>
+    class Resumer
+    {
+    public:
+        Resumer(FutureAwaiter *awaiter, std::coroutine_handle<Promise> handle)
+            : awaiter(awaiter), handle(handle)
+        {
+        }
+        Resumer(Resumer &&other) noexcept
+            : awaiter(other.awaiter), handle(std::exchange(other.handle, nullptr))
+        {
+        }
+        ~Resumer()
+        {
+            if (handle)
+                handle.destroy();
+        }
+
+        void operator()() { awaiter->resume(std::exchange(handle, nullptr)); }
+
+    private:
+        FutureAwaiter *awaiter;
+        std::coroutine_handle<Promise> handle;
+    };
+
+    template<class Promise>
+    void schedule(std::coroutine_handle<Promise> handle)
+    {
+        if (pool) {
+            pool->start([this, handle] { resume(handle); });
+        } else if (hasContext) {
+            QObject *receiver = context.data();
+            if (!receiver) {
+                handle.destroy();
+                return;
+            }
+            QMetaObject::invokeMethod(receiver, Resumer<Promise>(this, handle),
+                                      Qt::QueuedConnection);
+        } else {
+            resume(handle);
+        }
+    }
+
+    template<class Promise>
+    void resume(std::coroutine_handle<Promise> handle)
+    {
+        // A coroutine returning a QFuture does not continue after its own
+        // future or the awaited one was canceled; it finishes as canceled.
+        if constexpr (IsFutureCoroutinePromise<Promise>::value) {
+            if (handle.promise().isCanceled() || (future.isCanceled() && !hasException())) {
+                handle.destroy();
+                return;
+            }
+        }
+        handle.resume();
+    }
+
+    bool hasException()
+    {
+#ifndef QT_NO_EXCEPTIONS
+        return future.d.exceptionStore().hasException();
+#else
+        return false;
+#endif
+    }
+
+    QFuture<T> future;
+    QThreadPool *pool;
+    QPointer<QObject> context;
+    bool hasContext;
+};
+
+} // namespace QtPrivate
+
+template<class T>
+QtPrivate::FutureAwaiter<T> operator co_await(const QFuture<T> &future)
+{
+    return QtPrivate::FutureAwaiter<T>(future);
+}
+
+namespace QtFuture {
+
+template<class T>
+QtPrivate::FutureAwaiter<T> resumeOn(QThreadPool *pool, const QFuture<T> &future)
+{
+    return QtPrivate::FutureAwaiter<T>(future, pool ? pool : QThreadPool::globalInstance());
+}
+
+template<class T>
+QtPrivate::FutureAwaiter<T> resumeOn(QObject *context, const QFuture<T> &future)
+{
+    Q_ASSERT(context);
+    return QtPrivate::FutureAwaiter<T>(future, nullptr, context);
+}
+
+} // namespace QtFuture
+
+QT_END_NAMESPACE
+
+template<class T, class... Args>
+struct std::coroutine_traits<QT_PREPEND_NAMESPACE(QFuture)<T>, Args...>
+{
+    using promise_type = QT_PREPEND_NAMESPACE(QtPrivate)::FutureCoroutinePromise<T>;
+};
+
+#endif // __cpp_impl_coroutine
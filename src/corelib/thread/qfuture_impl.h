@@ -197,7 +197,7 @@ template<class T>
 inline constexpr bool isTupleV = isTuple<T>::value;
 
 template<typename Function, typename ResultType, typename ParentResultType>
-class Continuation
+class Continuation : public PooledContinuationStorage
 {
 public:
     Continuation(Function &&func, const QFuture<ParentResultType> &f,
@@ -284,7 +284,7 @@ private:
 #ifndef QT_NO_EXCEPTIONS
 
 template<class Function, class ResultType>
-class FailureHandler
+class FailureHandler : public PooledContinuationStorage
 {
 public:
     static void create(Function &&function, QFuture<ResultType> *future,
@@ -604,7 +604,7 @@ void FailureHandler<Function, ResultType>::handleAllExceptions()
 #endif // QT_NO_EXCEPTIONS
 
 template<class Function, class ResultType>
-class CanceledHandler
+class CanceledHandler : public PooledContinuationStorage
 {
 public:
     static QFuture<ResultType> create(Function &&handler, QFuture<ResultType> *future,
@@ -612,34 +612,53 @@ public:
     {
         Q_ASSERT(future);
 
-        auto canceledContinuation = [parentFuture = *future, promise,
-                                     handler = std::move(handler)]() mutable {
-            promise.reportStarted();
+        auto canceledHandler = new CanceledHandler<Function, ResultType>(
+                std::forward<Function>(handler), *future, promise);
+
+        auto canceledContinuation = [canceledHandler]() mutable {
+            canceledHandler->run();
+            delete canceledHandler;
+        };
+        future->d.setContinuation(std::move(canceledContinuation));
+        return promise.future();
+    }
+
+    CanceledHandler(Function &&func, const QFuture<ResultType> &f,
+                    const QFutureInterface<ResultType> &p)
+        : promise(p), parentFuture(f), handler(std::forward<Function>(func))
+    {
+    }
 
-            if (parentFuture.isCanceled()) {
+    void run()
+    {
+        promise.reportStarted();
+
+        if (parentFuture.isCanceled()) {
 #ifndef QT_NO_EXCEPTIONS
-                if (parentFuture.d.exceptionStore().hasException()) {
-                    // Propagate the exception to the result future
-                    promise.reportException(parentFuture.d.exceptionStore().exception());
-                } else {
-                    try {
+            if (parentFuture.d.exceptionStore().hasException()) {
+                // Propagate the exception to the result future
+                promise.reportException(parentFuture.d.exceptionStore().exception());
+            } else {
+                try {
 #endif
-                        QtPrivate::fulfillPromise(promise, std::forward<Function>(handler));
+                    QtPrivate::fulfillPromise(promise, std::forward<Function>(handler));
 #ifndef QT_NO_EXCEPTIONS
-                    } catch (...) {
-                        promise.reportException(std::current_exception());
-                    }
+                } catch (...) {
+                    promise.reportException(std::current_exception());
                 }
-#endif
-            } else {
-                QtPrivate::fulfillPromise(promise, parentFuture);
             }
+#endif
+        } else {
+            QtPrivate::fulfillPromise(promise, parentFuture);
+        }
 
-            promise.reportFinished();
-        };
-        future->d.setContinuation(std::move(canceledContinuation));
-        return promise.future();
+        promise.reportFinished();
     }
+
+private:
+    QFutureInterface<ResultType> promise;
+    QFuture<ResultType> parentFuture;
+    std::decay_t<Function> handler;
 };
 
 } // namespace QtPrivate
@@ -56,6 +56,52 @@ enum {
 };
 
 namespace {
+// Freed continuation and future state blocks are kept in a cache per thread,
+// in size classes of 64, 128, 256 and 512 bytes.
+enum {
+    ContinuationSizeClasses = 4,
+    MaxCachedContinuationBlocks = 64
+};
+
+struct FreeContinuationBlock
+{
+    FreeContinuationBlock *next;
+};
+
+struct ContinuationCache
+{
+    ~ContinuationCache();
+
+    FreeContinuationBlock *blocks[ContinuationSizeClasses] = {};
+    int counts[ContinuationSizeClasses] = {};
+};
+
+// The cache is not used anymore once it has been destroyed at thread exit,
+// for instance by futures in thread-local or global objects.
+thread_local bool continuationCacheDestroyed = false;
+thread_local ContinuationCache continuationCache;
+
+ContinuationCache::~ContinuationCache()
+{
+    for (FreeContinuationBlock *block : blocks) {
+        while (block) {
+            FreeContinuationBlock *next = block->next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+    continuationCacheDestroyed = true;
+}
+
+static int continuationSizeClass(std::size_t size)
+{
+    for (int sizeClass = 0; sizeClass < ContinuationSizeClasses; ++sizeClass) {
+        if (size <= std::size_t(64) << sizeClass)
+            return sizeClass;
+    }
+    return -1;
+}
+
 class ThreadPoolThreadReleaser {
     QThreadPool *m_pool;
 public:
@@ -565,6 +611,38 @@ void QFutureInterfaceBase::reset()
     d->isValid = false;
 }
 
+void *QtPrivate::allocateContinuationStorage(std::size_t size)
+{
+    const int sizeClass = continuationSizeClass(size);
+    if (sizeClass < 0)
+        return ::operator new(size);
+    if (!continuationCacheDestroyed) {
+        ContinuationCache &cache = continuationCache;
+        if (FreeContinuationBlock *block = cache.blocks[sizeClass]) {
+            cache.blocks[sizeClass] = block->next;
+            --cache.counts[sizeClass];
+            return block;
+        }
+    }
+    return ::operator new(std::size_t(64) << sizeClass);
+}
+
+void QtPrivate::freeContinuationStorage(void *ptr, std::size_t size)
+{
+    const int sizeClass = continuationSizeClass(size);
+    if (sizeClass >= 0 && !continuationCacheDestroyed) {
+        ContinuationCache &cache = continuationCache;
+        if (cache.counts[sizeClass] < MaxCachedContinuationBlocks) {
+            auto block = static_cast<FreeContinuationBlock *>(ptr);
+            block->next = cache.blocks[sizeClass];
+            cache.blocks[sizeClass] = block;
+            ++cache.counts[sizeClass];
+            return;
+        }
+    }
+    ::operator delete(ptr);
+}
+
 QFutureInterfaceBasePrivate::QFutureInterfaceBasePrivate(QFutureInterfaceBase::State initialState)
     : refCount(1), m_progressValue(0), m_progressMinimum(0), m_progressMaximum(0),
       state(initialState),
@@ -726,8 +804,11 @@ void QFutureInterfaceBase::runContinuation() const
 {
     QMutexLocker lock(&d->continuationMutex);
     if (d->continuation) {
+        // run the continuation only once, even if reportFinished() is
+        // called again
+        auto fn = std::exchange(d->continuation, nullptr);
         lock.unlock();
-        d->continuation();
+        fn();
     }
 }
 
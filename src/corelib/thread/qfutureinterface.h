@@ -48,6 +48,7 @@
 #include <utility>
 #include <vector>
 #include <mutex>
+#include <new>
 
 QT_REQUIRE_CONFIG(future);
 
@@ -71,6 +72,26 @@ class CanceledHandler;
 template<class Function, class ResultType>
 class FailureHandler;
 #endif
+
+template<class T>
+class FutureAwaiter;
+
+Q_CORE_EXPORT void *allocateContinuationStorage(std::size_t size);
+Q_CORE_EXPORT void freeContinuationStorage(void *ptr, std::size_t size);
+
+// Base class for the objects that implement continuations, which are
+// allocated and freed for every then(). Their memory is recycled per thread,
+// except for over-aligned continuations, which the pool cannot align.
+class PooledContinuationStorage
+{
+public:
+    static void *operator new(std::size_t size) { return allocateContinuationStorage(size); }
+    static void operator delete(void *ptr, std::size_t size) { freeContinuationStorage(ptr, size); }
+    static void *operator new(std::size_t size, std::align_val_t alignment)
+    { return ::operator new(size, alignment); }
+    static void operator delete(void *ptr, std::size_t size, std::align_val_t alignment)
+    { ::operator delete(ptr, size, alignment); }
+};
 }
 
 class Q_CORE_EXPORT QFutureInterfaceBase
@@ -189,6 +210,9 @@ private:
     friend class QtPrivate::FailureHandler;
 #endif
 
+    template<class T>
+    friend class QtPrivate::FutureAwaiter;
+
 protected:
     void setContinuation(std::function<void()> func);
     void runContinuation() const;
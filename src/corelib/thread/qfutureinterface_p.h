@@ -59,6 +59,8 @@
 #include <QtCore/qrunnable.h>
 #include <QtCore/qthreadpool.h>
 
+#include <memory>
+
 QT_REQUIRE_CONFIG(future);
 
 QT_BEGIN_NAMESPACE
@@ -127,11 +129,38 @@ public:
     virtual void callOutInterfaceDisconnected() = 0;
 };
 
+// Allocates the QWaitCondition only when somebody waits, as most futures
+// are never waited for. Must be used with QFutureInterfaceBasePrivate::m_mutex
+// locked.
+class QFutureWaitCondition
+{
+public:
+    void wait(QMutex *mutex)
+    {
+        if (!cond)
+            cond.reset(new QWaitCondition);
+        cond->wait(mutex);
+    }
+    void wakeAll()
+    {
+        if (cond)
+            cond->wakeAll();
+    }
+
+private:
+    std::unique_ptr<QWaitCondition> cond;
+};
+
 class QFutureInterfaceBasePrivate
 {
 public:
     QFutureInterfaceBasePrivate(QFutureInterfaceBase::State initialState);
 
+    static void *operator new(std::size_t size)
+    { return QtPrivate::allocateContinuationStorage(size); }
+    static void operator delete(void *ptr, std::size_t size)
+    { QtPrivate::freeContinuationStorage(ptr, size); }
+
     // When the last QFuture<T> reference is removed, we need to make
     // sure that data stored in the ResultStore is cleaned out.
     // Since QFutureInterfaceBasePrivate can be shared between QFuture<T>
@@ -160,14 +189,14 @@ public:
     // Q: accessed from the waiting/querying thread
     RefCount refCount;
     mutable QMutex m_mutex;
-    QWaitCondition waitCondition;
+    QFutureWaitCondition waitCondition;
     QList<QFutureCallOutInterface *> outputConnections;
     int m_progressValue; // TQ
     int m_progressMinimum; // TQ
     int m_progressMaximum; // TQ
     QAtomicInt state; // reads and writes can happen unprotected, both must be atomic
     QElapsedTimer progressTime;
-    QWaitCondition pausedWaitCondition;
+    QFutureWaitCondition pausedWaitCondition;
     QtPrivate::ResultStoreBase m_results;
     bool manualProgress; // only accessed from executing thread
     int m_expectedResultCount;
@@ -59,38 +59,49 @@ namespace QtPrivate {
  */
 
 ResultIteratorBase::ResultIteratorBase()
- : mapIterator(QMap<int, ResultItem>::const_iterator()), m_vectorIndex(0) { }
+ : mapIterator(QMap<int, ResultItem>::const_iterator()), firstItem(nullptr), m_vectorIndex(0) { }
 ResultIteratorBase::ResultIteratorBase(QMap<int, ResultItem>::const_iterator _mapIterator, int _vectorIndex)
- : mapIterator(_mapIterator), m_vectorIndex(_vectorIndex) { }
+ : mapIterator(_mapIterator), firstItem(nullptr), m_vectorIndex(_vectorIndex) { }
+// _mapIterator must point to the beginning of the map, where the iteration
+// continues after the first item.
+ResultIteratorBase::ResultIteratorBase(const ResultItem *_firstItem,
+                                       QMap<int, ResultItem>::const_iterator _mapIterator,
+                                       int _vectorIndex)
+ : mapIterator(_mapIterator), firstItem(_firstItem), m_vectorIndex(_vectorIndex) { }
 
 int ResultIteratorBase::vectorIndex() const { return m_vectorIndex; }
-int ResultIteratorBase::resultIndex() const { return mapIterator.key() + m_vectorIndex; }
+int ResultIteratorBase::resultIndex() const
+{
+    return (firstItem ? 0 : mapIterator.key()) + m_vectorIndex;
+}
 
 ResultIteratorBase ResultIteratorBase::operator++()
 {
-    if (canIncrementVectorIndex()) {
+    if (canIncrementVectorIndex())
         ++m_vectorIndex;
-    } else {
-        ++mapIterator;
-        m_vectorIndex = 0;
-    }
+    else
+        batchedAdvance();
     return *this;
 }
 
 int ResultIteratorBase::batchSize() const
 {
-    return mapIterator.value().count();
+    return item().count();
 }
 
 void ResultIteratorBase::batchedAdvance()
 {
-    ++mapIterator;
+    if (firstItem)
+        firstItem = nullptr;
+    else
+        ++mapIterator;
     m_vectorIndex = 0;
 }
 
 bool ResultIteratorBase::operator==(const ResultIteratorBase &other) const
 {
-    return (mapIterator == other.mapIterator && m_vectorIndex == other.m_vectorIndex);
+    return (mapIterator == other.mapIterator && firstItem == other.firstItem
+            && m_vectorIndex == other.m_vectorIndex);
 }
 
 bool ResultIteratorBase::operator!=(const ResultIteratorBase &other) const
@@ -100,20 +111,22 @@ bool ResultIteratorBase::operator!=(const ResultIteratorBase &other) const
 
 bool ResultIteratorBase::isVector() const
 {
-    return mapIterator.value().isVector();
+    return item().isVector();
 }
 
 bool ResultIteratorBase::canIncrementVectorIndex() const
 {
-    return (m_vectorIndex + 1 < mapIterator.value().m_count);
+    return (m_vectorIndex + 1 < item().m_count);
 }
 
 ResultStoreBase::ResultStoreBase()
-    : insertIndex(0), resultCount(0), m_filterMode(false), filteredResults(0) { }
+    : insertIndex(0), resultCount(0), m_filterMode(false), filteredResults(0),
+      m_inlineResultUsed(false) { }
 
 ResultStoreBase::~ResultStoreBase()
 {
     // QFutureInterface's dtor must delete the contents of m_results.
+    Q_ASSERT(!m_firstResult.isValid());
     Q_ASSERT(m_results.isEmpty());
 }
 
@@ -139,7 +152,10 @@ void ResultStoreBase::syncResultCount()
 void ResultStoreBase::insertResultItemIfValid(int index, ResultItem &resultItem)
 {
     if (resultItem.isValid()) {
-        m_results[index] = resultItem;
+        if (index == 0)
+            m_firstResult = resultItem;
+        else
+            m_results[index] = resultItem;
         syncResultCount();
     } else {
         filteredResults += resultItem.count();
@@ -162,6 +178,10 @@ int ResultStoreBase::insertResultItem(int index, ResultItem &resultItem)
 
 void ResultStoreBase::syncPendingResults()
 {
+    // avoid detaching (and allocating) the empty map
+    if (pendingResults.isEmpty())
+        return;
+
     // check if we can insert any of the pending results:
     QMap<int, ResultItem>::iterator it = pendingResults.begin();
     while (it != pendingResults.end()) {
@@ -199,6 +219,8 @@ int ResultStoreBase::addResults(int index, const void *results, int vectorSize,
 
 ResultIteratorBase ResultStoreBase::begin() const
 {
+    if (m_firstResult.isValid())
+        return ResultIteratorBase(&m_firstResult, m_results.begin());
     return ResultIteratorBase(m_results.begin());
 }
 
@@ -214,6 +236,9 @@ bool ResultStoreBase::hasNextResult() const
 
 ResultIteratorBase ResultStoreBase::resultAt(int index) const
 {
+    if (m_firstResult.isValid() && index >= 0 && index < m_firstResult.count())
+        return ResultIteratorBase(&m_firstResult, m_results.begin(), index);
+
     if (m_results.isEmpty())
         return ResultIteratorBase(m_results.end());
     QMap<int, ResultItem>::const_iterator it = m_results.lowerBound(index);
@@ -43,6 +43,8 @@
 #include <QtCore/qmap.h>
 #include <QtCore/qdebug.h>
 
+#include <cstddef>
+#include <new>
 #include <utility>
 
 QT_REQUIRE_CONFIG(future);
@@ -77,6 +79,8 @@ class Q_CORE_EXPORT ResultIteratorBase
 public:
     ResultIteratorBase();
     ResultIteratorBase(QMap<int, ResultItem>::const_iterator _mapIterator, int _vectorIndex = 0);
+    ResultIteratorBase(const ResultItem *_firstItem, QMap<int, ResultItem>::const_iterator _mapIterator,
+                       int _vectorIndex = 0);
     int vectorIndex() const;
     int resultIndex() const;
 
@@ -88,7 +92,10 @@ public:
     bool isVector() const;
     bool canIncrementVectorIndex() const;
 protected:
+    const ResultItem &item() const { return firstItem ? *firstItem : mapIterator.value(); }
+
     QMap<int, ResultItem>::const_iterator mapIterator;
+    const ResultItem *firstItem; // the item at index 0, or null when iterating the map
     int m_vectorIndex;
 public:
     template <typename T>
@@ -113,10 +120,10 @@ public:
     template <typename T>
     const T *pointer() const
     {
-        if (mapIterator.value().isVector())
-            return &(reinterpret_cast<const QList<T> *>(mapIterator.value().result)->at(m_vectorIndex));
+        if (item().isVector())
+            return &(reinterpret_cast<const QList<T> *>(item().result)->at(m_vectorIndex));
         else
-            return reinterpret_cast<const T *>(mapIterator.value().result);
+            return reinterpret_cast<const T *>(item().result);
     }
 };
 
@@ -143,6 +150,9 @@ protected:
     void syncResultCount();
     int updateInsertIndex(int index, int _count);
 
+    // The item at index 0 is kept out of the map, so that a future with a
+    // single result does not allocate map nodes.
+    ResultItem m_firstResult;
     QMap<int, ResultItem> m_results;
     int insertIndex;     // The index where the next results(s) will be inserted.
     int resultCount;     // The number of consecutive results stored, starting at index 0.
@@ -151,6 +161,37 @@ protected:
     QMap<int, ResultItem> pendingResults;
     int filteredResults;
 
+    // One small result is stored here instead of on the heap.
+    alignas(std::max_align_t) char m_inlineResult[2 * sizeof(void *)];
+    bool m_inlineResultUsed;
+
+    template <typename T, typename... Args>
+    void *allocateResult(Args &&...args)
+    {
+        if constexpr (sizeof(T) <= sizeof(m_inlineResult)
+                      && alignof(T) <= alignof(std::max_align_t)) {
+            if (!m_inlineResultUsed) {
+                void *result = new (m_inlineResult) T(std::forward<Args>(args)...);
+                m_inlineResultUsed = true;
+                return result;
+            }
+        }
+        return new T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    void destroyResult(const ResultItem &item)
+    {
+        if (item.isVector()) {
+            delete reinterpret_cast<const QList<T> *>(item.result);
+        } else if (item.result == m_inlineResult) {
+            reinterpret_cast<const T *>(item.result)->~T();
+            m_inlineResultUsed = false;
+        } else {
+            delete reinterpret_cast<const T *>(item.result);
+        }
+    }
+
 public:
     template <typename T>
     int addResult(int index, const T *result)
@@ -158,13 +199,13 @@ public:
         if (result == nullptr)
             return addResult(index, static_cast<void *>(nullptr));
 
-        return addResult(index, static_cast<void *>(new T(*result)));
+        return addResult(index, allocateResult<T>(*result));
     }
 
     template <typename T>
     int moveResult(int index, T &&result)
     {
-        return addResult(index, static_cast<void *>(new T(std::move_if_noexcept(result))));
+        return addResult(index, allocateResult<T>(std::move_if_noexcept(result)));
     }
 
     template<typename T>
@@ -197,12 +238,13 @@ public:
     template <typename T>
     void clear()
     {
+        if (m_firstResult.isValid()) {
+            destroyResult<T>(m_firstResult);
+            m_firstResult = ResultItem();
+        }
         QMap<int, ResultItem>::const_iterator mapIterator = m_results.constBegin();
         while (mapIterator != m_results.constEnd()) {
-            if (mapIterator.value().isVector())
-                delete reinterpret_cast<const QList<T> *>(mapIterator.value().result);
-            else
-                delete reinterpret_cast<const T *>(mapIterator.value().result);
+            destroyResult<T>(mapIterator.value());
             ++mapIterator;
         }
         resultCount = 0;
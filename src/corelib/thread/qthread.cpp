@@ -43,6 +43,7 @@
 #include "qmutex.h"
 #include "qreadwritelock.h"
 #include "qabstracteventdispatcher.h"
+#include "qvarlengtharray.h"
 
 #include <qeventloop.h>
 
@@ -93,6 +94,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    addPendingEvents();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -129,6 +131,47 @@ QAbstractEventDispatcher *QThreadData::createEventDispatcher()
     return ed;
 }
 
+/*
+    Moves the events pushed without the mutex to the list of posted events.
+    An event whose receiver moved to another thread after it was pushed is
+    passed on to that thread. The caller must hold postEventList.mutex.
+*/
+void QThreadData::addPendingEventsHelper()
+{
+    QVarLengthArray<QPostEventList::PendingEvent *, 64> events;
+    for (auto pe = postEventList.firstPendingEvent(); pe; pe = pe->next) {
+        events.append(pe);
+        QObject *receiver = pe->receiver;
+        if (QObjectPrivate::get(receiver)->threadData.loadRelaxed() == this)
+            ++receiver->d_func()->postedEvents;
+    }
+    postEventList.detachPendingEvents(events.first());
+
+    // oldest first
+    bool added = false;
+    for (qsizetype i = events.size() - 1; i >= 0; --i) {
+        QPostEventList::PendingEvent *pe = events.at(i);
+        QObject *receiver = pe->receiver;
+        QThreadData *data = QObjectPrivate::get(receiver)->threadData.loadRelaxed();
+        if (data == this) {
+            postEventList.addEvent(QPostEvent(receiver, pe->event, Qt::NormalEventPriority));
+            added = true;
+            delete pe;
+        } else if (data) {
+            data->postEventList.pushPendingEvent(pe);
+            if (QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire())
+                dispatcher->wakeUp();
+        } else {
+            // destruction in progress
+            pe->event->posted = false;
+            delete pe->event;
+            delete pe;
+        }
+    }
+    if (added)
+        canWait = false;
+}
+
 /*
   QAdoptedThread
 */
@@ -326,6 +369,29 @@ QThreadPrivate::~QThreadPrivate()
     switch.
 */
 
+/*!
+    \fn int QThread::numaNodeCount()
+    \since 6.0
+
+    Returns the number of NUMA nodes in the system. Systems without NUMA, and
+    systems where Qt cannot determine the topology, have one node, holding
+    all the processors.
+
+    \sa numaNodeCpus(), setCpuAffinity()
+*/
+
+/*!
+    \fn QList<int> QThread::numaNodeCpus(int node)
+    \since 6.0
+
+    Returns the processors of the NUMA node \a node, as numbered by the
+    operating system, or an empty list if there is no such node.
+
+    Pass the result to setCpuAffinity() to keep a thread on one node.
+
+    \sa numaNodeCount()
+*/
+
 /*!
     \fn void QThread::start(Priority priority)
 
@@ -513,6 +579,71 @@ uint QThread::stackSize() const
     return d->stackSize;
 }
 
+/*!
+    \since 6.0
+
+    Restricts the thread to the processors in \a cpus, as numbered by the
+    operating system. An empty list lifts the restriction again, so that the
+    thread runs on the processors it was started with, which it inherits from
+    the thread that started it.
+
+    If the thread is running, this takes effect immediately; otherwise it
+    takes effect when the thread is started.
+
+    \note This is currently only implemented on Linux. On other platforms,
+    the list is stored, but has no effect.
+
+    \sa cpuAffinity(), numaNodeCpus()
+*/
+void QThread::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_D(QThread);
+    QMutexLocker locker(&d->mutex);
+    d->cpuAffinity = cpus;
+    if (d->running && !d->isInFinish)
+        d->applyCpuAffinity();
+}
+
+/*!
+    \since 6.0
+
+    Returns the processors that the thread is restricted to, as set with
+    setCpuAffinity(), or an empty list if it is not restricted.
+
+    \sa setCpuAffinity()
+*/
+QList<int> QThread::cpuAffinity() const
+{
+    Q_D(const QThread);
+    QMutexLocker locker(&d->mutex);
+    return d->cpuAffinity;
+}
+
+static const QList<QList<int>> &numaNodes()
+{
+    static const QList<QList<int>> nodes = [] {
+        QList<QList<int>> nodes = QThreadPrivate::readNumaNodes();
+        if (nodes.isEmpty()) {
+            QList<int> cpus;
+            for (int cpu = 0; cpu < QThread::idealThreadCount(); ++cpu)
+                cpus.append(cpu);
+            nodes.append(cpus);
+        }
+        return nodes;
+    }();
+    return nodes;
+}
+
+int QThread::numaNodeCount()
+{
+    return numaNodes().size();
+}
+
+QList<int> QThread::numaNodeCpus(int node)
+{
+    return numaNodes().value(node);
+}
+
 /*!
     Enters the event loop and waits until exit() is called, returning the value
     that was passed to exit(). The value returned is 0 if exit() is called via
@@ -873,6 +1004,16 @@ void QThread::yieldCurrentThread()
 
 }
 
+int QThread::numaNodeCount()
+{
+    return 1;
+}
+
+QList<int> QThread::numaNodeCpus(int node)
+{
+    return node == 0 ? QList<int>{ 0 } : QList<int>();
+}
+
 bool QThread::isFinished() const
 {
     return false;
@@ -938,6 +1079,16 @@ uint QThread::stackSize() const
     return 0;
 }
 
+void QThread::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_UNUSED(cpus);
+}
+
+QList<int> QThread::cpuAffinity() const
+{
+    return QList<int>();
+}
+
 #endif // QT_CONFIG(thread)
 
 /*!
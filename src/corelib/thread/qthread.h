@@ -73,6 +73,8 @@ public:
     static QThread *currentThread();
     static int idealThreadCount() noexcept;
     static void yieldCurrentThread();
+    static int numaNodeCount();
+    static QList<int> numaNodeCpus(int node);
 
     explicit QThread(QObject *parent = nullptr);
     ~QThread();
@@ -103,6 +105,9 @@ public:
     void setStackSize(uint stackSize);
     uint stackSize() const;
 
+    void setCpuAffinity(const QList<int> &cpus);
+    QList<int> cpuAffinity() const;
+
     void exit(int retcode = 0);
 
     QAbstractEventDispatcher *eventDispatcher() const;
@@ -107,8 +107,54 @@ public:
 
     QMutex mutex;
 
+    // Queued calls with the default priority are not added to the list
+    // directly, but pushed here without taking the mutex. Whoever holds the
+    // mutex next moves them to the list; see QThreadData::addPendingEvents().
+    struct PendingEvent {
+        QObject *receiver;
+        QEvent *event;
+        PendingEvent *next;
+    };
+    QAtomicPointer<PendingEvent> pending;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
+    bool hasPendingEvents() const
+    {
+        return pending.loadAcquire() != nullptr;
+    }
+
+    // any thread
+    void pushPendingEvent(PendingEvent *pe)
+    {
+        PendingEvent *head = pending.loadRelaxed();
+        do {
+            pe->next = head;
+        } while (!pending.testAndSetOrdered(head, pe, head));
+    }
+
+    // The rest needs the mutex. Events stay visible in hasPendingEvents()
+    // until they have been counted in QObjectData::postedEvents, so that
+    // ~QObject() does not miss them.
+
+    // returns the newest event; the older ones follow through next
+    PendingEvent *firstPendingEvent() const
+    {
+        return pending.loadAcquire();
+    }
+
+    // removes first and the events older than it
+    void detachPendingEvents(PendingEvent *first)
+    {
+        if (pending.testAndSetOrdered(first, nullptr))
+            return;
+        // more events were pushed meanwhile; they are ahead of first
+        PendingEvent *pe = pending.loadAcquire();
+        while (pe->next != first)
+            pe = pe->next;
+        pe->next = nullptr;
+    }
+
     void addEvent(const QPostEvent &ev) {
         int priority = ev.priority;
         if (isEmpty() ||
@@ -149,6 +195,9 @@ public:
     ~QThreadPrivate();
 
     void setPriority(QThread::Priority prio);
+    void applyCpuAffinity();
+    static QList<QList<int>> readNumaNodes();
+    static int currentCpu();
 
     mutable QMutex mutex;
     QAtomicInt quitLockRef;
@@ -163,6 +212,8 @@ public:
 
     uint stackSize;
     QThread::Priority priority;
+    QList<int> cpuAffinity;
+    QList<int> inheritedCpuAffinity; // before cpuAffinity was applied, if it was
 
     static QThread *threadForId(int id);
 
@@ -255,9 +306,18 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
+        addPendingEvents();
         return canWait;
     }
 
+    // caller must hold postEventList.mutex
+    void addPendingEvents()
+    {
+        if (postEventList.hasPendingEvents())
+            addPendingEventsHelper();
+    }
+    void addPendingEventsHelper();
+
     // This class provides per-thread (by way of being a QThreadData
     // member) storage for qFlagLocation()
     class FlaggedDebugSignatures
@@ -278,6 +278,9 @@ void *QThreadPrivate::start(void *arg)
             data->threadId.storeRelaxed(to_HANDLE(pthread_self()));
             set_thread_data(data);
 
+            if (!thr->d_func()->cpuAffinity.isEmpty())
+                thr->d_func()->applyCpuAffinity();
+
             data->ref();
             data->quitNow = thr->d_func()->exited;
         }
@@ -473,6 +476,100 @@ void QThread::yieldCurrentThread()
     sched_yield();
 }
 
+#ifdef Q_OS_LINUX
+// Reads a sysfs cpu list such as "0-3,8-11" into a list of numbers.
+static QList<int> readSysfsList(const char *path)
+{
+    QList<int> result;
+    int fd = qt_safe_open(path, O_RDONLY);
+    if (fd == -1)
+        return result;
+    char buffer[4096];
+    qint64 len = qt_safe_read(fd, buffer, sizeof(buffer) - 1);
+    qt_safe_close(fd);
+    if (len <= 0)
+        return result;
+    buffer[len] = '\0';
+
+    const char *p = buffer;
+    while (*p >= '0' && *p <= '9') {
+        char *end;
+        int first = int(strtol(p, &end, 10));
+        int last = first;
+        if (*end == '-')
+            last = int(strtol(end + 1, &end, 10));
+        for (int i = first; i <= last; ++i)
+            result.append(i);
+        p = *end == ',' ? end + 1 : end;
+    }
+    return result;
+}
+#endif
+
+QList<QList<int>> QThreadPrivate::readNumaNodes()
+{
+    QList<QList<int>> nodes;
+#ifdef Q_OS_LINUX
+    const QList<int> online = readSysfsList("/sys/devices/system/node/online");
+    for (int node : online) {
+        char path[64];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        QList<int> cpus = readSysfsList(path);
+        // memory-only nodes have no processors to place threads on
+        if (!cpus.isEmpty())
+            nodes.append(cpus);
+    }
+#endif
+    return nodes;
+}
+
+int QThreadPrivate::currentCpu()
+{
+#if defined(Q_OS_LINUX) && !defined(QT_LINUXBASE)
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+// Caller must lock the mutex
+void QThreadPrivate::applyCpuAffinity()
+{
+#if defined(Q_OS_LINUX) && !defined(QT_LINUXBASE)
+    const pthread_t thread = from_HANDLE<pthread_t>(data->threadId.loadRelaxed());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cpuAffinity.isEmpty()) {
+        // give the thread back the processors it was started with
+        if (inheritedCpuAffinity.isEmpty())
+            return;
+        for (int cpu : qAsConst(inheritedCpuAffinity))
+            CPU_SET(cpu, &set);
+        inheritedCpuAffinity.clear();
+    } else {
+        if (inheritedCpuAffinity.isEmpty()) {
+            cpu_set_t inherited;
+            if (pthread_getaffinity_np(thread, sizeof(inherited), &inherited) == 0) {
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                    if (CPU_ISSET(cpu, &inherited))
+                        inheritedCpuAffinity.append(cpu);
+                }
+            }
+        }
+        for (int cpu : qAsConst(cpuAffinity)) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &set);
+        }
+        if (CPU_COUNT(&set) == 0) {
+            qWarning("QThread::setCpuAffinity: Cannot set the processor affinity, no valid processor");
+            return;
+        }
+    }
+    if (pthread_setaffinity_np(thread, sizeof(set), &set) != 0)
+        qWarning("QThread::setCpuAffinity: Cannot set the processor affinity");
+#endif
+}
+
 #endif // QT_CONFIG(thread)
 
 static timespec makeTimespec(time_t secs, long nsecs)
@@ -611,6 +708,7 @@ void QThread::start(Priority priority)
     d->returnCode = 0;
     d->exited = false;
     d->interruptionRequested = false;
+    d->inheritedCpuAffinity.clear();
 
     pthread_attr_t attr;
     pthread_attr_init(&attr);
@@ -387,6 +387,21 @@ void QThread::yieldCurrentThread()
     SwitchToThread();
 }
 
+QList<QList<int>> QThreadPrivate::readNumaNodes()
+{
+    return QList<QList<int>>();
+}
+
+int QThreadPrivate::currentCpu()
+{
+    return int(GetCurrentProcessorNumber());
+}
+
+// Caller must hold the mutex
+void QThreadPrivate::applyCpuAffinity()
+{
+}
+
 #endif // QT_CONFIG(thread)
 
 void QThread::sleep(unsigned long secs)
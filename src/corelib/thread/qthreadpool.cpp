@@ -41,8 +41,12 @@
 #include "qthreadpool_p.h"
 #include "qdeadlinetimer.h"
 #include "qcoreapplication.h"
+#include "qvarlengtharray.h"
+
+#include <private/qthread_p.h>
 
 #include <algorithm>
+#include <atomic>
 
 QT_BEGIN_NAMESPACE
 
@@ -60,8 +64,106 @@ public:
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // work-stealing mode
+    QWorkStealingQueue localQueue;
+    int stealIndex = 0;
+
+    // NUMA-aware mode; read by thieves without the mutex
+    QAtomicInt numaNode = -1;
 };
 
+// the pool thread running on the current thread, if any
+static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+
+QWorkStealingQueue::QWorkStealingQueue()
+    : top(0), bottom(0), buffer(new Buffer(InitialCapacity, nullptr))
+{
+}
+
+QWorkStealingQueue::~QWorkStealingQueue()
+{
+    delete buffer.loadRelaxed();
+}
+
+void QWorkStealingQueue::push(QRunnable *runnable)
+{
+    const qint64 b = bottom.loadRelaxed();
+    const qint64 t = top.loadAcquire();
+    Buffer *a = buffer.loadRelaxed();
+    if (b - t > a->mask) {
+        a = new Buffer(2 * (a->mask + 1), a);
+        for (qint64 i = t; i < b; ++i)
+            a->at(i).storeRelaxed(a->previous->at(i).loadRelaxed());
+        buffer.storeRelease(a);
+    }
+    a->at(b).storeRelaxed(runnable);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.storeRelaxed(b + 1);
+}
+
+QRunnable *QWorkStealingQueue::pop()
+{
+    // thieves only ever make it emptier, so this needs no fence
+    if (isEmpty())
+        return nullptr;
+
+    const qint64 b = bottom.loadRelaxed() - 1;
+    Buffer *a = buffer.loadRelaxed();
+    bottom.storeRelaxed(b);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const qint64 t = top.loadRelaxed();
+    if (t > b) {
+        // empty
+        bottom.storeRelaxed(b + 1);
+        return nullptr;
+    }
+
+    QRunnable *runnable = a->at(b).loadRelaxed();
+    if (t == b) {
+        // the last entry: a thief may be taking it at the same time
+        if (!top.testAndSetOrdered(t, t + 1))
+            runnable = nullptr;
+        bottom.storeRelaxed(b + 1);
+    }
+    return runnable;
+}
+
+QRunnable *QWorkStealingQueue::steal()
+{
+    // cheap check first, as most queues tried are empty
+    if (bottom.loadRelaxed() <= top.loadRelaxed())
+        return nullptr;
+
+    for (;;) {
+        const qint64 t = top.loadAcquire();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const qint64 b = bottom.loadAcquire();
+        if (t >= b)
+            return nullptr;
+
+        QRunnable *runnable = buffer.loadAcquire()->at(t).loadRelaxed();
+        if (top.testAndSetOrdered(t, t + 1))
+            return runnable;
+        // lost the race against the owner or another thief, try again
+    }
+}
+
+/*
+    Only a hint when called from a thread other than the owner.
+*/
+bool QWorkStealingQueue::contains(const QRunnable *runnable) const
+{
+    const qint64 t = top.loadAcquire();
+    const qint64 b = bottom.loadAcquire();
+    const Buffer *a = buffer.loadAcquire();
+    for (qint64 i = t; i < b; ++i) {
+        if (a->at(i).loadRelaxed() == runnable)
+            return true;
+    }
+    return false;
+}
+
 /*
     QThreadPool private class.
 */
@@ -81,6 +183,7 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -88,59 +191,68 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                const bool del = r->autoDelete();
-                Q_ASSERT(!del || r->ref == 1);
-
-
                 // run the task
                 locker.unlock();
+                do {
+                    const bool del = r->autoDelete();
+                    Q_ASSERT(!del || r->ref == 1);
+
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // in work-stealing mode, carry on without the lock for
+                    // as long as there is local or stealable work
+                } while (manager->workStealing && (r = manager->takeTaskUnlocked(this)));
                 locker.relock();
             }
 
             // if too many threads are active, expire this thread
-            if (manager->tooManyThreadsActive())
+            // (but not while it has runnables queued of its own)
+            if (manager->tooManyThreadsActive() && localQueue.isEmpty())
                 break;
 
-            if (manager->queue.isEmpty()) {
-                r = nullptr;
-                break;
-            }
-
-            QueuePage *page = manager->queue.first();
-            r = page->pop();
-
-            if (page->isFinished()) {
-                manager->queue.removeFirst();
-                delete page;
-            }
-        } while (true);
+            r = manager->takeTask(this);
+        } while (r);
 
         // if too many threads are active, expire this thread
         bool expired = manager->tooManyThreadsActive();
         if (!expired) {
             manager->waitingThreads.enqueue(this);
+            manager->updateIdleThreads();
+            if (manager->workStealing) {
+                // Another worker may have queued a runnable since we last
+                // looked, without seeing this thread as idle yet. The fence
+                // pairs with the one in startLocalTask().
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                runnable = manager->stealTask(this);
+                if (runnable) {
+                    manager->waitingThreads.removeOne(this);
+                    manager->updateIdleThreads();
+                    continue;
+                }
+            }
             registerThreadInactive();
             // wait for work, exiting after the expiry timeout is reached
             runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
             ++manager->activeThreads;
-            if (manager->waitingThreads.removeOne(this))
+            if (manager->waitingThreads.removeOne(this)) {
+                manager->updateIdleThreads();
                 expired = true;
+            }
             if (!manager->allThreads.contains(this)) {
                 registerThreadInactive();
                 break;
@@ -152,10 +264,12 @@ void QThreadPoolThread::run()
             break;
         }
     }
+    currentPoolThread = nullptr;
 }
 
 void QThreadPoolThread::registerThreadInactive()
 {
+    manager->saturated.storeRelaxed(false);
     if (--manager->activeThreads == 0)
         manager->noActiveThreads.wakeAll();
 }
@@ -165,8 +279,15 @@ void QThreadPoolThread::registerThreadInactive()
     \internal
 */
 QThreadPoolPrivate:: QThreadPoolPrivate()
+    : workStealing(qEnvironmentVariableIntValue("QT_THREADPOOL_WORK_STEALING") > 0)
 { }
 
+QThreadPoolPrivate::~QThreadPoolPrivate()
+{
+    delete stealThreads.loadRelaxed();
+    qDeleteAll(retiredStealThreads);
+}
+
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
 {
     Q_ASSERT(task != nullptr);
@@ -183,7 +304,7 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
     if (waitingThreads.count() > 0) {
         // recycle an available thread
         enqueueTask(task);
-        waitingThreads.takeFirst()->runnableReady.wakeOne();
+        takeWaitingThread()->runnableReady.wakeOne();
         return true;
     }
 
@@ -212,6 +333,8 @@ inline bool comparePriority(int priority, const QueuePage *p)
 void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     Q_ASSERT(runnable != nullptr);
+    if (priority > 0)
+        highPriorityQueued.storeRelaxed(true);
     for (QueuePage *page : qAsConst(queue)) {
         if (page->priority() == priority && !page->isFull()) {
             page->push(runnable);
@@ -258,13 +381,15 @@ bool QThreadPoolPrivate::tooManyThreadsActive() const
 */
 void QThreadPoolPrivate::startThread(QRunnable *runnable)
 {
-    Q_ASSERT(runnable != nullptr);
+    Q_ASSERT(runnable != nullptr || workStealing); // thieves start without one
     QScopedPointer <QThreadPoolThread> thread(new QThreadPoolThread(this));
     thread->setObjectName(QLatin1String("Thread (pooled)"));
     Q_ASSERT(!allThreads.contains(thread.data())); // if this assert hits, we have an ABA problem (deleted threads don't get removed here)
     allThreads.insert(thread.data());
+    updateStealThreads();
     ++activeThreads;
 
+    placeThread(thread.data(), numaAware ? pickNumaNode() : -1);
     thread->runnable = runnable;
     thread.take()->start();
 }
@@ -281,6 +406,12 @@ void QThreadPoolPrivate::reset()
     allThreadsCopy.swap(allThreads);
     expiredThreads.clear();
     waitingThreads.clear();
+    updateIdleThreads();
+
+    // no thread is active, so none is stealing from the old queues
+    updateStealThreads();
+    qDeleteAll(retiredStealThreads);
+    retiredStealThreads.clear();
     mutex.unlock();
 
     for (QThreadPoolThread *thread: qAsConst(allThreadsCopy)) {
@@ -338,6 +469,324 @@ void QThreadPoolPrivate::clear()
     }
     qDeleteAll(queue);
     queue.clear();
+
+    if (workStealing) {
+        QList<QRunnable *> autoDeleted;
+        for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+            while (QRunnable *r = thread->localQueue.steal()) {
+                if (r->autoDelete()) {
+                    Q_ASSERT(r->ref == 1);
+                    autoDeleted.append(r);
+                }
+            }
+        }
+        locker.unlock();
+        qDeleteAll(autoDeleted);
+    }
+}
+
+/*!
+    \internal
+
+    Returns the next runnable for \a thread to run, or \c nullptr if there is
+    none. In work-stealing mode, runnables queued with a priority higher than
+    the default come first, then the thread's own, then stolen ones, and then
+    the rest of the queue.
+*/
+QRunnable *QThreadPoolPrivate::takeTask(QThreadPoolThread *thread)
+{
+    if (workStealing) {
+        const bool highPriority = !queue.isEmpty() && queue.constFirst()->priority() > 0;
+        highPriorityQueued.storeRelaxed(highPriority);
+        if (!highPriority) {
+            if (QRunnable *r = thread->localQueue.pop())
+                return r;
+            if (QRunnable *r = stealTask(thread))
+                return r;
+        }
+    }
+
+    if (queue.isEmpty())
+        return nullptr;
+
+    QueuePage *page = queue.constFirst();
+    QRunnable *r = page->pop();
+
+    if (page->isFinished()) {
+        queue.removeFirst();
+        delete page;
+    }
+    return r;
+}
+
+/*!
+    \internal
+
+    Like takeTask(), without holding the mutex: returns \c nullptr if the
+    next runnable has to come from the queue.
+*/
+QRunnable *QThreadPoolPrivate::takeTaskUnlocked(QThreadPoolThread *thread)
+{
+    if (highPriorityQueued.loadRelaxed())
+        return nullptr;
+    if (QRunnable *r = thread->localQueue.pop())
+        return r;
+    return stealTask(thread);
+}
+
+/*!
+    \internal
+
+    Steals a runnable from another worker. In NUMA-aware mode, workers on
+    the same node as \a thread are tried first, as the data of their
+    runnables is more likely to be in nearby memory.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thread)
+{
+    const QList<QThreadPoolThread *> *threads = stealThreads.loadAcquire();
+    const int count = threads ? threads->size() : 0;
+    const int node = thread->numaNode.loadRelaxed();
+    const bool sameNodeFirst = node >= 0;
+    for (int pass = sameNodeFirst ? 0 : 1; pass < 2; ++pass) {
+        for (int i = 0; i < count; ++i) {
+            // start with the victim of the last successful steal
+            const int index = (thread->stealIndex + i) % count;
+            QThreadPoolThread *victim = threads->at(index);
+            if (victim == thread)
+                continue;
+            if (sameNodeFirst && (victim->numaNode.loadRelaxed() == node) != (pass == 0))
+                continue;
+            if (QRunnable *r = victim->localQueue.steal()) {
+                thread->stealIndex = index;
+                return r;
+            }
+        }
+    }
+    return nullptr;
+}
+
+/*!
+    \internal
+
+    Returns the pool thread running on the current thread, if the pool is in
+    work-stealing mode and the thread is one of its own.
+*/
+QThreadPoolThread *QThreadPoolPrivate::currentWorker() const
+{
+    if (!workStealing || !currentPoolThread || currentPoolThread->manager != this)
+        return nullptr;
+    return currentPoolThread;
+}
+
+void QThreadPoolPrivate::startLocalTask(QThreadPoolThread *thread, QRunnable *runnable)
+{
+    thread->localQueue.push(runnable);
+
+    // The runnable is going to run anyway, as its thread is busy and will
+    // pop it eventually, so take the mutex only if another thread could
+    // steal it now. The fence pairs with the one in QThreadPoolThread::run()
+    // before a thread goes idle.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (idleThreads.loadRelaxed() > 0 || !saturated.loadRelaxed()) {
+        QMutexLocker locker(&mutex);
+        startThief();
+    }
+}
+
+/*!
+    \internal
+
+    Wakes up or starts a thread to steal runnables from the others.
+*/
+void QThreadPoolPrivate::startThief()
+{
+    if (!waitingThreads.isEmpty()) {
+        takeWaitingThread()->runnableReady.wakeOne();
+    } else if (activeThreadCount() < maxThreadCount) {
+        if (!expiredThreads.isEmpty()) {
+            QThreadPoolThread *thread = expiredThreads.dequeue();
+            Q_ASSERT(thread->runnable == nullptr);
+            ++activeThreads;
+            thread->start();
+        } else {
+            startThread();
+        }
+    } else {
+        saturated.storeRelaxed(true);
+    }
+}
+
+/*!
+    \internal
+
+    Removes \a runnable from the queue of the worker that started it.
+*/
+bool QThreadPoolPrivate::tryTakeFromWorkers(QRunnable *runnable)
+{
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        QWorkStealingQueue &localQueue = thread->localQueue;
+        if (!localQueue.contains(runnable))
+            continue;
+
+        if (thread == currentPoolThread) {
+            // the owner can pop down to it and push the others back
+            QVarLengthArray<QRunnable *, 16> popped;
+            QRunnable *r;
+            while ((r = localQueue.pop()) && r != runnable)
+                popped.append(r);
+            for (qsizetype i = popped.size() - 1; i >= 0; --i)
+                localQueue.push(popped.at(i));
+            if (r)
+                return true;
+        } else {
+            // others can only steal from the top; what they take on the way
+            // goes to the pool's queue, so it still runs
+            while (QRunnable *r = localQueue.steal()) {
+                if (r == runnable)
+                    return true;
+                enqueueTask(r);
+            }
+        }
+    }
+    return false;
+}
+
+void QThreadPoolPrivate::updateStealThreads()
+{
+    if (!workStealing)
+        return;
+
+    // readers don't take the mutex, so publish a new list and keep the old
+    // one until no thread is active
+    QList<QThreadPoolThread *> *threads = new QList<QThreadPoolThread *>;
+    threads->reserve(allThreads.size());
+    for (QThreadPoolThread *thread : qAsConst(allThreads))
+        threads->append(thread);
+    if (QList<QThreadPoolThread *> *old = stealThreads.fetchAndStoreRelease(threads))
+        retiredStealThreads.append(old);
+}
+
+/*!
+    \internal
+
+    Removes a thread from the waiting threads and returns it. In NUMA-aware
+    mode, a thread on the node of the calling thread is preferred.
+*/
+QThreadPoolThread *QThreadPoolPrivate::takeWaitingThread()
+{
+    Q_ASSERT(!waitingThreads.isEmpty());
+    int index = 0;
+    if (numaAware && QThread::numaNodeCount() > 1) {
+        const int node = currentNumaNode();
+        for (int i = 0; i < waitingThreads.size(); ++i) {
+            if (waitingThreads.at(i)->numaNode.loadRelaxed() == node) {
+                index = i;
+                break;
+            }
+        }
+    }
+    QThreadPoolThread *thread = waitingThreads.takeAt(index);
+    updateIdleThreads();
+    return thread;
+}
+
+static int numaNodeOfCpu(int cpu)
+{
+    static const QList<int> cpuNodes = [] {
+        QList<int> cpuNodes;
+        for (int node = 0; node < QThread::numaNodeCount(); ++node) {
+            const QList<int> cpus = QThread::numaNodeCpus(node);
+            for (int cpu : cpus) {
+                if (cpu >= cpuNodes.size())
+                    cpuNodes.resize(cpu + 1, -1);
+                cpuNodes[cpu] = node;
+            }
+        }
+        return cpuNodes;
+    }();
+    return cpuNodes.value(cpu, -1);
+}
+
+/*!
+    \internal
+
+    Returns the NUMA node the calling thread runs on, or -1 if unknown.
+*/
+int QThreadPoolPrivate::currentNumaNode() const
+{
+    if (currentPoolThread && currentPoolThread->manager == this) {
+        const int node = currentPoolThread->numaNode.loadRelaxed();
+        if (node >= 0)
+            return node;
+    }
+    return numaNodeOfCpu(QThreadPrivate::currentCpu());
+}
+
+/*!
+    \internal
+
+    Returns the node to place a new thread on: the node of the thread
+    starting it, so that it runs close to the data it was given, unless that
+    node already has a thread per processor; then the least loaded one.
+*/
+int QThreadPoolPrivate::pickNumaNode() const
+{
+    const int nodeCount = QThread::numaNodeCount();
+    if (nodeCount <= 1)
+        return 0;
+
+    QVarLengthArray<int, 8> load(nodeCount);
+    std::fill(load.begin(), load.end(), 0);
+    for (const QThreadPoolThread *thread : allThreads) {
+        const int node = thread->numaNode.loadRelaxed();
+        if (node >= 0 && node < nodeCount)
+            ++load[node];
+    }
+
+    const int current = currentNumaNode();
+    if (current >= 0 && current < nodeCount
+            && load[current] < QThread::numaNodeCpus(current).size()) {
+        return current;
+    }
+
+    int best = 0;
+    for (int node = 1; node < nodeCount; ++node) {
+        // compare the load relative to the size of the nodes
+        if (qint64(load[node]) * QThread::numaNodeCpus(best).size()
+                < qint64(load[best]) * QThread::numaNodeCpus(node).size()) {
+            best = node;
+        }
+    }
+    return best;
+}
+
+/*!
+    \internal
+
+    Assigns \a thread to \a node (or to no node if -1) and restricts it to
+    the processors it may run on.
+*/
+void QThreadPoolPrivate::placeThread(QThreadPoolThread *thread, int node)
+{
+    thread->numaNode.storeRelaxed(node);
+    QList<int> cpus = threadCpuAffinity;
+    if (node >= 0) {
+        const QList<int> nodeCpus = QThread::numaNodeCpus(node);
+        if (cpus.isEmpty()) {
+            cpus = nodeCpus;
+        } else {
+            QList<int> common;
+            for (int cpu : qAsConst(cpus)) {
+                if (nodeCpus.contains(cpu))
+                    common.append(cpu);
+            }
+            // rather ignore the node than the affinity set explicitly
+            if (!common.isEmpty())
+                cpus = common;
+        }
+    }
+    if (cpus != thread->cpuAffinity())
+        thread->setCpuAffinity(cpus);
 }
 
 /*!
@@ -379,6 +828,14 @@ bool QThreadPool::tryTake(QRunnable *runnable)
         }
     }
 
+    if (d->workStealing && d->tryTakeFromWorkers(runnable)) {
+        if (runnable->autoDelete()) {
+            Q_ASSERT(runnable->ref == 1);
+            --runnable->ref; // undo ++ref in start()
+        }
+        return true;
+    }
+
     return false;
 }
 
@@ -507,6 +964,17 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0) {
+        if (QThreadPoolThread *thread = d->currentWorker()) {
+            if (runnable->autoDelete()) {
+                Q_ASSERT(runnable->ref == 0);
+                ++runnable->ref;
+            }
+            d->startLocalTask(thread, runnable);
+            return;
+        }
+    }
+
     QMutexLocker locker(&d->mutex);
     if (runnable->autoDelete()) {
         Q_ASSERT(runnable->ref == 0);
@@ -517,7 +985,7 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         d->enqueueTask(runnable, priority);
 
         if (!d->waitingThreads.isEmpty())
-            d->waitingThreads.takeFirst()->runnableReady.wakeOne();
+            d->takeWaitingThread()->runnableReady.wakeOne();
     }
 }
 
@@ -657,6 +1125,7 @@ void QThreadPool::setMaxThreadCount(int maxThreadCount)
         return;
 
     d->maxThreadCount = maxThreadCount;
+    d->saturated.storeRelaxed(false);
     d->tryToStartMoreThreads();
 }
 
@@ -722,6 +1191,72 @@ uint QThreadPool::stackSize() const
     return d->stackSize;
 }
 
+/*! \property QThreadPool::threadCpuAffinity
+
+    This property holds the processors that the thread pool worker threads
+    are restricted to, as numbered by the operating system.
+
+    Changing it also applies to threads already created. The default value
+    is an empty list, which lets the threads run on any processor.
+
+    \since 6.0
+    \sa QThread::setCpuAffinity(), numaAware
+*/
+void QThreadPool::setThreadCpuAffinity(const QList<int> &cpus)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->threadCpuAffinity = cpus;
+    for (QThreadPoolThread *thread : qAsConst(d->allThreads))
+        d->placeThread(thread, thread->numaNode.loadRelaxed());
+}
+
+QList<int> QThreadPool::threadCpuAffinity() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->threadCpuAffinity;
+}
+
+/*! \property QThreadPool::numaAware
+
+    This property holds whether the thread pool places its worker threads
+    on NUMA nodes.
+
+    When enabled, each worker thread is restricted to the processors of one
+    node (within threadCpuAffinity, if set). A new thread is placed on the
+    node of the thread that starts it, so that it runs close to the memory
+    of the data passed to it, as long as that node has processors to spare.
+    Waking an idle thread for a runnable prefers one on the same node, and
+    so does stealing in work-stealing mode.
+
+    Changing it also applies to threads already created. The default value
+    is \c false. On systems with a single node, it only restricts the
+    threads to the processors of that node.
+
+    \since 6.0
+    \sa QThread::numaNodeCount(), threadCpuAffinity
+*/
+void QThreadPool::setNumaAware(bool enable)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    if (enable == d->numaAware)
+        return;
+    d->numaAware = enable;
+    for (QThreadPoolThread *thread : qAsConst(d->allThreads))
+        thread->numaNode.storeRelaxed(-1);
+    for (QThreadPoolThread *thread : qAsConst(d->allThreads))
+        d->placeThread(thread, enable ? d->pickNumaNode() : -1);
+}
+
+bool QThreadPool::isNumaAware() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->numaAware;
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -739,6 +1274,7 @@ void QThreadPool::releaseThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     --d->reservedThreads;
+    d->saturated.storeRelaxed(false);
     d->tryToStartMoreThreads();
 }
 
@@ -61,6 +61,8 @@ class Q_CORE_EXPORT QThreadPool : public QObject
     Q_PROPERTY(int maxThreadCount READ maxThreadCount WRITE setMaxThreadCount)
     Q_PROPERTY(int activeThreadCount READ activeThreadCount)
     Q_PROPERTY(uint stackSize READ stackSize WRITE setStackSize)
+    Q_PROPERTY(QList<int> threadCpuAffinity READ threadCpuAffinity WRITE setThreadCpuAffinity)
+    Q_PROPERTY(bool numaAware READ isNumaAware WRITE setNumaAware)
     friend class QFutureInterfaceBase;
 
 public:
@@ -86,6 +88,12 @@ public:
     void setStackSize(uint stackSize);
     uint stackSize() const;
 
+    void setThreadCpuAffinity(const QList<int> &cpus);
+    QList<int> threadCpuAffinity() const;
+
+    void setNumaAware(bool enable);
+    bool isNumaAware() const;
+
     void reserveThread();
     void releaseThread();
 
@@ -57,6 +57,7 @@
 #include "QtCore/qwaitcondition.h"
 #include "QtCore/qset.h"
 #include "QtCore/qqueue.h"
+#include "QtCore/qatomic.h"
 #include "private/qobject_p.h"
 
 QT_REQUIRE_CONFIG(thread);
@@ -146,6 +147,57 @@ private:
     QRunnable *m_entries[MaxPageSize];
 };
 
+/*
+    A worker's own queue in work-stealing mode: a Chase-Lev deque. Only the
+    owning thread pushes and pops, at the bottom; any thread can steal from
+    the top. Neither side takes a lock.
+*/
+class QWorkStealingQueue
+{
+    Q_DISABLE_COPY_MOVE(QWorkStealingQueue)
+public:
+    QWorkStealingQueue();
+    ~QWorkStealingQueue();
+
+    // owner only
+    void push(QRunnable *runnable);
+    QRunnable *pop();
+    bool isEmpty() const
+    {
+        return bottom.loadRelaxed() <= top.loadRelaxed();
+    }
+
+    // any thread
+    QRunnable *steal();
+    bool contains(const QRunnable *runnable) const;
+
+private:
+    struct Buffer {
+        Buffer(qint64 capacity, Buffer *previous)
+            : mask(capacity - 1), entries(new QAtomicPointer<QRunnable>[capacity]), previous(previous)
+        { }
+        ~Buffer()
+        {
+            delete[] entries;
+            delete previous;
+        }
+
+        QAtomicPointer<QRunnable> &at(qint64 i) const { return entries[i & mask]; }
+
+        const qint64 mask;
+        QAtomicPointer<QRunnable> *entries;
+        Buffer *previous; // kept alive for thieves still reading it
+    };
+
+    enum {
+        InitialCapacity = 64
+    };
+
+    alignas(64) QAtomicInteger<qint64> top;
+    alignas(64) QAtomicInteger<qint64> bottom;
+    QAtomicPointer<Buffer> buffer;
+};
+
 class QThreadPoolThread;
 class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 {
@@ -154,6 +206,7 @@ class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 
 public:
     QThreadPoolPrivate();
+    ~QThreadPoolPrivate();
 
     bool tryStart(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
@@ -170,6 +223,21 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    QRunnable *takeTask(QThreadPoolThread *thread);
+    QRunnable *takeTaskUnlocked(QThreadPoolThread *thread);
+    QRunnable *stealTask(QThreadPoolThread *thread);
+    QThreadPoolThread *currentWorker() const;
+    void startLocalTask(QThreadPoolThread *thread, QRunnable *runnable);
+    void startThief();
+    bool tryTakeFromWorkers(QRunnable *runnable);
+    void updateStealThreads();
+    void updateIdleThreads() { idleThreads.storeRelaxed(waitingThreads.count()); }
+
+    QThreadPoolThread *takeWaitingThread();
+    int currentNumaNode() const;
+    int pickNumaNode() const;
+    void placeThread(QThreadPoolThread *thread, int node);
+
     mutable QMutex mutex;
     QSet<QThreadPoolThread *> allThreads;
     QQueue<QThreadPoolThread *> waitingThreads;
@@ -182,6 +250,21 @@ public:
     int reservedThreads = 0;
     int activeThreads = 0;
     uint stackSize = 0;
+
+    // CPU placement: every thread is restricted to threadCpuAffinity (if
+    // set) and, in NUMA-aware mode, to the processors of its node.
+    QList<int> threadCpuAffinity;
+    bool numaAware = false;
+
+    // Work-stealing mode (QT_THREADPOOL_WORK_STEALING=1): runnables started
+    // with the default priority from a worker go to that worker's own queue,
+    // and idle workers steal from the others without taking the mutex.
+    const bool workStealing;
+    QAtomicPointer<QList<QThreadPoolThread *>> stealThreads;
+    QList<QList<QThreadPoolThread *> *> retiredStealThreads;
+    QAtomicInt idleThreads;         // waitingThreads.count()
+    QAtomicInt saturated;           // no thread to wake or start for stealing
+    QAtomicInt highPriorityQueued;  // queue may hold tasks that go before local ones
 };
 
 QT_END_NAMESPACE
@@ -27,6 +27,7 @@ qtConfig(thread) {
         thread/qatomic_bootstrap.h \
         thread/qatomic_cxx11.h \
         thread/qbasicatomic.h \
+        thread/qconcurrentqueue.h \
         thread/qfutex_p.h \
         thread/qgenericatomic.h \
         thread/qlocking_p.h \
@@ -40,6 +41,7 @@ qtConfig(thread) {
 
     SOURCES += \
        thread/qatomic.cpp \
+       thread/qconcurrentqueue.cpp \
        thread/qmutex.cpp \
        thread/qreadwritelock.cpp \
        thread/qsemaphore.cpp \
@@ -66,6 +68,7 @@ qtConfig(future) {
     HEADERS += \
         thread/qexception.h \
         thread/qfuture.h \
+        thread/qfuture_coroutine.h \
         thread/qfuture_impl.h \
         thread/qfutureinterface.h \
         thread/qfutureinterface_p.h \
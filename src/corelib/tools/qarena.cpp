@@ -0,0 +1,278 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qarena.h"
+
+#include <limits>
+
+#include <stdlib.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QArena
+    \inmodule QtCore
+    \since 6.0
+    \brief The QArena class provides a monotonic memory arena for Qt containers.
+
+    \ingroup tools
+
+    \reentrant
+
+    A QArena hands out memory from large blocks by simply bumping a
+    pointer, and frees all of it at once when reset() is called or the
+    arena is destroyed. This makes allocating very cheap, at the price of
+    never reusing memory before the reset.
+
+    Code that creates many short-lived containers, for instance while
+    handling one request of a server, can create the containers with
+    string(), byteArray(), list(), hash() and set() to make them take
+    their memory from an arena:
+
+    \snippet code/src_corelib_tools_qarena.cpp 0
+
+    Only the containers created this way use the arena; all other
+    containers, including those created by Qt while the arena is in use,
+    keep using the heap. When a container of the arena grows, the new
+    memory comes from the same arena. Copies of its data, which are made
+    when an implicitly shared copy of the container is modified and when
+    a QList of a type that is not relocatable grows, are allocated on the
+    heap. Freeing memory of an arena does nothing; it is only reclaimed by
+    reset().
+
+    \warning All containers that use memory from an arena, including
+    implicitly shared copies of them, must be destroyed before the arena
+    is reset or destroyed. Do not store such containers in places that
+    outlive the arena.
+
+    QArena is not thread-safe: an arena must only be used by one thread
+    at a time, and so must the containers created with it.
+*/
+
+struct QArena::Block
+{
+    Block *next;
+    qsizetype size;
+};
+
+enum { MaximumBlockSize = 1024 * 1024 };
+
+/*!
+    Constructs an empty arena that allocates memory in blocks of
+    initially \a blockSize bytes. The size of the blocks doubles with
+    every new block, up to 1MB.
+
+    No memory is allocated until the first call to allocate().
+*/
+QArena::QArena(qsizetype blockSize)
+    : nextBlockSize(qMax(blockSize, qsizetype(sizeof(Block))))
+{
+}
+
+/*!
+    Destroys the arena and frees all its memory.
+
+    \sa reset()
+*/
+QArena::~QArena()
+{
+    while (head) {
+        Block *next = head->next;
+        ::free(head);
+        head = next;
+    }
+}
+
+/*!
+    \fn void *QArena::allocate(size_t size, size_t alignment)
+
+    Returns a pointer to \a size bytes of memory aligned to \a alignment,
+    which must be a power of two, or \nullptr if no memory could be
+    allocated. The memory stays valid until the arena is reset or
+    destroyed.
+*/
+
+void *QArena::allocateInNewBlock(size_t size, size_t alignment) noexcept
+{
+    const size_t needed = sizeof(Block) + alignment - 1 + size;
+    if (needed < size || needed > size_t(std::numeric_limits<qsizetype>::max()))
+        return nullptr;
+    const qsizetype blockSize = qMax(nextBlockSize, qsizetype(needed));
+    Block *block = static_cast<Block *>(::malloc(blockSize));
+    if (!block)
+        return nullptr;
+    block->size = blockSize;
+    ++blocks;
+    if (nextBlockSize < MaximumBlockSize)
+        nextBlockSize = qMin(2 * nextBlockSize, qsizetype(MaximumBlockSize));
+
+    char *blockBegin = reinterpret_cast<char *>(block + 1);
+    char *blockEnd = reinterpret_cast<char *>(block) + blockSize;
+    if (!head || (blockEnd - blockBegin) - qsizetype(size) > end - pos) {
+        // continue in the new block if it has more space left than the
+        // current one
+        block->next = head;
+        head = block;
+        pos = blockBegin;
+        end = blockEnd;
+        return allocate(size, alignment);
+    }
+
+    // an oversized allocation: keep the current block for the following ones
+    block->next = head->next;
+    head->next = block;
+    const quintptr p = (quintptr(blockBegin) + alignment - 1) & ~quintptr(alignment - 1);
+    ++allocations;
+    bytes += size;
+    return reinterpret_cast<void *>(p);
+}
+
+/*!
+    Frees all memory allocated from the arena, except for the block that
+    is currently being filled, which is reused by the following calls to
+    allocate().
+
+    \sa allocate()
+*/
+void QArena::reset() noexcept
+{
+    if (head) {
+        Block *b = head->next;
+        while (b) {
+            Block *next = b->next;
+            ::free(b);
+            b = next;
+        }
+        head->next = nullptr;
+        pos = reinterpret_cast<char *>(head + 1);
+        blocks = 1;
+    }
+    allocations = 0;
+    bytes = 0;
+}
+
+/*!
+    \fn qsizetype QArena::allocationCount() const
+
+    Returns the number of allocations made from the arena since it was
+    created or last reset.
+
+    \sa blockCount(), bytesAllocated()
+*/
+
+/*!
+    \fn qsizetype QArena::bytesAllocated() const
+
+    Returns the number of bytes allocated from the arena since it was
+    created or last reset, not counting padding for alignment.
+
+    \sa allocationCount()
+*/
+
+/*!
+    \fn qsizetype QArena::blockCount() const
+
+    Returns the number of memory blocks the arena currently holds, that
+    is, the number of heap allocations it made since it was last reset
+    plus one for the block it keeps across resets.
+
+    \sa allocationCount()
+*/
+
+/*!
+    Returns an empty string whose memory for \a capacity characters is
+    allocated from this arena.
+
+    \sa byteArray(), list()
+*/
+QString QArena::string(qsizetype capacity)
+{
+    Q_ASSERT(capacity >= 0);
+    auto data = QTypedArrayData<char16_t>::allocate(size_t(capacity) + 1,
+                                                    QArrayData::DefaultAllocationFlags, this);
+    Q_CHECK_PTR(data.second);
+    data.second[0] = u'\0';
+    return QString(QString::DataPointer(data));
+}
+
+/*!
+    Returns an empty byte array whose memory for \a capacity bytes is
+    allocated from this arena.
+
+    \sa string(), list()
+*/
+QByteArray QArena::byteArray(qsizetype capacity)
+{
+    Q_ASSERT(capacity >= 0);
+    auto data = QTypedArrayData<char>::allocate(size_t(capacity) + 1,
+                                                QArrayData::DefaultAllocationFlags, this);
+    Q_CHECK_PTR(data.second);
+    data.second[0] = '\0';
+    return QByteArray(QByteArray::DataPointer(data));
+}
+
+/*!
+    \fn template <typename T> QList<T> QArena::list(qsizetype capacity)
+
+    Returns an empty list whose memory for \a capacity elements, but at
+    least one, is allocated from this arena.
+
+    \sa string(), byteArray()
+*/
+
+/*!
+    \fn template <typename Key, typename T> QHash<Key, T> QArena::hash(qsizetype capacity)
+
+    Returns an empty hash whose buckets and nodes are allocated from this
+    arena. The hash is prepared for \a capacity items.
+
+    \sa set()
+*/
+
+/*!
+    \fn template <typename T> QSet<T> QArena::set(qsizetype capacity)
+
+    Returns an empty set whose buckets and nodes are allocated from this
+    arena. The set is prepared for \a capacity items.
+
+    \sa hash()
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QARENA_H
+#define QARENA_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstring.h>
+
+#include <cstddef>
+
+QT_BEGIN_NAMESPACE
+
+
+class Q_CORE_EXPORT QArena
+{
+public:
+    explicit QArena(qsizetype blockSize = 4096);
+    ~QArena();
+
+    Q_REQUIRED_RESULT void *allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept
+    {
+        Q_ASSERT(alignment && !(alignment & (alignment - 1)));
+        const quintptr p = (quintptr(pos) + alignment - 1) & ~quintptr(alignment - 1);
+        if (Q_LIKELY(pos && p + size <= quintptr(end))) {
+            pos = reinterpret_cast<char *>(p + size);
+            ++allocations;
+            bytes += size;
+            return reinterpret_cast<void *>(p);
+        }
+        return allocateInNewBlock(size, alignment);
+    }
+    void reset() noexcept;
+
+    qsizetype allocationCount() const noexcept { return allocations; }
+    qsizetype bytesAllocated() const noexcept { return bytes; }
+    qsizetype blockCount() const noexcept { return blocks; }
+
+    QString string(qsizetype capacity);
+    QByteArray byteArray(qsizetype capacity);
+    template <typename T>
+    QList<T> list(qsizetype capacity);
+    template <typename Key, typename T>
+    QHash<Key, T> hash(qsizetype capacity = 0);
+    template <typename T>
+    QSet<T> set(qsizetype capacity = 0);
+
+private:
+    Q_DISABLE_COPY(QArena)
+
+    struct Block;
+    void *allocateInNewBlock(size_t size, size_t alignment) noexcept;
+
+    Block *head = nullptr;
+    char *pos = nullptr;
+    char *end = nullptr;
+    qsizetype nextBlockSize;
+    qsizetype allocations = 0;
+    qsizetype bytes = 0;
+    qsizetype blocks = 0;
+};
+
+template <typename T>
+QList<T> QArena::list(qsizetype capacity)
+{
+    // even an empty list needs its data in the arena, to grow in it later
+    auto data = QTypedArrayData<T>::allocate(size_t(qMax(capacity, qsizetype(1))),
+                                             QArrayData::DefaultAllocationFlags, this);
+    Q_CHECK_PTR(data.first);
+    return QList<T>(QArrayDataPointer<T>(data));
+}
+
+template <typename Key, typename T>
+QHash<Key, T> QArena::hash(qsizetype capacity)
+{
+    using Data = typename QHash<Key, T>::Data;
+    QHash<Key, T> result;
+    result.d = new (this) Data(size_t(capacity), this);
+    return result;
+}
+
+template <typename T>
+QSet<T> QArena::set(qsizetype capacity)
+{
+    QSet<T> result;
+    result.q_hash = hash<T, QHashDummyValue>(capacity);
+    return result;
+}
+
+QT_END_NAMESPACE
+
+#endif // QARENA_H
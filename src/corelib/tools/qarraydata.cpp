@@ -39,6 +39,7 @@
 ****************************************************************************/
 
 #include <QtCore/qarraydata.h>
+#include <QtCore/qarena.h>
 #include <QtCore/private/qnumeric_p.h>
 #include <QtCore/private/qtools_p.h>
 #include <QtCore/qmath.h>
@@ -179,9 +180,32 @@ static inline size_t calculateBlockSize(size_t &capacity, size_t objectSize, siz
     }
 }
 
-static QArrayData *allocateData(size_t allocSize, uint options)
+// Data allocated from an arena is preceded by a pointer to the arena, so
+// that it can grow in the same arena
+static_assert(sizeof(QArena *) % alignof(QArrayData) == 0);
+
+static QArena *arenaOf(const QArrayData *header) noexcept
+{
+    Q_ASSERT(header->flags & QArrayData::ArenaAllocated);
+    return reinterpret_cast<QArena *const *>(header)[-1];
+}
+
+static QArrayData *allocateData(size_t allocSize, uint options, QArena *arena = nullptr)
 {
-    QArrayData *header = static_cast<QArrayData *>(::malloc(allocSize));
+    QArrayData *header = nullptr;
+    options &= ~QArrayData::ArenaAllocated;
+    if (arena) {
+        if (allocSize <= size_t(MaxAllocSize) - sizeof(QArena *)) {
+            void *p = arena->allocate(sizeof(QArena *) + allocSize, alignof(QArrayData));
+            if (p) {
+                *static_cast<QArena **>(p) = arena;
+                header = reinterpret_cast<QArrayData *>(static_cast<QArena **>(p) + 1);
+                options |= QArrayData::ArenaAllocated;
+            }
+        }
+    } else {
+        header = static_cast<QArrayData *>(::malloc(allocSize));
+    }
     if (header) {
         header->ref_.storeRelaxed(1);
         header->flags = options;
@@ -190,16 +214,40 @@ static QArrayData *allocateData(size_t allocSize, uint options)
     return header;
 }
 
-static QArrayData *reallocateData(QArrayData *header, size_t allocSize, uint options)
+static QArrayData *reallocateData(QArrayData *header, size_t oldSize, size_t allocSize, uint options)
 {
+    if (header->flags & QArrayData::ArenaAllocated) {
+        // memory from an arena can't grow in place, so copy it into a new
+        // block from the same arena
+        QArrayData *newHeader = allocateData(allocSize, options, arenaOf(header));
+        if (newHeader) {
+            const uint flags = newHeader->flags;
+            ::memcpy(static_cast<void *>(newHeader), header, qMin(oldSize, allocSize));
+            newHeader->flags = flags;
+        }
+        return newHeader;
+    }
     header = static_cast<QArrayData *>(::realloc(header, allocSize));
     if (header)
-        header->flags = options;
+        header->flags = options & ~QArrayData::ArenaAllocated;
     return header;
 }
 
 void *QArrayData::allocate(QArrayData **dptr, size_t objectSize, size_t alignment,
         size_t capacity, ArrayOptions options) noexcept
+{
+    return allocate(dptr, objectSize, alignment, capacity, options, nullptr);
+}
+
+/*!
+    \internal
+
+    Allocates the data like the overload without \a arena does, but from
+    \a arena if it is not \nullptr. Growing the data later, with
+    reallocateUnaligned(), allocates from the same arena.
+*/
+void *QArrayData::allocate(QArrayData **dptr, size_t objectSize, size_t alignment,
+        size_t capacity, ArrayOptions options, QArena *arena) noexcept
 {
     Q_ASSERT(dptr);
     // Alignment is a power of two
@@ -227,7 +275,7 @@ void *QArrayData::allocate(QArrayData **dptr, size_t objectSize, size_t alignmen
     size_t allocSize = calculateBlockSize(capacity, objectSize, headerSize, options);
     options |= AllocatedDataType | MutableData;
     options &= ~ImmutableHeader;
-    QArrayData *header = allocateData(allocSize, options);
+    QArrayData *header = allocateData(allocSize, options, arena);
     quintptr data = 0;
     if (header) {
         // find where offset should point to so that data() is aligned to alignment bytes
@@ -259,8 +307,9 @@ QArrayData::reallocateUnaligned(QArrayData *data, void *dataPointer,
     size_t headerSize = sizeof(QArrayData);
     size_t allocSize = calculateBlockSize(capacity, objectSize, headerSize, options);
     qptrdiff offset = reinterpret_cast<char *>(dataPointer) - reinterpret_cast<char *>(data);
+    size_t oldSize = headerSize + data->alloc * objectSize;
     options |= AllocatedDataType | MutableData;
-    QArrayData *header = reallocateData(data, allocSize, options);
+    QArrayData *header = reallocateData(data, oldSize, allocSize, options);
     if (header) {
         header->alloc = uint(capacity);
         dataPointer = reinterpret_cast<char *>(header) + offset;
@@ -278,6 +327,8 @@ void QArrayData::deallocate(QArrayData *data, size_t objectSize,
 
     Q_ASSERT_X(data == nullptr || !data->isStatic(), "QArrayData::deallocate",
                "Static data cannot be deleted");
+    if (data && data->flags & ArenaAllocated)
+        return;         // freed when the arena is reset
     ::free(data);
 }
 
@@ -47,6 +47,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QArena;
 template <class T> struct QTypedArrayData;
 
 struct Q_CORE_EXPORT QArrayData
@@ -61,6 +62,7 @@ struct Q_CORE_EXPORT QArrayData
         GrowsBackwards       = 0x0040,  //!< allocate with eyes towards growing through prepend()
         MutableData          = 0x0080,  //!< the data can be changed; doesn't say anything about the header
         ImmutableHeader      = 0x0100,  //!< the header is static, it can't be changed
+        ArenaAllocated       = 0x0200,  //!< the memory is owned by a QArena, it must not be freed
 
         /// this option is used by the Q_ARRAY_LITERAL and similar macros
         StaticDataFlags = RawDataType | ImmutableHeader,
@@ -157,6 +159,8 @@ struct Q_CORE_EXPORT QArrayData
 #endif
     static void *allocate(QArrayData **pdata, size_t objectSize, size_t alignment,
             size_t capacity, ArrayOptions options = DefaultAllocationFlags) noexcept;
+    Q_REQUIRED_RESULT static void *allocate(QArrayData **pdata, size_t objectSize, size_t alignment,
+            size_t capacity, ArrayOptions options, QArena *arena) noexcept;
     Q_REQUIRED_RESULT static QArrayData *reallocateUnaligned(QArrayData *data, size_t objectSize,
             size_t newCapacity, ArrayOptions newOptions = DefaultAllocationFlags) noexcept;
     Q_REQUIRED_RESULT static QPair<QArrayData *, void *> reallocateUnaligned(QArrayData *data, void *dataPointer,
@@ -215,6 +219,18 @@ struct QTypedArrayData
         return qMakePair(static_cast<QTypedArrayData *>(d), static_cast<T *>(result));
     }
 
+    Q_REQUIRED_RESULT static QPair<QTypedArrayData *, T *> allocate(size_t capacity,
+            ArrayOptions options, QArena *arena)
+    {
+        static_assert(sizeof(QTypedArrayData) == sizeof(QArrayData));
+        QArrayData *d;
+        void *result = QArrayData::allocate(&d, sizeof(T), alignof(AlignmentDummy), capacity, options, arena);
+#if (defined(Q_CC_GNU) && Q_CC_GNU >= 407) || QT_HAS_BUILTIN(__builtin_assume_aligned)
+        result = __builtin_assume_aligned(result, Q_ALIGNOF(AlignmentDummy));
+#endif
+        return qMakePair(static_cast<QTypedArrayData *>(d), static_cast<T *>(result));
+    }
+
     static QPair<QTypedArrayData *, T *>
     reallocateUnaligned(QTypedArrayData *data, T *dataPointer, size_t capacity,
             ArrayOptions options = DefaultAllocationFlags)
@@ -43,6 +43,7 @@
 #include <qdatastream.h>
 #include <qdebug.h>
 #include <qendian.h>
+#include <private/qsimd_p.h>
 #include <string.h>
 
 QT_BEGIN_NAMESPACE
@@ -110,6 +111,170 @@ QT_BEGIN_NAMESPACE
     \sa QByteArray, QList
 */
 
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(AVX2) && !defined(QT_BOOTSTRAPPED)
+#  define BITARRAY_AVX2
+#endif
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(SSE4_2) && !defined(__POPCNT__) \
+    && !defined(QT_BOOTSTRAPPED)
+// all processors that support SSE4.2 support POPCNT
+#  define BITARRAY_POPCNT
+#endif
+
+// The bulk operations below combine the bits of two arrays 32, 16 or 8 bytes
+// at a time. Each operation is a function object that can be applied to
+// every vector type we use.
+namespace {
+struct AndOp
+{
+    quint64 operator()(quint64 a, quint64 b) const noexcept { return a & b; }
+#if defined(__SSE2__)
+    __m128i operator()(__m128i a, __m128i b) const noexcept { return _mm_and_si128(a, b); }
+#elif defined(__ARM_NEON__)
+    uint8x16_t operator()(uint8x16_t a, uint8x16_t b) const noexcept { return vandq_u8(a, b); }
+#endif
+#if defined(BITARRAY_AVX2)
+    QT_FUNCTION_TARGET(AVX2) __m256i operator()(__m256i a, __m256i b) const noexcept
+    { return _mm256_and_si256(a, b); }
+#endif
+};
+
+struct OrOp
+{
+    quint64 operator()(quint64 a, quint64 b) const noexcept { return a | b; }
+#if defined(__SSE2__)
+    __m128i operator()(__m128i a, __m128i b) const noexcept { return _mm_or_si128(a, b); }
+#elif defined(__ARM_NEON__)
+    uint8x16_t operator()(uint8x16_t a, uint8x16_t b) const noexcept { return vorrq_u8(a, b); }
+#endif
+#if defined(BITARRAY_AVX2)
+    QT_FUNCTION_TARGET(AVX2) __m256i operator()(__m256i a, __m256i b) const noexcept
+    { return _mm256_or_si256(a, b); }
+#endif
+};
+
+struct XorOp
+{
+    quint64 operator()(quint64 a, quint64 b) const noexcept { return a ^ b; }
+#if defined(__SSE2__)
+    __m128i operator()(__m128i a, __m128i b) const noexcept { return _mm_xor_si128(a, b); }
+#elif defined(__ARM_NEON__)
+    uint8x16_t operator()(uint8x16_t a, uint8x16_t b) const noexcept { return veorq_u8(a, b); }
+#endif
+#if defined(BITARRAY_AVX2)
+    QT_FUNCTION_TARGET(AVX2) __m256i operator()(__m256i a, __m256i b) const noexcept
+    { return _mm256_xor_si256(a, b); }
+#endif
+};
+} // unnamed namespace
+
+#if defined(BITARRAY_AVX2)
+template <typename Op>
+static QT_FUNCTION_TARGET(AVX2) qsizetype bitwiseOperationAvx2(uchar *dst, const uchar *src,
+                                                               qsizetype n, Op op) noexcept
+{
+    qsizetype i = 0;
+    for ( ; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), op(a, b));
+    }
+    return i;
+}
+#endif
+
+// dst[i] = op(dst[i], src[i]) for the first n bytes
+template <typename Op>
+static void bitwiseOperation(uchar *dst, const uchar *src, qsizetype n, Op op) noexcept
+{
+    qsizetype i = 0;
+#if defined(BITARRAY_AVX2)
+    if (n >= 32 && qCpuHasFeature(AVX2))
+        i = bitwiseOperationAvx2(dst, src, n, op);
+#endif
+#if defined(__SSE2__)
+    for ( ; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), op(a, b));
+    }
+#elif defined(__ARM_NEON__)
+    for ( ; i + 16 <= n; i += 16)
+        vst1q_u8(dst + i, op(vld1q_u8(dst + i), vld1q_u8(src + i)));
+#endif
+    for ( ; i + 8 <= n; i += 8)
+        qToUnaligned(op(qFromUnaligned<quint64>(dst + i), qFromUnaligned<quint64>(src + i)), dst + i);
+    for ( ; i < n; ++i)
+        dst[i] = uchar(op(quint64(dst[i]), quint64(src[i])));
+}
+
+static inline int countBits(const uchar *bits, const uchar *end) noexcept
+{
+    int numBits = 0;
+
+    // the loops below will try to read from *end
+    // it's the QByteArray implicit NUL, so it will not change the bit count
+    while (bits + 7 <= end) {
+        quint64 v = qFromUnaligned<quint64>(bits);
+        bits += 8;
+        numBits += int(qPopulationCount(v));
+    }
+    if (bits + 3 <= end) {
+        quint32 v = qFromUnaligned<quint32>(bits);
+        bits += 4;
+        numBits += int(qPopulationCount(v));
+    }
+    if (bits + 1 < end) {
+        quint16 v = qFromUnaligned<quint16>(bits);
+        bits += 2;
+        numBits += int(qPopulationCount(v));
+    }
+    if (bits < end)
+        numBits += int(qPopulationCount(bits[0]));
+    return numBits;
+}
+
+#if defined(BITARRAY_POPCNT)
+static QT_FUNCTION_TARGET(POPCNT) int countBitsPopcnt(const uchar *bits, const uchar *end) noexcept
+{
+    int numBits = 0;
+#  if defined(Q_PROCESSOR_X86_64)
+    for ( ; bits + 8 <= end; bits += 8)
+        numBits += int(_mm_popcnt_u64(qFromUnaligned<quint64>(bits)));
+#  endif
+    for ( ; bits + 4 <= end; bits += 4)
+        numBits += _mm_popcnt_u32(qFromUnaligned<quint32>(bits));
+    for ( ; bits < end; ++bits)
+        numBits += _mm_popcnt_u32(*bits);
+    return numBits;
+}
+#endif
+
+// Returns the index of the first bit at or after \a from that is set in
+// bits ^ invert, or -1 if there is none.
+static int findNextBit(const uchar *bits, int size, int from, quint64 invert) noexcept
+{
+    const qsizetype byteCount = (size + 7) / 8;
+    for (qsizetype byte = from / 8; byte < byteCount; byte += 8) {
+        quint64 word;
+        if (byte + 8 <= byteCount) {
+            word = qFromLittleEndian<quint64>(bits + byte);
+        } else {
+            // don't read past the end of the array
+            word = 0;
+            for (qsizetype i = byte; i < byteCount; ++i)
+                word |= quint64(bits[i]) << (8 * (i - byte));
+        }
+        word ^= invert;
+        if (byte == from / 8)
+            word &= ~quint64(0) << (from % 8);
+        if (word) {
+            const int found = int(byte * 8 + qCountTrailingZeroBits(word));
+            return found < size ? found : -1;
+        }
+    }
+    return -1;
+}
+
 /*!
     \fn QBitArray::QBitArray(QBitArray &&other)
 
@@ -177,32 +342,52 @@ QBitArray::QBitArray(int size, bool value)
 */
 int QBitArray::count(bool on) const
 {
-    int numBits = 0;
-    const quint8 *bits = reinterpret_cast<const quint8 *>(d.data()) + 1;
+    const uchar *bits = reinterpret_cast<const uchar *>(d.data()) + 1;
+    const uchar *const end = reinterpret_cast<const uchar *>(d.end());
+    int numBits;
+#if defined(BITARRAY_POPCNT)
+    if (qCpuHasFeature(POPCNT))
+        numBits = countBitsPopcnt(bits, end);
+    else
+#endif
+        numBits = countBits(bits, end);
+    return on ? numBits : size() - numBits;
+}
 
-    // the loops below will try to read from *end
-    // it's the QByteArray implicit NUL, so it will not change the bit count
-    const quint8 *const end = reinterpret_cast<const quint8 *>(d.end());
+/*!
+    \since 6.0
 
-    while (bits + 7 <= end) {
-        quint64 v = qFromUnaligned<quint64>(bits);
-        bits += 8;
-        numBits += int(qPopulationCount(v));
-    }
-    if (bits + 3 <= end) {
-        quint32 v = qFromUnaligned<quint32>(bits);
-        bits += 4;
-        numBits += int(qPopulationCount(v));
-    }
-    if (bits + 1 < end) {
-        quint16 v = qFromUnaligned<quint16>(bits);
-        bits += 2;
-        numBits += int(qPopulationCount(v));
-    }
-    if (bits < end)
-        numBits += int(qPopulationCount(bits[0]));
+    Returns the index of the first 1-bit at or after index position
+    \a from, or -1 if there is none. The bit array is scanned 64 bits at
+    a time, so this is a fast way to iterate over the set bits of a sparse
+    bit array:
 
-    return on ? numBits : size() - numBits;
+    \snippet code/src_corelib_tools_qbitarray.cpp 16
+
+    \sa findNextClearBit(), count()
+*/
+int QBitArray::findNextSetBit(int from) const
+{
+    Q_ASSERT(from >= 0);
+    if (from >= size())
+        return -1;
+    return findNextBit(reinterpret_cast<const uchar *>(d.constData()) + 1, size(), from, 0);
+}
+
+/*!
+    \since 6.0
+
+    Returns the index of the first 0-bit at or after index position
+    \a from, or -1 if there is none.
+
+    \sa findNextSetBit(), count()
+*/
+int QBitArray::findNextClearBit(int from) const
+{
+    Q_ASSERT(from >= 0);
+    if (from >= size())
+        return -1;
+    return findNextBit(reinterpret_cast<const uchar *>(d.constData()) + 1, size(), from, ~quint64(0));
 }
 
 /*!
@@ -567,12 +752,10 @@ QBitArray &QBitArray::operator&=(const QBitArray &other)
     resize(qMax(size(), other.size()));
     uchar *a1 = reinterpret_cast<uchar*>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar*>(other.d.constData()) + 1;
-    int n = other.d.size() -1 ;
-    int p = d.size() - 1 - n;
-    while (n-- > 0)
-        *a1++ &= *a2++;
-    while (p-- > 0)
-        *a1++ = 0;
+    const qsizetype n = qMax(other.d.size() - 1, 0);
+    bitwiseOperation(a1, a2, n, AndOp());
+    if (d.size() - 1 > n)
+        memset(a1 + n, 0, d.size() - 1 - n);
     return *this;
 }
 
@@ -596,9 +779,7 @@ QBitArray &QBitArray::operator|=(const QBitArray &other)
     resize(qMax(size(), other.size()));
     uchar *a1 = reinterpret_cast<uchar*>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
-    int n = other.d.size() - 1;
-    while (n-- > 0)
-        *a1++ |= *a2++;
+    bitwiseOperation(a1, a2, qMax(other.d.size() - 1, 0), OrOp());
     return *this;
 }
 
@@ -622,9 +803,7 @@ QBitArray &QBitArray::operator^=(const QBitArray &other)
     resize(qMax(size(), other.size()));
     uchar *a1 = reinterpret_cast<uchar*>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
-    int n = other.d.size() - 1;
-    while (n-- > 0)
-        *a1++ ^= *a2++;
+    bitwiseOperation(a1, a2, qMax(other.d.size() - 1, 0), XorOp());
     return *this;
 }
 
@@ -640,17 +819,13 @@ QBitArray &QBitArray::operator^=(const QBitArray &other)
 
 QBitArray QBitArray::operator~() const
 {
-    int sz = size();
-    QBitArray a(sz);
-    const uchar *a1 = reinterpret_cast<const uchar *>(d.constData()) + 1;
-    uchar *a2 = reinterpret_cast<uchar*>(a.d.data()) + 1;
-    int n = d.size() - 1;
-
-    while (n-- > 0)
-        *a2++ = ~*a1++;
-
-    if (sz && sz%8)
-        *(a2-1) &= (1 << (sz%8)) - 1;
+    // all bits set, apart from the ones past the end
+    QBitArray a(size(), true);
+    if (!isEmpty()) {
+        bitwiseOperation(reinterpret_cast<uchar *>(a.d.data()) + 1,
+                         reinterpret_cast<const uchar *>(d.constData()) + 1,
+                         d.size() - 1, XorOp());
+    }
     return a;
 }
 
@@ -67,6 +67,8 @@ public:
     inline int size() const { return (d.size() << 3) - *d.constData(); }
     inline int count() const { return (d.size() << 3) - *d.constData(); }
     int count(bool on) const;
+    int findNextSetBit(int from = 0) const;
+    int findNextClearBit(int from = 0) const;
 
     inline bool isEmpty() const { return d.isEmpty(); }
     inline bool isNull() const { return d.isNull(); }
@@ -0,0 +1,364 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QCONCURRENTCACHE_H
+#define QCONCURRENTCACHE_H
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qreadwritelock.h>
+#include <QtCore/qsharedpointer.h>
+
+QT_BEGIN_NAMESPACE
+
+
+template <class Key, class T>
+class QConcurrentCache
+{
+    // A Slot holds one cached object. The slots of a Shard form the ring that
+    // the CLOCK hand sweeps over when it needs to evict an object: a slot that
+    // was accessed since the hand passed it last gets a second chance.
+    struct Slot {
+        Key key;
+        QSharedPointer<T> object;
+        int cost = 0;
+        mutable QAtomicInt referenced;
+
+        Slot(const Key &k, const QSharedPointer<T> &o, int c)
+            : key(k), object(o), cost(c), referenced(1)
+        {}
+        Slot(const Slot &other)
+            : key(other.key), object(other.object), cost(other.cost),
+              referenced(other.referenced.loadRelaxed())
+        {}
+        Slot &operator=(const Slot &other)
+        {
+            key = other.key;
+            object = other.object;
+            cost = other.cost;
+            referenced.storeRelaxed(other.referenced.loadRelaxed());
+            return *this;
+        }
+        Slot(Slot &&other) noexcept
+            : key(std::move(other.key)), object(std::move(other.object)), cost(other.cost),
+              referenced(other.referenced.loadRelaxed())
+        {}
+        Slot &operator=(Slot &&other) noexcept
+        {
+            key = std::move(other.key);
+            object = std::move(other.object);
+            cost = other.cost;
+            referenced.storeRelaxed(other.referenced.loadRelaxed());
+            return *this;
+        }
+
+        void markReferenced() const noexcept
+        {
+            // avoid dirtying the cache line if the bit is already set
+            if (!referenced.loadRelaxed())
+                referenced.storeRelaxed(1);
+        }
+    };
+
+    // Each Shard owns the objects whose keys hash to it. Lookups only take the
+    // read lock of their shard, modifications the write lock.
+    struct alignas(64) Shard {
+        mutable QReadWriteLock lock;
+        QHash<Key, qsizetype> index;
+        QList<Slot> ring;
+        qsizetype hand = 0;
+        int cost = 0;
+
+        mutable QAtomicInteger<quint64> hits;
+        mutable QAtomicInteger<quint64> misses;
+        QAtomicInteger<quint64> insertions;
+        QAtomicInteger<quint64> evictions;
+
+        void removeAt(qsizetype i)
+        {
+            Q_ASSERT(i < ring.size());
+            cost -= ring.at(i).cost;
+            index.remove(ring.at(i).key);
+            const qsizetype last = ring.size() - 1;
+            if (i != last) {
+                ring[i] = std::move(ring[last]);
+                index[ring.at(i).key] = i;
+            }
+            ring.removeLast();
+        }
+
+        // Returns the cost of the evicted object, or -1 if the shard is empty
+        int evictOne()
+        {
+            if (ring.isEmpty())
+                return -1;
+            // terminates after at most two sweeps, as the first one clears
+            // all the referenced bits
+            for (;;) {
+                if (hand >= ring.size())
+                    hand = 0;
+                const Slot &slot = ring.at(hand);
+                if (slot.referenced.loadRelaxed()) {
+                    slot.referenced.storeRelaxed(0);
+                    ++hand;
+                    continue;
+                }
+                const int c = slot.cost;
+                removeAt(hand);
+                evictions.fetchAndAddRelaxed(1);
+                return c;
+            }
+        }
+    };
+
+    Shard *shards;
+    int mask;
+    QAtomicInt mx;
+    QAtomicInt total;
+    QAtomicInt nextVictim;
+
+    Shard &shardFor(const Key &key) const noexcept
+    {
+        // Use the high bits, the QHash inside the shard uses the low ones
+        const size_t h = qHash(key, size_t(0));
+        return shards[(h >> (8 * sizeof(size_t) - 16)) & size_t(mask)];
+    }
+
+    void trim(int m)
+    {
+        // Take the victims from the shards in turn, so that they all shrink
+        // evenly, and hold only one shard lock at a time.
+        int emptyShards = 0;
+        while (total.loadRelaxed() > m && emptyShards <= mask) {
+            Shard &s = shards[nextVictim.fetchAndAddRelaxed(1) & mask];
+            QWriteLocker locker(&s.lock);
+            const int c = s.evictOne();
+            if (c < 0) {
+                ++emptyShards;
+            } else {
+                emptyShards = 0;
+                total.fetchAndSubRelaxed(c);
+            }
+        }
+    }
+
+    // Moves the object out of the cache, so that the caller destroys it
+    // after the shard has been unlocked. Returns false if key is not found.
+    bool takeObject(const Key &key, QSharedPointer<T> *object)
+    {
+        Shard &s = shardFor(key);
+        QWriteLocker locker(&s.lock);
+        auto it = s.index.constFind(key);
+        if (it == s.index.cend())
+            return false;
+        const qsizetype i = *it;
+        *object = std::move(s.ring[i].object);
+        total.fetchAndSubRelaxed(s.ring.at(i).cost);
+        s.removeAt(i);
+        return true;
+    }
+
+    Q_DISABLE_COPY(QConcurrentCache)
+
+public:
+    struct Statistics {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 insertions = 0;
+        quint64 evictions = 0;
+    };
+
+    explicit QConcurrentCache(int maxCost = 100, int shardCount = 16)
+        : mx(maxCost)
+    {
+        int n = 1;
+        while (n < shardCount && n < (1 << 16))
+            n <<= 1;
+        shards = new Shard[n];
+        mask = n - 1;
+    }
+    ~QConcurrentCache() { delete [] shards; }
+
+    int shardCount() const noexcept { return mask + 1; }
+
+    int maxCost() const noexcept { return mx.loadRelaxed(); }
+    void setMaxCost(int m)
+    {
+        mx.storeRelaxed(m);
+        trim(m);
+    }
+    int totalCost() const noexcept { return total.loadRelaxed(); }
+
+    qsizetype size() const
+    {
+        qsizetype n = 0;
+        for (int i = 0; i <= mask; ++i) {
+            QReadLocker locker(&shards[i].lock);
+            n += shards[i].ring.size();
+        }
+        return n;
+    }
+    qsizetype count() const { return size(); }
+    bool isEmpty() const { return size() == 0; }
+
+    QList<Key> keys() const
+    {
+        QList<Key> k;
+        for (int i = 0; i <= mask; ++i) {
+            QReadLocker locker(&shards[i].lock);
+            for (const Slot &slot : shards[i].ring)
+                k << slot.key;
+        }
+        return k;
+    }
+
+    void clear()
+    {
+        for (int i = 0; i <= mask; ++i) {
+            Shard &s = shards[i];
+            QWriteLocker locker(&s.lock);
+            total.fetchAndSubRelaxed(s.cost);
+            s.cost = 0;
+            s.hand = 0;
+            s.ring.clear();
+            s.index.clear();
+        }
+    }
+
+    bool insert(const Key &key, T *object, int cost = 1)
+    {
+        return insert(key, QSharedPointer<T>(object), cost);
+    }
+
+    bool insert(const Key &key, const QSharedPointer<T> &object, int cost = 1)
+    {
+        if (cost > maxCost()) {
+            remove(key);
+            return false;
+        }
+        {
+            Shard &s = shardFor(key);
+            QWriteLocker locker(&s.lock);
+            auto it = s.index.constFind(key);
+            if (it != s.index.cend()) {
+                Slot &slot = s.ring[*it];
+                s.cost -= slot.cost;
+                total.fetchAndSubRelaxed(slot.cost);
+                slot.object = object;
+                slot.cost = cost;
+                slot.markReferenced();
+            } else {
+                s.index.insert(key, s.ring.size());
+                s.ring.append(Slot(key, object, cost));
+            }
+            s.cost += cost;
+            total.fetchAndAddRelaxed(cost);
+            s.insertions.fetchAndAddRelaxed(1);
+        }
+        trim(maxCost());
+        return true;
+    }
+
+    QSharedPointer<T> object(const Key &key) const
+    {
+        const Shard &s = shardFor(key);
+        QReadLocker locker(&s.lock);
+        auto it = s.index.constFind(key);
+        if (it == s.index.cend()) {
+            s.misses.fetchAndAddRelaxed(1);
+            return QSharedPointer<T>();
+        }
+        const Slot &slot = s.ring.at(*it);
+        slot.markReferenced();
+        s.hits.fetchAndAddRelaxed(1);
+        return slot.object;
+    }
+    QSharedPointer<T> operator[](const Key &key) const
+    {
+        return object(key);
+    }
+    bool contains(const Key &key) const
+    {
+        const Shard &s = shardFor(key);
+        QReadLocker locker(&s.lock);
+        return s.index.contains(key);
+    }
+
+    bool remove(const Key &key)
+    {
+        QSharedPointer<T> object;
+        return takeObject(key, &object);
+    }
+
+    QSharedPointer<T> take(const Key &key)
+    {
+        QSharedPointer<T> object;
+        takeObject(key, &object);
+        return object;
+    }
+
+    Statistics statistics() const noexcept
+    {
+        Statistics stats;
+        for (int i = 0; i <= mask; ++i) {
+            const Shard &s = shards[i];
+            stats.hits += s.hits.loadRelaxed();
+            stats.misses += s.misses.loadRelaxed();
+            stats.insertions += s.insertions.loadRelaxed();
+            stats.evictions += s.evictions.loadRelaxed();
+        }
+        return stats;
+    }
+    void resetStatistics() noexcept
+    {
+        for (int i = 0; i <= mask; ++i) {
+            Shard &s = shards[i];
+            s.hits.storeRelaxed(0);
+            s.misses.storeRelaxed(0);
+            s.insertions.storeRelaxed(0);
+            s.evictions.storeRelaxed(0);
+        }
+    }
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTCACHE_H
@@ -37,21 +37,10 @@
 **
 ****************************************************************************/
 
-#ifndef QFLATMAP_P_H
-#define QFLATMAP_P_H
-
-//
-//  W A R N I N G
-//  -------------
-//
-// This file is not part of the Qt API.  It exists for the convenience
-// of a number of Qt sources files.  This header file may change from
-// version to version without notice, or even be removed.
-//
-// We mean it.
-//
-
-#include "qlist.h"
+#ifndef QFLATMAP_H
+#define QFLATMAP_H
+
+#include <QtCore/qlist.h>
 
 #include <algorithm>
 #include <functional>
@@ -64,19 +53,6 @@
 
 QT_BEGIN_NAMESPACE
 
-/*
-  QFlatMap provides an associative container backed by sorted sequential
-  containers. By default, QList is used.
-
-  Keys and values are stored in two separate containers. This provides improved
-  cache locality for key iteration and makes keys() and values() fast
-  operations.
-
-  One can customize the underlying container type by passing the KeyContainer
-  and MappedContainer template arguments:
-      QFlatMap<float, int, std::less<float>, std::vector<float>, std::vector<int>>
-*/
-
 namespace Qt {
 
 struct OrderedUniqueRange_t {};
@@ -417,7 +393,7 @@ private:
     struct is_marked_transparent_type : std::false_type { };
 
     template <class X>
-    struct is_marked_transparent_type<X, typename X::is_transparent> : std::true_type { };
+    struct is_marked_transparent_type<X, std::void_t<typename X::is_transparent>> : std::true_type { };
 
     template <class X>
     using is_marked_transparent = typename std::enable_if<
@@ -457,7 +433,7 @@ public:
         ensureOrderedUnique();
     }
 
-    explicit QFlatMap(std::initializer_list<value_type> lst)
+    QFlatMap(std::initializer_list<value_type> lst)
         : QFlatMap(lst.begin(), lst.end())
     {
     }
@@ -541,7 +517,7 @@ public:
         ensureOrderedUnique();
     }
 
-    explicit QFlatMap(std::initializer_list<value_type> lst, const Compare &compare)
+    QFlatMap(std::initializer_list<value_type> lst, const Compare &compare)
         : QFlatMap(lst.begin(), lst.end(), compare)
     {
     }
@@ -614,13 +590,13 @@ public:
 
     bool remove(const Key &key)
     {
-        auto it = binary_find(key);
-        if (it != end()) {
-            c.keys.erase(toKeysIterator(it));
-            c.values.erase(toValuesIterator(it));
-            return true;
-        }
-        return false;
+        return removeImpl(key);
+    }
+
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    bool remove(const X &key)
+    {
+        return removeImpl(key);
     }
 
     iterator erase(iterator it)
@@ -645,18 +621,38 @@ public:
         return binary_find(key) != end();
     }
 
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    bool contains(const X &key) const
+    {
+        return binary_find(key) != end();
+    }
+
     T value(const Key &key, const T &defaultValue) const
     {
         auto it = binary_find(key);
         return it == end() ? defaultValue : it.value();
     }
 
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    T value(const X &key, const T &defaultValue) const
+    {
+        auto it = binary_find(key);
+        return it == end() ? defaultValue : it.value();
+    }
+
     T value(const Key &key) const
     {
         auto it = binary_find(key);
         return it == end() ? T() : it.value();
     }
 
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    T value(const X &key) const
+    {
+        auto it = binary_find(key);
+        return it == end() ? T() : it.value();
+    }
+
     T &operator[](const Key &key)
     {
         auto it = lower_bound(key);
@@ -700,7 +696,7 @@ public:
         auto it = lower_bound(key);
         if (it == end() || key_compare::operator()(key, it.key())) {
             c.values.insert(toValuesIterator(it), value);
-            return { c.keys.insert(it, std::move(key)), true };
+            return { fromKeysIterator(c.keys.insert(toKeysIterator(it), std::move(key))), true };
         } else {
             *toValuesIterator(it) = value;
             return {it, false};
@@ -712,7 +708,7 @@ public:
         auto it = lower_bound(key);
         if (it == end() || key_compare::operator()(key, it.key())) {
             c.values.insert(toValuesIterator(it), std::move(value));
-            return { c.keys.insert(it, key), true };
+            return { fromKeysIterator(c.keys.insert(toKeysIterator(it), key)), true };
         } else {
             *toValuesIterator(it) = std::move(value);
             return {it, false};
@@ -814,6 +810,18 @@ public:
         return binary_find(k);
     }
 
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    iterator find(const X &k)
+    {
+        return binary_find(k);
+    }
+
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    const_iterator find(const X &k) const
+    {
+        return binary_find(k);
+    }
+
     key_compare key_comp() const noexcept
     {
         return static_cast<key_compare>(*this);
@@ -904,12 +912,26 @@ private:
         makeUnique();
     }
 
-    iterator binary_find(const Key &key)
+    template <class K>
+    bool removeImpl(const K &key)
+    {
+        auto it = binary_find(key);
+        if (it != end()) {
+            c.keys.erase(toKeysIterator(it));
+            c.values.erase(toValuesIterator(it));
+            return true;
+        }
+        return false;
+    }
+
+    template <class K>
+    iterator binary_find(const K &key)
     {
         return { &c, const_cast<const full_map_t *>(this)->binary_find(key).i };
     }
 
-    const_iterator binary_find(const Key &key) const
+    template <class K>
+    const_iterator binary_find(const K &key) const
     {
         auto it = lower_bound(key);
         if (it != end()) {
@@ -922,6 +944,10 @@ private:
 
     void ensureOrderedUnique()
     {
+        if (std::is_sorted(c.keys.begin(), c.keys.end(), key_comp())) {
+            makeUnique();
+            return;
+        }
         std::vector<size_type> p(size_t(c.keys.size()));
         std::iota(p.begin(), p.end(), 0);
         std::stable_sort(p.begin(), p.end(), IndexedKeyComparator(this));
@@ -949,26 +975,32 @@ private:
         }
     }
 
+    // Removes all but the last of each run of equivalent keys in the sorted
+    // containers, so that the last one inserted wins, as with insert().
     void makeUnique()
     {
-        if (c.keys.size() < 2)
+        const size_type s = c.keys.size();
+        if (s < 2)
             return;
-        auto k = std::end(c.keys) - 1;
-        auto i = k - 1;
-        for (;;) {
-            if (key_compare::operator()(*i, *k) || key_compare::operator()(*k, *i)) {
-                if (i == std::begin(c.keys))
-                    break;
-                --i;
-                --k;
-            } else {
-                c.values.erase(std::begin(c.values) + std::distance(std::begin(c.keys), i));
-                i = c.keys.erase(i);
-                if (i == std::begin(c.keys))
-                    break;
-                k = i + 1;
+        size_type n = 0;
+        for (size_type i = 1; i < s; ++i) {
+            if (!key_compare::operator()(c.keys[i - 1], c.keys[i]))
+                continue;
+            if (n != i - 1) {
+                c.keys[n] = std::move(c.keys[i - 1]);
+                c.values[n] = std::move(c.values[i - 1]);
             }
+            ++n;
         }
+        if (n != s - 1) {
+            c.keys[n] = std::move(c.keys[s - 1]);
+            c.values[n] = std::move(c.values[s - 1]);
+        }
+        ++n;
+        if (n == s)
+            return;
+        c.keys.erase(c.keys.begin() + n, c.keys.end());
+        c.values.erase(c.values.begin() + n, c.values.end());
         c.keys.shrink_to_fit();
         c.values.shrink_to_fit();
     }
@@ -976,6 +1008,274 @@ private:
     containers c;
 };
 
+template<class Key, class Compare = std::less<Key>, class KeyContainer = QList<Key>>
+class QFlatSet : private Compare
+{
+    using full_set_t = QFlatSet<Key, Compare, KeyContainer>;
+
+    template <class, class = void>
+    struct is_marked_transparent_type : std::false_type { };
+
+    template <class X>
+    struct is_marked_transparent_type<X, std::void_t<typename X::is_transparent>> : std::true_type { };
+
+    template <class X>
+    using is_marked_transparent = typename std::enable_if<
+        is_marked_transparent_type<X>::value>::type *;
+
+    template <typename It>
+    using is_compatible_iterator = typename std::enable_if<
+        std::is_convertible<typename std::iterator_traits<It>::value_type, Key>::value>::type *;
+
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using container_type = KeyContainer;
+    using size_type = typename container_type::size_type;
+    using iterator = typename container_type::const_iterator;
+    using const_iterator = typename container_type::const_iterator;
+    using reverse_iterator = std::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    QFlatSet() = default;
+
+    explicit QFlatSet(const Compare &compare)
+        : Compare(compare)
+    {
+    }
+
+    explicit QFlatSet(const container_type &keys, const Compare &compare = Compare())
+        : Compare(compare), k(keys)
+    {
+        ensureOrderedUnique();
+    }
+
+    explicit QFlatSet(container_type &&keys, const Compare &compare = Compare())
+        : Compare(compare), k(std::move(keys))
+    {
+        ensureOrderedUnique();
+    }
+
+    QFlatSet(std::initializer_list<Key> lst, const Compare &compare = Compare())
+        : QFlatSet(lst.begin(), lst.end(), compare)
+    {
+    }
+
+    template <class InputIt, is_compatible_iterator<InputIt> = nullptr>
+    explicit QFlatSet(InputIt first, InputIt last, const Compare &compare = Compare())
+        : Compare(compare)
+    {
+        QtPrivate::reserveIfForwardIterator(&k, first, last);
+        std::copy(first, last, std::back_inserter(k));
+        ensureOrderedUnique();
+    }
+
+    explicit QFlatSet(Qt::OrderedUniqueRange_t, const container_type &keys,
+                      const Compare &compare = Compare())
+        : Compare(compare), k(keys)
+    {
+    }
+
+    explicit QFlatSet(Qt::OrderedUniqueRange_t, container_type &&keys,
+                      const Compare &compare = Compare())
+        : Compare(compare), k(std::move(keys))
+    {
+    }
+
+    explicit QFlatSet(Qt::OrderedUniqueRange_t, std::initializer_list<Key> lst,
+                      const Compare &compare = Compare())
+        : QFlatSet(Qt::OrderedUniqueRange, lst.begin(), lst.end(), compare)
+    {
+    }
+
+    template <class InputIt, is_compatible_iterator<InputIt> = nullptr>
+    explicit QFlatSet(Qt::OrderedUniqueRange_t, InputIt first, InputIt last,
+                      const Compare &compare = Compare())
+        : Compare(compare)
+    {
+        QtPrivate::reserveIfForwardIterator(&k, first, last);
+        std::copy(first, last, std::back_inserter(k));
+    }
+
+    size_type count() const noexcept { return k.size(); }
+    size_type size() const noexcept { return k.size(); }
+    size_type capacity() const noexcept { return k.capacity(); }
+    bool isEmpty() const noexcept { return k.empty(); }
+    bool empty() const noexcept { return k.empty(); }
+    container_type extract() && { return std::move(k); }
+    const container_type &values() const noexcept { return k; }
+
+    void reserve(size_type s) { k.reserve(s); }
+    void clear() { k.clear(); }
+
+    std::pair<iterator, bool> insert(const Key &key)
+    {
+        auto it = lower_bound(key);
+        if (it == end() || key_compare::operator()(key, *it))
+            return { k.insert(it, key), true };
+        return { it, false };
+    }
+
+    std::pair<iterator, bool> insert(Key &&key)
+    {
+        auto it = lower_bound(key);
+        if (it == end() || key_compare::operator()(key, *it))
+            return { k.insert(it, std::move(key)), true };
+        return { it, false };
+    }
+
+    template <class InputIt, is_compatible_iterator<InputIt> = nullptr>
+    void insert(InputIt first, InputIt last)
+    {
+        std::copy(first, last, std::back_inserter(k));
+        ensureOrderedUnique();
+    }
+
+    template <class InputIt, is_compatible_iterator<InputIt> = nullptr>
+    void insert(Qt::OrderedUniqueRange_t, InputIt first, InputIt last)
+    {
+        const size_type s = k.size();
+        std::copy(first, last, std::back_inserter(k));
+        std::inplace_merge(k.begin(), k.begin() + s, k.end(), key_comp());
+        makeUnique();
+    }
+
+    bool remove(const Key &key)
+    {
+        return removeImpl(key);
+    }
+
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    bool remove(const X &key)
+    {
+        return removeImpl(key);
+    }
+
+    iterator erase(const_iterator it)
+    {
+        return k.erase(it);
+    }
+
+    bool contains(const Key &key) const
+    {
+        return find(key) != end();
+    }
+
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    bool contains(const X &key) const
+    {
+        return find(key) != end();
+    }
+
+    const_iterator begin() const { return k.cbegin(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator constBegin() const { return begin(); }
+    const_iterator end() const { return k.cend(); }
+    const_iterator cend() const { return end(); }
+    const_iterator constEnd() const { return end(); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const { return rbegin(); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const { return rend(); }
+
+    const_iterator lower_bound(const Key &key) const
+    {
+        return std::lower_bound(k.begin(), k.end(), key, key_comp());
+    }
+
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    const_iterator lower_bound(const X &key) const
+    {
+        return std::lower_bound(k.begin(), k.end(), key, key_comp());
+    }
+
+    const_iterator upper_bound(const Key &key) const
+    {
+        return std::upper_bound(k.begin(), k.end(), key, key_comp());
+    }
+
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    const_iterator upper_bound(const X &key) const
+    {
+        return std::upper_bound(k.begin(), k.end(), key, key_comp());
+    }
+
+    const_iterator find(const Key &key) const
+    {
+        return binary_find(key);
+    }
+
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    const_iterator find(const X &key) const
+    {
+        return binary_find(key);
+    }
+
+    key_compare key_comp() const noexcept
+    {
+        return static_cast<key_compare>(*this);
+    }
+
+    value_compare value_comp() const noexcept
+    {
+        return static_cast<value_compare>(*this);
+    }
+
+private:
+    template <class K>
+    bool removeImpl(const K &key)
+    {
+        auto it = binary_find(key);
+        if (it == end())
+            return false;
+        k.erase(it);
+        return true;
+    }
+
+    template <class K>
+    const_iterator binary_find(const K &key) const
+    {
+        auto it = lower_bound(key);
+        if (it != end() && !key_compare::operator()(key, *it))
+            return it;
+        return end();
+    }
+
+    void ensureOrderedUnique()
+    {
+        if (!std::is_sorted(k.begin(), k.end(), key_comp()))
+            std::stable_sort(k.begin(), k.end(), key_comp());
+        makeUnique();
+    }
+
+    // Removes all but the last of each run of equivalent keys, as with QFlatMap.
+    void makeUnique()
+    {
+        const size_type s = k.size();
+        if (s < 2)
+            return;
+        size_type n = 0;
+        for (size_type i = 1; i < s; ++i) {
+            if (!key_compare::operator()(k[i - 1], k[i]))
+                continue;
+            if (n != i - 1)
+                k[n] = std::move(k[i - 1]);
+            ++n;
+        }
+        if (n != s - 1)
+            k[n] = std::move(k[s - 1]);
+        ++n;
+        if (n == s)
+            return;
+        k.erase(k.begin() + n, k.end());
+        k.shrink_to_fit();
+    }
+
+    container_type k;
+};
+
 QT_END_NAMESPACE
 
-#endif // QFLATMAP_P_H
+#endif // QFLATMAP_H
@@ -53,6 +53,7 @@
 #undef truncate
 #endif
 
+#include <qarena.h>
 #include <qbitarray.h>
 #include <qstring.h>
 #include <qglobal.h>
@@ -387,8 +388,145 @@ static uint siphash(const uint8_t *in, uint inlen, const uint seed)
 }
 #endif
 
+#if QT_COMPILER_SUPPORTS_HERE(AES) && !defined(QT_BOOTSTRAPPED)
+#  define AESHASH
+
+/*
+    AES-NI based hash, used instead of murmurhash and SipHash on processors
+    that support it. The input is processed 16 bytes at a time in two
+    independent lanes; each block is xor'ed into its lane, which is then
+    scrambled by two AESENC rounds keyed with the lane itself. The initial
+    state is derived from the seed and the length, so the hash keeps the
+    per-process seeding that protects QHash against hash flooding.
+
+    Inputs shorter than 16 bytes are read with a single 16-byte load that
+    may extend past either end of the buffer, but never crosses a page
+    boundary; the bytes outside the buffer are discarded.
+*/
+alignas(16) static const uchar aeshashMaskTable[32] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+alignas(16) static const uchar aeshashShuffleTable[32] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+};
+
+static inline __m128i QT_FUNCTION_TARGET(AES) aeshashRound(__m128i state, __m128i data)
+{
+    state = _mm_xor_si128(state, data);
+    state = _mm_aesenc_si128(state, state);
+    return _mm_aesenc_si128(state, state);
+}
+
+static inline __m128i QT_FUNCTION_TARGET(AES) aeshashLoad(const uchar *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+#if defined(Q_CC_GNU) && !defined(Q_CC_INTEL)
+// We may read past the end of the buffer, but that's a false positive:
+// the load stays within the page and the extra bytes are masked out
+__attribute__((__no_sanitize_address__))
+#endif
+static size_t QT_FUNCTION_TARGET(AES) aeshash(const uchar *p, size_t len, size_t seed) noexcept
+{
+    // mix in fractional digits of the golden ratio and of pi so that a zero
+    // seed doesn't produce a zero key
+    const __m128i key = _mm_xor_si128(_mm_set_epi64x(qint64(len), qint64(seed)),
+                                      _mm_set_epi64x(Q_INT64_C(0x9e3779b97f4a7c15),
+                                                     Q_INT64_C(0x243f6a8885a308d3)));
+    __m128i state0 = _mm_aesenc_si128(key, key);
+    __m128i state1 = _mm_aesenc_si128(state0, key);
+
+    const uchar *end = p + len;
+    if (len >= 16) {
+        for ( ; end - p >= 32; p += 32) {
+            state0 = aeshashRound(state0, aeshashLoad(p));
+            state1 = aeshashRound(state1, aeshashLoad(p + 16));
+        }
+
+        // 0 to 31 bytes left: the last block overlaps with what was
+        // already hashed, which is harmless
+        if (end - p > 16)
+            state0 = aeshashRound(state0, aeshashLoad(p));
+        state1 = aeshashRound(state1, aeshashLoad(end - 16));
+    } else if (len) {
+        const size_t tableOffset = 16 - len;
+        __m128i data;
+        if ((quintptr(p) & 0xfff) <= 0xff0) {
+            // the 16 bytes starting at p are in the same page
+            data = _mm_and_si128(aeshashLoad(p),
+                                 aeshashLoad(aeshashMaskTable + tableOffset));
+        } else {
+            // so are the 16 bytes ending at end; move our bytes to the front
+            data = _mm_shuffle_epi8(aeshashLoad(end - 16),
+                                    aeshashLoad(aeshashShuffleTable + tableOffset));
+        }
+        state0 = aeshashRound(state0, data);
+    }
+
+    state0 = _mm_aesenc_si128(state0, state1);
+    state0 = _mm_aesenc_si128(state0, key);
+#  if QT_POINTER_SIZE == 8
+    return size_t(_mm_cvtsi128_si64(state0));
+#  else
+    return size_t(_mm_cvtsi128_si32(state0));
+#  endif
+}
+#endif // AESHASH
+
+/*!
+    \internal
+
+    Allocates \a size bytes aligned to \a alignment for the storage of a
+    QHash, from \a arena if it is not \nullptr and from the heap otherwise.
+    Throws std::bad_alloc if no memory is available.
+
+    The word in front of the returned memory records where it came from,
+    so that freeStorage() doesn't need to know the arena.
+*/
+void *QHashPrivate::allocateStorage(size_t size, size_t alignment, QArena *arena)
+{
+    alignment = qMax(alignment, alignof(std::max_align_t));
+    char *p;
+    void *raw = nullptr;
+    if (arena) {
+        p = static_cast<char *>(arena->allocate(alignment + size, alignment));
+        Q_CHECK_PTR(p);
+        p += alignment;
+    } else {
+        // malloc() returns memory aligned to alignof(std::max_align_t),
+        // so the first aligned address after raw leaves space for the word
+        raw = ::malloc(alignment + size);
+        Q_CHECK_PTR(raw);
+        p = reinterpret_cast<char *>((quintptr(raw) + alignment) & ~quintptr(alignment - 1));
+    }
+    reinterpret_cast<void **>(p)[-1] = raw;
+    return p;
+}
+
+/*!
+    \internal
+
+    Frees memory allocated with allocateStorage(). Memory from a QArena is
+    only reclaimed when the arena is reset.
+*/
+void QHashPrivate::freeStorage(void *ptr) noexcept
+{
+    if (ptr)
+        ::free(static_cast<void **>(ptr)[-1]);
+}
+
 size_t qHashBits(const void *p, size_t size, size_t seed) noexcept
 {
+#ifdef AESHASH
+    if (qCpuHasFeature(AES) && qCpuHasFeature(SSE4_2))
+        return aeshash(reinterpret_cast<const uchar *>(p), size, seed);
+#endif
+
     if (size <= QT_POINTER_SIZE)
         return murmurhash(p, size, seed);
 
@@ -51,6 +51,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QArena;
+
 struct QHashDummyValue
 {
     bool operator==(const QHashDummyValue &) const noexcept { return true; }
@@ -58,6 +60,11 @@ struct QHashDummyValue
 
 namespace QHashPrivate {
 
+// The storage of QHash comes from the heap, or from the arena the QHash was
+// created with by QArena::hash()
+Q_CORE_EXPORT void *allocateStorage(size_t size, size_t alignment, QArena *arena);
+Q_CORE_EXPORT void freeStorage(void *ptr) noexcept;
+
 // QHash uses a power of two growth policy.
 namespace GrowthPolicy
 {
@@ -243,14 +250,23 @@ constexpr bool isRelocatable()
 // actual storage space for the Nodes (the 'entries' member) or 0xff (UnusedEntry) to flag that the bucket is empty.
 // As we have only 128 entries per Span, the offset array can be represented using an unsigned char. This trick makes the hash
 // table have a very small memory overhead compared to many other implementations.
+//
+// Each bucket also has a control byte, which is either UnusedControl for an empty bucket, or the top 7 bits of the hash of
+// the key stored in it. Lookups only compare the keys of the buckets whose hash fragment matches, which avoids touching
+// most of the non-matching Nodes. The control bytes and offsets are stored in Groups of GroupSize buckets, aligned so that
+// the offset of a bucket shares a cache line with its control byte. Together with the padding, this makes a Span 288
+// instead of 144 bytes on 64-bit platforms, i.e. 2.25 instead of 1.125 bytes per bucket on top of the Nodes.
 template<typename Node>
 struct Span {
     enum {
         NEntries = 128,
         LocalBucketMask = (NEntries - 1),
-        UnusedEntry = 0xff
+        UnusedEntry = 0xff,
+        GroupSize = 16,
+        UnusedControl = 0x80
     };
     static_assert ((NEntries & LocalBucketMask) == 0, "EntriesPerSpan must be a power of two.");
+    static_assert ((NEntries % GroupSize) == 0, "EntriesPerSpan must be a multiple of the group size.");
 
     // Entry is a slot available for storing a Node. The Span holds a pointer to
     // an array of Entries. Upon construction of the array, those entries are
@@ -263,16 +279,43 @@ struct Span {
 
         unsigned char &nextFree() { return *reinterpret_cast<unsigned char *>(&storage); }
         Node &node() { return *reinterpret_cast<Node *>(&storage); }
+
+        static void *operator new[](size_t size, QArena *arena) { return allocateStorage(size, alignof(Entry), arena); }
+        static void operator delete[](void *ptr, QArena *) noexcept { freeStorage(ptr); }
+        static void operator delete[](void *ptr) noexcept { freeStorage(ptr); }
+    };
+
+    struct Group {
+        unsigned char control[GroupSize];
+        unsigned char offsets[GroupSize];
     };
 
-    unsigned char offsets[NEntries];
+    alignas(sizeof(Group)) Group groups[NEntries / GroupSize];
     Entry *entries = nullptr;
     unsigned char allocated = 0;
     unsigned char nextFree = 0;
+    static void *operator new[](size_t size, QArena *arena) { return allocateStorage(size, alignof(Span), arena); }
+    static void operator delete[](void *ptr, QArena *) noexcept { freeStorage(ptr); }
+    static void operator delete[](void *ptr) noexcept { freeStorage(ptr); }
+
     Span() noexcept
     {
-        memset(offsets, UnusedEntry, sizeof(offsets));
+        for (Group &g : groups) {
+            memset(g.control, UnusedControl, sizeof(g.control));
+            memset(g.offsets, UnusedEntry, sizeof(g.offsets));
+        }
+    }
+
+    unsigned char &controlAt(size_t i) noexcept { return groups[i / GroupSize].control[i % GroupSize]; }
+    unsigned char controlAt(size_t i) const noexcept { return groups[i / GroupSize].control[i % GroupSize]; }
+    unsigned char &offsetAt(size_t i) noexcept { return groups[i / GroupSize].offsets[i % GroupSize]; }
+    unsigned char offsetAt(size_t i) const noexcept { return groups[i / GroupSize].offsets[i % GroupSize]; }
+
+    static unsigned char fragmentForHash(size_t hash) noexcept
+    {
+        return static_cast<unsigned char>(hash >> (8 * sizeof(size_t) - 7));
     }
+
     ~Span()
     {
         freeData();
@@ -281,34 +324,39 @@ struct Span {
     {
         if (entries) {
             if constexpr (!std::is_trivially_destructible<Node>::value) {
-                for (auto o : offsets) {
-                    if (o != UnusedEntry)
-                        entries[o].node().~Node();
+                for (const Group &g : groups) {
+                    for (auto o : g.offsets) {
+                        if (o != UnusedEntry)
+                            entries[o].node().~Node();
+                    }
                 }
             }
             delete [] entries;
             entries = nullptr;
         }
     }
-    Node *insert(size_t i)
+    Node *insert(size_t i, unsigned char fragment, QArena *arena)
     {
         Q_ASSERT(i <= NEntries);
-        Q_ASSERT(offsets[i] == UnusedEntry);
+        Q_ASSERT(offsetAt(i) == UnusedEntry);
+        Q_ASSERT(fragment != UnusedControl);
         if (nextFree == allocated)
-            addStorage();
+            addStorage(arena);
         unsigned char entry = nextFree;
         Q_ASSERT(entry < allocated);
         nextFree = entries[entry].nextFree();
-        offsets[i] = entry;
+        controlAt(i) = fragment;
+        offsetAt(i) = entry;
         return &entries[entry].node();
     }
     void erase(size_t bucket) noexcept(std::is_nothrow_destructible<Node>::value)
     {
         Q_ASSERT(bucket <= NEntries);
-        Q_ASSERT(offsets[bucket] != UnusedEntry);
+        Q_ASSERT(offsetAt(bucket) != UnusedEntry);
 
-        unsigned char entry = offsets[bucket];
-        offsets[bucket] = UnusedEntry;
+        unsigned char entry = offsetAt(bucket);
+        controlAt(bucket) = UnusedControl;
+        offsetAt(bucket) = UnusedEntry;
 
         entries[entry].node().~Node();
         entries[entry].nextFree() = nextFree;
@@ -316,25 +364,25 @@ struct Span {
     }
     size_t offset(size_t i) const noexcept
     {
-        return offsets[i];
+        return offsetAt(i);
     }
     bool hasNode(size_t i) const noexcept
     {
-        return (offsets[i] != UnusedEntry);
+        return (offsetAt(i) != UnusedEntry);
     }
     Node &at(size_t i) noexcept
     {
         Q_ASSERT(i <= NEntries);
-        Q_ASSERT(offsets[i] != UnusedEntry);
+        Q_ASSERT(offsetAt(i) != UnusedEntry);
 
-        return entries[offsets[i]].node();
+        return entries[offsetAt(i)].node();
     }
     const Node &at(size_t i) const noexcept
     {
         Q_ASSERT(i <= NEntries);
-        Q_ASSERT(offsets[i] != UnusedEntry);
+        Q_ASSERT(offsetAt(i) != UnusedEntry);
 
-        return entries[offsets[i]].node();
+        return entries[offsetAt(i)].node();
     }
     Node &atOffset(size_t o) noexcept
     {
@@ -350,26 +398,30 @@ struct Span {
     }
     void moveLocal(size_t from, size_t to) noexcept
     {
-        Q_ASSERT(offsets[from] != UnusedEntry);
-        Q_ASSERT(offsets[to] == UnusedEntry);
-        offsets[to] = offsets[from];
-        offsets[from] = UnusedEntry;
+        Q_ASSERT(offsetAt(from) != UnusedEntry);
+        Q_ASSERT(offsetAt(to) == UnusedEntry);
+        controlAt(to) = controlAt(from);
+        controlAt(from) = UnusedControl;
+        offsetAt(to) = offsetAt(from);
+        offsetAt(from) = UnusedEntry;
     }
-    void moveFromSpan(Span &fromSpan, size_t fromIndex, size_t to) noexcept(std::is_nothrow_move_constructible_v<Node>)
+    void moveFromSpan(Span &fromSpan, size_t fromIndex, size_t to, QArena *arena) noexcept(std::is_nothrow_move_constructible_v<Node>)
     {
         Q_ASSERT(to <= NEntries);
-        Q_ASSERT(offsets[to] == UnusedEntry);
+        Q_ASSERT(offsetAt(to) == UnusedEntry);
         Q_ASSERT(fromIndex <= NEntries);
-        Q_ASSERT(fromSpan.offsets[fromIndex] != UnusedEntry);
+        Q_ASSERT(fromSpan.offsetAt(fromIndex) != UnusedEntry);
         if (nextFree == allocated)
-            addStorage();
+            addStorage(arena);
         Q_ASSERT(nextFree < allocated);
-        offsets[to] = nextFree;
+        controlAt(to) = fromSpan.controlAt(fromIndex);
+        offsetAt(to) = nextFree;
         Entry &toEntry = entries[nextFree];
         nextFree = toEntry.nextFree();
 
-        size_t fromOffset = fromSpan.offsets[fromIndex];
-        fromSpan.offsets[fromIndex] = UnusedEntry;
+        size_t fromOffset = fromSpan.offsetAt(fromIndex);
+        fromSpan.controlAt(fromIndex) = UnusedControl;
+        fromSpan.offsetAt(fromIndex) = UnusedEntry;
         Entry &fromEntry = fromSpan.entries[fromOffset];
 
         if constexpr (isRelocatable<Node>()) {
@@ -382,7 +434,7 @@ struct Span {
         fromSpan.nextFree = static_cast<unsigned char>(fromOffset);
     }
 
-    void addStorage()
+    void addStorage(QArena *arena)
     {
         Q_ASSERT(allocated < NEntries);
         Q_ASSERT(nextFree == allocated);
@@ -393,7 +445,7 @@ struct Span {
         // some more space
         const size_t increment = NEntries/8;
         size_t alloc = allocated + increment;
-        Entry *newEntries = new Entry[alloc];
+        Entry *newEntries = new (arena) Entry[alloc];
         // we only add storage if the previous storage was fully filled, so
         // simply copy the old data over
         if constexpr (isRelocatable<Node>()) {
@@ -431,12 +483,21 @@ struct Data
 
 
     Span *spans = nullptr;
+    // the arena the hash was created with, if any; copies made when
+    // detaching use the heap
+    QArena *arena = nullptr;
 
-    Data(size_t reserve = 0)
+    static void *operator new(size_t size) { return allocateStorage(size, alignof(Data), nullptr); }
+    static void *operator new(size_t size, QArena *arena) { return allocateStorage(size, alignof(Data), arena); }
+    static void operator delete(void *ptr, QArena *) noexcept { freeStorage(ptr); }
+    static void operator delete(void *ptr) noexcept { freeStorage(ptr); }
+
+    Data(size_t reserve = 0, QArena *arena = nullptr)
+        : arena(arena)
     {
         numBuckets = GrowthPolicy::bucketsForCapacity(reserve);
         size_t nSpans = (numBuckets + Span::LocalBucketMask) / Span::NEntries;
-        spans = new Span[nSpans];
+        spans = new (arena) Span[nSpans];
         seed = qGlobalQHashSeed();
     }
     Data(const Data &other, size_t reserved = 0)
@@ -448,7 +509,7 @@ struct Data
             numBuckets = GrowthPolicy::bucketsForCapacity(qMax(size, reserved));
         bool resized = numBuckets != other.numBuckets;
         size_t nSpans = (numBuckets + Span::LocalBucketMask) / Span::NEntries;
-        spans = new Span[nSpans];
+        spans = new (arena) Span[nSpans];
 
         for (size_t s = 0; s < nSpans; ++s) {
             const Span &span = other.spans[s];
@@ -458,7 +519,8 @@ struct Data
                 const Node &n = span.at(index);
                 iterator it = resized ? find(n.key) : iterator{ this, s*Span::NEntries + index };
                 Q_ASSERT(it.isUnused());
-                Node *newNode = spans[it.span()].insert(it.index());
+                // the hash fragment doesn't depend on the number of buckets
+                Node *newNode = spans[it.span()].insert(it.index(), span.controlAt(index), arena);
                 new (newNode) Node(n);
             }
         }
@@ -510,7 +572,7 @@ struct Data
         Span *oldSpans = spans;
         size_t oldBucketCount = numBuckets;
         size_t nSpans = (newBucketCount + Span::LocalBucketMask) / Span::NEntries;
-        spans = new Span[nSpans];
+        spans = new (arena) Span[nSpans];
         numBuckets = newBucketCount;
         size_t oldNSpans = (oldBucketCount + Span::LocalBucketMask) / Span::NEntries;
 
@@ -522,7 +584,7 @@ struct Data
                 Node &n = span.at(index);
                 iterator it = find(n.key);
                 Q_ASSERT(it.isUnused());
-                Node *newNode = spans[it.span()].insert(it.index());
+                Node *newNode = spans[it.span()].insert(it.index(), span.controlAt(index), arena);
                 new (newNode) Node(std::move(n));
             }
             span.freeData();
@@ -548,9 +610,14 @@ struct Data
     }
 
     iterator find(const Key &key) const noexcept
+    {
+        return find(key, qHash(key, seed));
+    }
+
+    iterator find(const Key &key, size_t hash) const noexcept
     {
         Q_ASSERT(numBuckets > 0);
-        size_t hash = qHash(key, seed);
+        const unsigned char fragment = Span::fragmentForHash(hash);
         size_t bucket = GrowthPolicy::bucketForHash(numBuckets, hash);
         // loop over the buckets until we find the entry we search for
         // or an empty slot, in which case we know the entry doesn't exist
@@ -563,7 +630,8 @@ struct Data
             size_t offset = s.offset(index);
             if (offset == Span::UnusedEntry) {
                 return iterator{ this, bucket };
-            } else {
+            } else if (s.controlAt(index) == fragment) {
+                // only look at the Nodes whose hash fragment matches
                 Node &n = s.atOffset(offset);
                 if (n.key == key)
                     return iterator{ this, bucket };
@@ -591,9 +659,10 @@ struct Data
     {
         if (shouldGrow())
             rehash(size + 1);
-        iterator it = find(key);
+        size_t hash = qHash(key, seed);
+        iterator it = find(key, hash);
         if (it.isUnused()) {
-            spans[it.span()].insert(it.index());
+            spans[it.span()].insert(it.index(), Span::fragmentForHash(hash), arena);
             ++size;
             return { it, false };
         }
@@ -632,7 +701,7 @@ struct Data
                         spans[holeSpan].moveLocal(nextIndex, holeIndex);
                     } else {
                         // move between spans, more expensive
-                        spans[holeSpan].moveFromSpan(spans[nextSpan], nextIndex, holeIndex);
+                        spans[holeSpan].moveFromSpan(spans[nextSpan], nextIndex, holeIndex, arena);
                     }
                     hole = next;
                     break;
@@ -701,6 +770,7 @@ class QHash
     using Node = QHashPrivate::Node<Key, T>;
     using Data = QHashPrivate::Data<Node>;
     friend class QSet<Key>;
+    friend class QArena;
 
     Data *d = nullptr;
 
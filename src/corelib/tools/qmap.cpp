@@ -48,7 +48,13 @@
 
 QT_BEGIN_NAMESPACE
 
-const QMapDataBase QMapDataBase::shared_null = { Q_REFCOUNT_INITIALIZE_STATIC, 0, { 0, nullptr, nullptr }, nullptr };
+const QMapDataBase QMapDataBase::shared_null = { Q_REFCOUNT_INITIALIZE_STATIC, 0, { 0, nullptr, nullptr }, nullptr,
+                                                  nullptr, nullptr, nullptr, nullptr };
+
+struct QMapDataBase::NodeBlock
+{
+    NodeBlock *next;
+};
 
 const QMapNodeBase *QMapNodeBase::nextNode() const
 {
@@ -290,8 +296,8 @@ void QMapDataBase::freeNodeAndRebalance(QMapNodeBase *z)
     if (x)
         x->setColor(QMapNodeBase::Black);
     }
-    free(y);
     --size;
+    deallocateNode(y);
 }
 
 void QMapDataBase::recalcMostLeftNode()
@@ -301,33 +307,66 @@ void QMapDataBase::recalcMostLeftNode()
         mostLeftNode = mostLeftNode->left;
 }
 
-static inline size_t qMapAlignmentThreshold()
+static inline size_t qMapAlignTo(size_t size, size_t alignment)
 {
-    // malloc on 32-bit platforms should return pointers that are 8-byte
-    // aligned or more while on 64-bit platforms they should be 16-byte aligned
-    // or more
-    return 2 * sizeof(void*);
+    return (size + alignment - 1) & ~(alignment - 1);
 }
 
-static inline void *qMapAllocate(size_t alloc, size_t alignment)
+QMapNodeBase *QMapDataBase::allocateNode(size_t alloc, size_t alignment)
 {
-    return alignment > qMapAlignmentThreshold()
-        ? qMallocAligned(alloc, alignment)
-        : ::malloc(alloc);
+    if (QMapNodeBase *node = freeNodes) {
+        freeNodes = node->left;
+        return node;
+    }
+
+    alignment = qMax(alignment, alignof(NodeBlock));
+    const size_t stride = qMapAlignTo(alloc, alignment);
+    if (size_t(blockEnd - blockFree) < stride) {
+        // Each new block holds as many nodes as the map already has, so that
+        // the number of blocks only grows logarithmically, but not more than
+        // fit into 64KB so that we don't waste too much memory.
+        enum { MinimumNodes = 1, MaximumBlockSize = 64 * 1024 };
+        const size_t maximumNodes = qMax(size_t(MinimumNodes), MaximumBlockSize / stride);
+        const size_t count = qBound(size_t(MinimumNodes), size_t(size), maximumNodes);
+        const size_t header = qMapAlignTo(sizeof(NodeBlock), alignment);
+        NodeBlock *block = static_cast<NodeBlock *>(qMallocAligned(header + count * stride, alignment));
+        Q_CHECK_PTR(block);
+        block->next = blocks;
+        blocks = block;
+        blockFree = reinterpret_cast<char *>(block) + header;
+        blockEnd = blockFree + count * stride;
+    }
+    QMapNodeBase *node = reinterpret_cast<QMapNodeBase *>(blockFree);
+    blockFree += stride;
+    return node;
 }
 
-static inline void qMapDeallocate(QMapNodeBase *node, size_t alignment)
+void QMapDataBase::deallocateNode(QMapNodeBase *node)
 {
-    if (alignment > qMapAlignmentThreshold())
-        qFreeAligned(node);
-    else
-        ::free(node);
+    if (size == 0) {
+        // the map is empty: give all memory back instead of keeping it around
+        freeNodeBlocks();
+        return;
+    }
+    node->left = freeNodes;
+    freeNodes = node;
+}
+
+void QMapDataBase::freeNodeBlocks()
+{
+    while (blocks) {
+        NodeBlock *next = blocks->next;
+        qFreeAligned(blocks);
+        blocks = next;
+    }
+    blockFree = nullptr;
+    blockEnd = nullptr;
+    freeNodes = nullptr;
 }
 
 QMapNodeBase *QMapDataBase::createNode(size_t alloc, size_t alignment, QMapNodeBase *parent, bool left)
 {
-    QMapNodeBase *node = static_cast<QMapNodeBase *>(qMapAllocate(alloc, alignment));
-    Q_CHECK_PTR(node);
+    QMapNodeBase *node = allocateNode(alloc, alignment);
 
     memset(node, 0, alloc);
     ++size;
@@ -346,15 +385,6 @@ QMapNodeBase *QMapDataBase::createNode(size_t alloc, size_t alignment, QMapNodeB
     return node;
 }
 
-void QMapDataBase::freeTree(QMapNodeBase *root, size_t alignment)
-{
-    if (root->left)
-        freeTree(root->left, alignment);
-    if (root->right)
-        freeTree(root->right, alignment);
-    qMapDeallocate(root, alignment);
-}
-
 QMapDataBase *QMapDataBase::createData()
 {
     QMapDataBase *d = new QMapDataBase;
@@ -367,11 +397,17 @@ QMapDataBase *QMapDataBase::createData()
     d->header.right = nullptr;
     d->mostLeftNode = &(d->header);
 
+    d->blocks = nullptr;
+    d->blockFree = nullptr;
+    d->blockEnd = nullptr;
+    d->freeNodes = nullptr;
+
     return d;
 }
 
 void QMapDataBase::freeData(QMapDataBase *d)
 {
+    d->freeNodeBlocks();
     delete d;
 }
 
@@ -184,6 +184,14 @@ struct Q_CORE_EXPORT QMapDataBase
     QMapNodeBase header;
     QMapNodeBase *mostLeftNode;
 
+    // Nodes are carved out of larger blocks owned by the map, which makes
+    // allocating them cheap and keeps neighbouring nodes close in memory.
+    struct NodeBlock;
+    NodeBlock *blocks;
+    char *blockFree;
+    char *blockEnd;
+    QMapNodeBase *freeNodes;
+
     void rotateLeft(QMapNodeBase *x);
     void rotateRight(QMapNodeBase *x);
     void rebalance(QMapNodeBase *x);
@@ -191,7 +199,9 @@ struct Q_CORE_EXPORT QMapDataBase
     void recalcMostLeftNode();
 
     QMapNodeBase *createNode(size_t size, size_t alignment, QMapNodeBase *parent, bool left);
-    void freeTree(QMapNodeBase *root, size_t alignment);
+    QMapNodeBase *allocateNode(size_t size, size_t alignment);
+    void deallocateNode(QMapNodeBase *node);
+    void freeNodeBlocks();
 
     static const QMapDataBase shared_null;
 
@@ -241,10 +251,8 @@ struct QMapData : public QMapDataBase
     }
 
     void destroy() {
-        if (root()) {
+        if (root())
             root()->destroySubTree();
-            freeTree(header.left, alignof(Node));
-        }
         freeData(this);
     }
 };
@@ -53,6 +53,7 @@ template <class T>
 class QSet
 {
     typedef QHash<T, QHashDummyValue> Hash;
+    friend class QArena;
 
 public:
     inline QSet() noexcept {}
@@ -4,16 +4,18 @@ intel_icc: QMAKE_CXXFLAGS += -fp-model strict
 
 HEADERS +=  \
         tools/qalgorithms.h \
+        tools/qarena.h \
         tools/qarraydata.h \
         tools/qarraydataops.h \
         tools/qarraydatapointer.h \
         tools/qbitarray.h \
         tools/qcache.h \
+        tools/qconcurrentcache.h \
         tools/qcontainerfwd.h \
         tools/qcontainertools_impl.h \
         tools/qcryptographichash.h \
         tools/qduplicatetracker_p.h \
-        tools/qflatmap_p.h \
+        tools/qflatmap.h \
         tools/qfreelist_p.h \
         tools/qhash.h \
         tools/qhashfunctions.h \
@@ -49,6 +51,7 @@ HEADERS +=  \
         tools/qversionnumber.h
 
 SOURCES += \
+        tools/qarena.cpp \
         tools/qarraydata.cpp \
         tools/qbitarray.cpp \
         tools/qcryptographichash.cpp \
@@ -98,6 +98,7 @@ SOURCES += \
            ../../corelib/time/qdatetime.cpp \
            ../../corelib/time/qgregoriancalendar.cpp \
            ../../corelib/time/qromancalendar.cpp \
+           ../../corelib/tools/qarena.cpp \
            ../../corelib/tools/qarraydata.cpp \
            ../../corelib/tools/qbitarray.cpp \
            ../../corelib/tools/qcommandlineparser.cpp \
@@ -54,6 +54,7 @@
     "qtconcurrentmap.h" => "QtConcurrentMap",
     "qtconcurrentfilter.h" => "QtConcurrentFilter",
     "qtconcurrentrun.h" => "QtConcurrentRun",
+    "qtconcurrentalgorithms.h" => "QtConcurrentAlgorithms",
     "qpassworddigestor.h" => "QPasswordDigestor",
 );
 %deprecatedheaders = (
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qtconcurrentalgorithms
+QT = core testlib concurrent
+SOURCES = tst_qtconcurrentalgorithms.cpp
@@ -0,0 +1,365 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtconcurrentalgorithms.h>
+#include <qexception.h>
+
+#include <QRandomGenerator>
+#include <QSemaphore>
+
+#include <QtTest/QtTest>
+
+#include <list>
+
+class tst_QtConcurrentAlgorithms : public QObject
+{
+    Q_OBJECT
+private slots:
+    void sort_data();
+    void sort();
+    void sortCustomLessThan();
+    void blockingSort();
+    void inclusiveScan_data();
+    void inclusiveScan();
+    void inclusiveScanNonCommutative();
+    void partition_data();
+    void partition();
+    void findFirst_data();
+    void findFirst();
+    void findFirstStopsEarly();
+    void findFirstForwardIterators();
+    void progress();
+    void cancel();
+#ifndef QT_NO_EXCEPTIONS
+    void exceptions();
+#endif
+};
+
+static QList<int> randomList(qsizetype size)
+{
+    QRandomGenerator generator(size);
+    QList<int> list;
+    list.reserve(size);
+    for (qsizetype i = 0; i < size; ++i)
+        list.append(int(generator.bounded(1000)));
+    return list;
+}
+
+void tst_QtConcurrentAlgorithms::sort_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("threadCount");
+
+    for (int threadCount : { 1, 3, 4 }) {
+        for (int size : { 0, 1, 17, 1024, 4096, 5000, 100000 }) {
+            const QByteArray name = QByteArray::number(size) + " items, "
+                    + QByteArray::number(threadCount) + " threads";
+            QTest::newRow(name.constData()) << size << threadCount;
+        }
+    }
+}
+
+void tst_QtConcurrentAlgorithms::sort()
+{
+    QFETCH(int, size);
+    QFETCH(int, threadCount);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+
+    QList<int> list = randomList(size);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    QtConcurrent::sort(&pool, list).waitForFinished();
+    QCOMPARE(list, expected);
+
+    list = randomList(size);
+    QtConcurrent::sort(&pool, list.begin(), list.end()).waitForFinished();
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithms::sortCustomLessThan()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QList<int> list = randomList(10000);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+
+    QtConcurrent::sort(&pool, list, std::greater<>()).waitForFinished();
+    QCOMPARE(list, expected);
+
+    std::vector<int> vector(list.rbegin(), list.rend());
+    QtConcurrent::sort(&pool, vector.begin(), vector.end(), [](int lhs, int rhs) {
+        return lhs > rhs;
+    }).waitForFinished();
+    QVERIFY(std::equal(vector.begin(), vector.end(), expected.begin(), expected.end()));
+}
+
+void tst_QtConcurrentAlgorithms::blockingSort()
+{
+    QList<int> list = randomList(50000);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    QtConcurrent::blockingSort(list);
+    QCOMPARE(list, expected);
+
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    QtConcurrent::blockingSort(list.begin(), list.end(), std::greater<>());
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan_data()
+{
+    sort_data();
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan()
+{
+    QFETCH(int, size);
+    QFETCH(int, threadCount);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+
+    QList<int> list = randomList(size);
+    QList<int> expected = list;
+    std::partial_sum(expected.begin(), expected.end(), expected.begin());
+
+    QList<int> copy = list;
+    QtConcurrent::inclusiveScan(&pool, copy).waitForFinished();
+    QCOMPARE(copy, expected);
+
+    copy = list;
+    QtConcurrent::blockingInclusiveScan(&pool, copy.begin(), copy.end());
+    QCOMPARE(copy, expected);
+}
+
+// Affine maps x -> a * x + b compose associatively, but not commutatively.
+struct Affine
+{
+    quint32 a = 1;
+    quint32 b = 0;
+
+    friend bool operator==(const Affine &lhs, const Affine &rhs)
+    { return lhs.a == rhs.a && lhs.b == rhs.b; }
+};
+
+static Affine compose(const Affine &first, const Affine &second)
+{
+    return Affine { second.a * first.a, second.a * first.b + second.b };
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScanNonCommutative()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QRandomGenerator generator(42);
+    std::vector<Affine> maps(30000);
+    for (Affine &map : maps)
+        map = Affine { generator.generate() | 1, generator.generate() };
+
+    std::vector<Affine> expected = maps;
+    std::partial_sum(expected.begin(), expected.end(), expected.begin(), compose);
+
+    QtConcurrent::blockingInclusiveScan(&pool, maps, compose);
+    QVERIFY(maps == expected);
+}
+
+void tst_QtConcurrentAlgorithms::partition_data()
+{
+    sort_data();
+}
+
+void tst_QtConcurrentAlgorithms::partition()
+{
+    QFETCH(int, size);
+    QFETCH(int, threadCount);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+
+    const auto isEven = [](int value) { return value % 2 == 0; };
+
+    QList<int> list = randomList(size);
+    QList<int> expected = list;
+    const auto split = std::stable_partition(expected.begin(), expected.end(), isEven);
+
+    QFuture<qsizetype> future = QtConcurrent::partition(&pool, list, isEven);
+    QCOMPARE(future.result(), qsizetype(split - expected.begin()));
+    QCOMPARE(list, expected);
+
+    list = randomList(size);
+    const qsizetype result = QtConcurrent::blockingPartition(&pool, list.begin(), list.end(),
+                                                             isEven);
+    QCOMPARE(result, qsizetype(split - expected.begin()));
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithms::findFirst_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<QList<int>>("matches");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("empty") << 0 << QList<int>() << -1;
+    QTest::newRow("no match") << 100000 << QList<int>() << -1;
+    QTest::newRow("first") << 100000 << QList<int> { 0, 5, 99999 } << 0;
+    QTest::newRow("last") << 100000 << QList<int> { 99999 } << 99999;
+    QTest::newRow("middle") << 100000 << QList<int> { 70000, 70001, 90000 } << 70000;
+    QTest::newRow("small") << 10 << QList<int> { 3, 7 } << 3;
+}
+
+void tst_QtConcurrentAlgorithms::findFirst()
+{
+    QFETCH(int, size);
+    QFETCH(QList<int>, matches);
+    QFETCH(int, expected);
+
+    QList<int> list(size, 0);
+    for (int index : matches)
+        list[index] = 1;
+
+    const auto isOne = [](int value) { return value == 1; };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QCOMPARE(QtConcurrent::findFirst(&pool, list, isOne).result(), qsizetype(expected));
+    QCOMPARE(QtConcurrent::findFirst(list, isOne).result(), qsizetype(expected));
+    QCOMPARE(QtConcurrent::blockingFindFirst(&pool, list.constBegin(), list.constEnd(), isOne),
+             qsizetype(expected));
+    QCOMPARE(QtConcurrent::blockingFindFirst(list, isOne), qsizetype(expected));
+}
+
+void tst_QtConcurrentAlgorithms::findFirstStopsEarly()
+{
+    const int size = 1000000;
+    QList<int> list(size, 0);
+    list[10] = 1;
+
+    QAtomicInt calls;
+    const qsizetype index = QtConcurrent::blockingFindFirst(list, [&calls](int value) {
+        calls.fetchAndAddRelaxed(1);
+        return value == 1;
+    });
+    QCOMPARE(index, qsizetype(10));
+    QVERIFY2(calls.loadRelaxed() < size / 2, QByteArray::number(calls.loadRelaxed()));
+}
+
+void tst_QtConcurrentAlgorithms::findFirstForwardIterators()
+{
+    std::list<int> list;
+    for (int i = 0; i < 1000; ++i)
+        list.push_back(i);
+
+    QCOMPARE(QtConcurrent::blockingFindFirst(list, [](int value) { return value * value > 1000; }),
+             qsizetype(32));
+    QCOMPARE(QtConcurrent::findFirst(list.cbegin(), list.cend(),
+                                     [](int value) { return value < 0; }).result(),
+             qsizetype(-1));
+}
+
+void tst_QtConcurrentAlgorithms::progress()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QList<int> list = randomList(100000);
+    QFuture<void> future = QtConcurrent::sort(&pool, list);
+    future.waitForFinished();
+    QVERIFY(future.progressMaximum() > 0);
+    QCOMPARE(future.progressValue(), future.progressMaximum());
+
+    QFuture<qsizetype> partitioned = QtConcurrent::partition(&pool, list,
+                                                             [](int value) { return value < 500; });
+    partitioned.waitForFinished();
+    QVERIFY(partitioned.progressMaximum() > 0);
+    QCOMPARE(partitioned.progressValue(), partitioned.progressMaximum());
+}
+
+void tst_QtConcurrentAlgorithms::cancel()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+
+    QList<int> list = randomList(100000);
+    QList<int> original = list;
+
+    // Hold the first comparison until the sort has been canceled; the
+    // blocks still finish sorting, but they must not be merged afterwards.
+    QSemaphore entered;
+    QSemaphore proceed;
+    QAtomicInt first(1);
+    auto lessThan = [&](int lhs, int rhs) {
+        if (first.testAndSetRelaxed(1, 0)) {
+            entered.release();
+            proceed.acquire();
+        }
+        return lhs < rhs;
+    };
+
+    QFuture<void> future = QtConcurrent::sort(&pool, list, lessThan);
+    entered.acquire();
+    future.cancel();
+    proceed.release();
+    future.waitForFinished();
+
+    QVERIFY(future.isCanceled());
+    QVERIFY(future.progressValue() < future.progressMaximum());
+    QVERIFY(!std::is_sorted(list.begin(), list.end()));
+    std::sort(list.begin(), list.end());
+    std::sort(original.begin(), original.end());
+    QCOMPARE(list, original);
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QtConcurrentAlgorithms::exceptions()
+{
+    QList<int> list = randomList(10000);
+
+    bool caught = false;
+    try  {
+        QtConcurrent::blockingPartition(list, [](int value) -> bool {
+            if (value == 999)
+                throw QException();
+            return value % 2;
+        });
+    } catch (const QException &) {
+        caught = true;
+    }
+    if (!caught)
+        QFAIL("did not get exception");
+}
+#endif
+
+QTEST_MAIN(tst_QtConcurrentAlgorithms)
+#include "tst_qtconcurrentalgorithms.moc"
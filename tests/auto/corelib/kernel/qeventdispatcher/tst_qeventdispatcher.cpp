@@ -34,6 +34,13 @@
 #endif
 #include <QtTest/QtTest>
 
+// The backend is chosen when the application creates its event dispatcher
+#if defined(QT_TEST_EVENT_DISPATCHER_EPOLL)
+static const bool eventDispatcherBackendSelected = qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+#elif defined(QT_TEST_EVENT_DISPATCHER_IO_URING)
+static const bool eventDispatcherBackendSelected = qputenv("QT_EVENT_DISPATCHER_IO_URING", "1");
+#endif
+
 enum {
     PreciseTimerInterval    =   10,
     CoarseTimerInterval     =  200,
@@ -90,6 +97,10 @@ bool tst_QEventDispatcher::event(QEvent *e)
 // drain the system event queue after the test starts to avoid destabilizing the test functions
 void tst_QEventDispatcher::initTestCase()
 {
+#if defined(QT_TEST_EVENT_DISPATCHER_EPOLL) || defined(QT_TEST_EVENT_DISPATCHER_IO_URING)
+    QVERIFY(eventDispatcherBackendSelected);
+#endif
+
     QElapsedTimer elapsedTimer;
     elapsedTimer.start();
     while (!elapsedTimer.hasExpired(CoarseTimerInterval) && eventDispatcher->processEvents(QEventLoop::AllEvents)) {
@@ -78,6 +78,10 @@ private slots:
     void thread();
     void thread0();
     void moveToThread();
+    void queuedCallsWhileMoving();
+    void batchedConnection_data();
+    void batchedConnection();
+    void batchedConnectionReceiverDestroyed();
     void senderTest();
     void declareInterface();
     void qpointerResetBeforeDestroyedSignal();
@@ -1899,6 +1903,180 @@ void tst_QObject::moveToThread()
     }
 }
 
+class PingPongReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    QThread *threads[2];
+    QAtomicInt received = 0;
+    QAtomicInt wrongThread = 0;
+
+public slots:
+    void slot()
+    {
+        if (thread() != QThread::currentThread())
+            wrongThread.ref();
+        // keep moving between the threads while the calls come in
+        if (received.fetchAndAddRelaxed(1) % 100 == 99)
+            moveToThread(thread() == threads[0] ? threads[1] : threads[0]);
+    }
+};
+
+void tst_QObject::queuedCallsWhileMoving()
+{
+    MoveToThreadThread first;
+    MoveToThreadThread second;
+    first.start();
+    second.start();
+
+    SenderObject sender;
+    PingPongReceiver receiver;
+    receiver.threads[0] = &first;
+    receiver.threads[1] = &second;
+    connect(&sender, &SenderObject::signal1, &receiver, &PingPongReceiver::slot,
+            Qt::QueuedConnection);
+    receiver.moveToThread(&first);
+
+    const int producerCount = 4;
+    const int emitsPerProducer = 5000;
+    std::vector<std::unique_ptr<QThread>> producers;
+    for (int i = 0; i < producerCount; ++i) {
+        producers.emplace_back(QThread::create([&sender] {
+            for (int j = 0; j < emitsPerProducer; ++j)
+                sender.emitSignal1();
+        }));
+        producers.back()->start();
+    }
+    for (auto &producer : producers)
+        QVERIFY(producer->wait());
+
+    QTRY_COMPARE_WITH_TIMEOUT(receiver.received.loadRelaxed(), producerCount * emitsPerProducer,
+                              60000);
+    QCOMPARE(receiver.wrongThread.loadRelaxed(), 0);
+
+    first.quit();
+    second.quit();
+    QVERIFY(first.wait());
+    QVERIFY(second.wait());
+}
+
+class BatchSender : public QObject
+{
+    Q_OBJECT
+signals:
+    void valueChanged(const QString &name, int value);
+};
+
+class BatchReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    QStringList names;
+    QList<int> values;
+
+public slots:
+    void setValue(const QString &name, int value)
+    {
+        names.append(name);
+        values.append(value);
+    }
+};
+
+void tst_QObject::batchedConnection_data()
+{
+    QTest::addColumn<bool>("coalesced");
+    QTest::addColumn<bool>("functor");
+
+    QTest::newRow("batched") << false << false;
+    QTest::newRow("batched-functor") << false << true;
+    QTest::newRow("coalesced") << true << false;
+    QTest::newRow("coalesced-functor") << true << true;
+}
+
+void tst_QObject::batchedConnection()
+{
+    QFETCH(bool, coalesced);
+    QFETCH(bool, functor);
+
+    const Qt::ConnectionType type = Qt::ConnectionType(Qt::QueuedConnection
+            | (coalesced ? Qt::CoalescedConnection : Qt::BatchedConnection));
+    BatchSender sender;
+    BatchReceiver receiver;
+    if (functor) {
+        QVERIFY(connect(&sender, &BatchSender::valueChanged,
+                        &receiver, &BatchReceiver::setValue, type));
+    } else {
+        QVERIFY(connect(&sender, SIGNAL(valueChanged(QString,int)),
+                        &receiver, SLOT(setValue(QString,int)), type));
+    }
+
+    const int count = 100;
+    QStringList names;
+    QList<int> values;
+    for (int i = 0; i < count; ++i) {
+        names.append(QString::number(i));
+        values.append(i);
+        emit sender.valueChanged(names.last(), i);
+    }
+    QVERIFY(receiver.values.isEmpty());
+
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    if (coalesced) {
+        QCOMPARE(receiver.names, QStringList(names.last()));
+        QCOMPARE(receiver.values, QList<int>() << values.last());
+    } else {
+        QCOMPARE(receiver.names, names);
+        QCOMPARE(receiver.values, values);
+    }
+
+    // emissions after the delivery start a new batch
+    receiver.names.clear();
+    receiver.values.clear();
+    emit sender.valueChanged(QStringLiteral("a"), 1);
+    emit sender.valueChanged(QStringLiteral("b"), 2);
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    if (coalesced) {
+        QCOMPARE(receiver.names, QStringList() << "b");
+        QCOMPARE(receiver.values, QList<int>() << 2);
+    } else {
+        QCOMPARE(receiver.names, QStringList() << "a" << "b");
+        QCOMPARE(receiver.values, QList<int>() << 1 << 2);
+    }
+
+    // a removed event does not lose the following emissions
+    receiver.names.clear();
+    receiver.values.clear();
+    emit sender.valueChanged(QStringLiteral("lost"), 3);
+    QCoreApplication::removePostedEvents(&receiver, QEvent::MetaCall);
+    emit sender.valueChanged(QStringLiteral("c"), 4);
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(receiver.names, QStringList() << "c");
+
+    // the pending calls are released when the receiver goes away
+    emit sender.valueChanged(QStringLiteral("d"), 5);
+}
+
+void tst_QObject::batchedConnectionReceiverDestroyed()
+{
+    // the batches are posted to receivers that are destroyed in the meantime
+    BatchSender sender;
+    QAtomicInt done = 0;
+    QScopedPointer<QThread> emitter(QThread::create([&sender, &done] {
+        for (int i = 0; !done.loadRelaxed(); ++i)
+            emit sender.valueChanged(QStringLiteral("value"), i);
+    }));
+    emitter->start();
+
+    for (int round = 0; round < 500; ++round) {
+        BatchReceiver receiver;
+        connect(&sender, &BatchSender::valueChanged, &receiver, &BatchReceiver::setValue,
+                Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection));
+        QCoreApplication::processEvents();
+    }
+    done.storeRelaxed(1);
+    QVERIFY(emitter->wait());
+}
+
 
 void tst_QObject::property()
 {
@@ -44,16 +44,28 @@
 #endif
 #include <limits>
 
+#if defined(QT_TEST_EVENT_DISPATCHER_EPOLL) || defined(QT_TEST_EVENT_DISPATCHER_IO_URING)
+#include <private/qeventdispatcher_unix_p.h>
+#endif
+
 #if defined (Q_CC_MSVC) && defined(max)
 #  undef max
 #  undef min
 #endif // Q_CC_MSVC
 
+// The backend is chosen when the application creates its event dispatcher
+#if defined(QT_TEST_EVENT_DISPATCHER_EPOLL)
+static const bool eventDispatcherBackendSelected = qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+#elif defined(QT_TEST_EVENT_DISPATCHER_IO_URING)
+static const bool eventDispatcherBackendSelected = qputenv("QT_EVENT_DISPATCHER_IO_URING", "1");
+#endif
+
 
 class tst_QSocketNotifier : public QObject
 {
     Q_OBJECT
 private slots:
+    void initTestCase();
     void unexpectedDisconnection();
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
@@ -124,6 +136,23 @@ signals:
     void finished();
 };
 
+void tst_QSocketNotifier::initTestCase()
+{
+#if defined(QT_TEST_EVENT_DISPATCHER_EPOLL) || defined(QT_TEST_EVENT_DISPATCHER_IO_URING)
+    QVERIFY(eventDispatcherBackendSelected);
+    auto dispatcher = qobject_cast<QEventDispatcherUNIX *>(QAbstractEventDispatcher::instance());
+    QVERIFY(dispatcher);
+    auto d = static_cast<QEventDispatcherUNIXPrivate *>(QObjectPrivate::get(dispatcher));
+#  if defined(QT_TEST_EVENT_DISPATCHER_EPOLL)
+    QVERIFY(d->epollFd >= 0);
+#  else
+    // io_uring can be missing or disabled even where Qt was built with it
+    if (!d->ioUring.isValid())
+        QSKIP("io_uring is not available, the dispatcher fell back to poll()");
+#  endif
+#endif
+}
+
 void tst_QSocketNotifier::unexpectedDisconnection()
 {
     /*
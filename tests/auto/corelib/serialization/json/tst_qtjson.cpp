@@ -153,6 +153,9 @@ private Q_SLOTS:
 
     void parseErrorOffset_data();
     void parseErrorOffset();
+    void parseAcrossBlocks_data();
+    void parseAcrossBlocks();
+    void parseReferencingStrings();
 
     void implicitValueType();
     void implicitDocumentType();
@@ -3239,6 +3242,112 @@ void tst_QtJson::parseErrorOffset()
     QCOMPARE(error.offset, errorOffset);
 }
 
+void tst_QtJson::parseAcrossBlocks_data()
+{
+    QTest::addColumn<int>("padding");
+
+    // The parser classifies its input in blocks of 64 bytes and in windows
+    // of 16 KB; make sure whitespace and strings straddle both boundaries.
+    for (int padding : { 0, 1, 31, 32, 62, 63, 64, 65, 127, 128, 129,
+                         16 * 1024 - 70, 16 * 1024 - 1, 16 * 1024, 16 * 1024 + 1, 40000 })
+        QTest::addRow("%d", padding) << padding;
+}
+
+void tst_QtJson::parseAcrossBlocks()
+{
+    QFETCH(int, padding);
+
+    const QString ascii = QString(padding, QLatin1Char('a'));
+    const QString nonAscii = ascii + QString::fromUtf8("\xc3\xa9\xe2\x82\xac") + ascii
+            + QString::fromUtf8("\xf0\x9f\x98\x80");
+    const QByteArray spaces(padding, ' ');
+    const QByteArray json = "{" + spaces + "\"ascii\"" + spaces + ":" + spaces
+            + "\"" + ascii.toLatin1() + "\"" + spaces + ",\n\t\"nonAscii\": \""
+            + nonAscii.toUtf8() + "\"," + spaces + "\"escaped\":\"" + ascii.toLatin1()
+            + "\\n\\u00e9\"" + spaces + ",\"array\":[" + spaces + "1," + spaces + "true" + spaces
+            + "]" + spaces + "}" + spaces;
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    const QJsonObject object = doc.object();
+    QCOMPARE(object.size(), 4);
+    QCOMPARE(object.value("ascii").toString(), ascii);
+    QCOMPARE(object.value("nonAscii").toString(), nonAscii);
+    QCOMPARE(object.value("escaped").toString(), ascii + QLatin1String("\n") + QChar(0xe9));
+    QCOMPARE(object.value("array").toArray(), QJsonArray({ 1, true }));
+
+    // errors are reported at the same offsets, however far into the document
+    QJsonDocument::fromJson("[" + spaces + "\"" + ascii.toLatin1() + "\xff\"]", &error);
+    QCOMPARE(error.error, QJsonParseError::IllegalUTF8String);
+    QCOMPARE(error.offset, 2 * padding + 2);
+
+    QJsonDocument::fromJson("[" + spaces + "\"" + ascii.toLatin1() + spaces, &error);
+    QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+    QCOMPARE(error.offset, 3 * padding + 3);
+
+    QJsonDocument::fromJson("[" + spaces + "1 " + spaces + "2]", &error);
+    QCOMPARE(error.error, QJsonParseError::MissingValueSeparator);
+    QCOMPARE(error.offset, 2 * padding + 4);
+}
+
+void tst_QtJson::parseReferencingStrings()
+{
+    const QByteArray json = "{\"ascii\": \"plain text\", \"caf\xc3\xa9\": \"\xe2\x82\xac 5\","
+            "\"escaped\": \"a\\\"b\\u00e9\", \"empty\": \"\", \"dup\": 1, \"dup\": \"last\","
+            "\"nested\": {\"array\": [\"one\", 2, \"th\\u0072ee\", {\"\": null}]},"
+            "\"number\": 3.5, \"flag\": true}";
+    QByteArray source = json;
+    source.detach();
+    const QByteArray raw = QByteArray::fromRawData(source.constData(), source.size());
+
+    QJsonParseError error;
+    const QJsonDocument copied = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    const QJsonDocument referencing = QJsonDocument::fromJson(raw, &error,
+                                                              QJsonDocument::ReferenceStrings);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QCOMPARE(referencing, copied);
+    QCOMPARE(referencing.toJson(QJsonDocument::Compact), copied.toJson(QJsonDocument::Compact));
+    QCOMPARE(referencing.toJson(QJsonDocument::Indented), copied.toJson(QJsonDocument::Indented));
+    QCOMPARE(referencing.toVariant(), copied.toVariant());
+    QCOMPARE(QCborValue::fromJsonValue(referencing.object()).toCbor(),
+             QCborValue::fromJsonValue(copied.object()).toCbor());
+
+    QJsonObject object = referencing.object();
+    QCOMPARE(object.keys(), copied.object().keys());
+    QCOMPARE(object.value("ascii").toString(), QLatin1String("plain text"));
+    QCOMPARE(object.value(QString::fromUtf8("caf\xc3\xa9")).toString(),
+             QString::fromUtf8("\xe2\x82\xac 5"));
+    QCOMPARE(object.value("escaped").toString(), QLatin1String("a\"b") + QChar(0xe9));
+    QCOMPARE(object.value("empty").toString(), QString(""));
+    QCOMPARE(object.value("dup").toString(), QLatin1String("last"));
+    QCOMPARE(object.value("nested").toObject().value("array").toArray().at(2).toString(),
+             QLatin1String("three"));
+
+    // modifying and taking values, with the JSON text still available
+    QJsonObject expected = copied.object();
+    object.insert("moved", object.value("ascii"));
+    expected.insert("moved", expected.value("ascii"));
+    object.remove(QString::fromUtf8("caf\xc3\xa9"));
+    expected.remove(QString::fromUtf8("caf\xc3\xa9"));
+    QCOMPARE(object.take("dup"), expected.take("dup"));
+    QCOMPARE(object, expected);
+
+    // values copied elsewhere no longer need the JSON text
+    QJsonArray array;
+    array.append(object.value("ascii"));
+    array.append(referencing.object().value("nested").toObject().value("array").toArray().at(0));
+    QJsonObject keyed;
+    for (auto it = object.begin(); it != object.end(); ++it)
+        keyed.insert(it.key(), 0);
+    object = QJsonObject();
+    source.fill('x');
+    QCOMPARE(array, QJsonArray({ "plain text", "one" }));
+    QCOMPARE(keyed.keys(), expected.keys());
+}
+
 void tst_QtJson::implicitValueType()
 {
     QJsonObject rootObject{
@@ -0,0 +1,570 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qbuffer.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qjsonstreamreader.h>
+#include <qjsonstreamwriter.h>
+
+class tst_QJsonStream : public QObject
+{
+    Q_OBJECT
+private slots:
+    void scalars_data();
+    void scalars();
+    void walkDocument();
+    void skipContainers();
+    void readValue_data() { documents_data(); }
+    void readValue();
+    void newlineDelimited();
+    void incrementalData_data();
+    void incrementalData();
+    void device();
+    void errors_data();
+    void errors();
+    void writer_data() { documents_data(); }
+    void writer();
+    void writerValues_data() { documents_data(); }
+    void writerValues();
+    void writerNewlineDelimited();
+    void writerDevice();
+
+private:
+    void documents_data();
+};
+
+void tst_QJsonStream::scalars_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonStreamReader::Type>("type");
+    QTest::addColumn<QJsonValue>("value");
+
+    QTest::newRow("null") << QByteArray("null") << QJsonStreamReader::Null << QJsonValue();
+    QTest::newRow("true") << QByteArray(" true ") << QJsonStreamReader::Bool << QJsonValue(true);
+    QTest::newRow("false") << QByteArray("false\n") << QJsonStreamReader::Bool << QJsonValue(false);
+    QTest::newRow("integer") << QByteArray("42") << QJsonStreamReader::Integer << QJsonValue(42);
+    QTest::newRow("negative") << QByteArray("-7 ") << QJsonStreamReader::Integer << QJsonValue(-7);
+    QTest::newRow("integral-double") << QByteArray("1.0") << QJsonStreamReader::Integer
+                                     << QJsonValue(1);
+    QTest::newRow("exponent") << QByteArray("1.5e3") << QJsonStreamReader::Integer
+                              << QJsonValue(1500);
+    QTest::newRow("double") << QByteArray("-0.25") << QJsonStreamReader::Double
+                            << QJsonValue(-0.25);
+    QTest::newRow("huge") << QByteArray("1e300") << QJsonStreamReader::Double
+                          << QJsonValue(1e300);
+    QTest::newRow("string") << QByteArray("\"hello\"") << QJsonStreamReader::String
+                            << QJsonValue("hello");
+    QTest::newRow("escaped-string") << QByteArray("\"a\\\"b\\\\c\\n\\u00e9\"")
+                                    << QJsonStreamReader::String
+                                    << QJsonValue(QLatin1String("a\"b\\c\n") + QChar(0xe9));
+    QTest::newRow("utf8-string") << QByteArray("\"caf\xc3\xa9\"") << QJsonStreamReader::String
+                                 << QJsonValue(QString::fromUtf8("caf\xc3\xa9"));
+}
+
+void tst_QJsonStream::scalars()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonStreamReader::Type, type);
+    QFETCH(QJsonValue, value);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.type(), type);
+    QVERIFY(reader.hasNext());
+    QCOMPARE(reader.containerDepth(), 0);
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Invalid);
+    switch (type) {
+    case QJsonStreamReader::Bool:
+        QCOMPARE(reader.toBool(), value.toBool());
+        break;
+    case QJsonStreamReader::Integer:
+        QCOMPARE(reader.toInteger(), value.toInteger());
+        QCOMPARE(reader.toDouble(), value.toDouble());
+        break;
+    case QJsonStreamReader::Double:
+        QCOMPARE(reader.toDouble(), value.toDouble());
+        break;
+    default:
+        break;
+    }
+
+    QJsonStreamReader second(json);
+    QCOMPARE(second.readValue(), value);
+    QVERIFY(!second.hasNext());
+    QCOMPARE(second.lastError().error, QJsonParseError::NoError);
+
+    if (type == QJsonStreamReader::String) {
+        QCOMPARE(reader.readString(), value.toString());
+    } else {
+        QVERIFY(reader.next());
+    }
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+}
+
+void tst_QJsonStream::walkDocument()
+{
+    QJsonStreamReader reader(QByteArray("{ \"name\": \"Qt\", \"list\": [1, 2.5, null],\n"
+                                        "  \"empty\": {}, \"flag\": true }"));
+
+    QVERIFY(reader.isObject());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.containerDepth(), 1);
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Object);
+
+    QVERIFY(reader.isKey());
+    QCOMPARE(reader.readString(), QString("name"));
+    QVERIFY(reader.isString());
+    QVERIFY(!reader.isKey());
+    QCOMPARE(reader.readString(), QString("Qt"));
+
+    QCOMPARE(reader.readString(), QString("list"));
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Array);
+    QVERIFY(reader.isInteger());
+    QCOMPARE(reader.toInteger(), qint64(1));
+    QVERIFY(reader.next());
+    QVERIFY(reader.isDouble());
+    QCOMPARE(reader.toDouble(), 2.5);
+    QVERIFY(reader.next());
+    QVERIFY(reader.isNull());
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.containerDepth(), 1);
+
+    QCOMPARE(reader.readString(), QString("empty"));
+    QVERIFY(reader.isObject());
+    QVERIFY(reader.enterContainer());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+
+    QCOMPARE(reader.readString(), QString("flag"));
+    QVERIFY(reader.isBool());
+    QCOMPARE(reader.toBool(), true);
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.containerDepth(), 0);
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+}
+
+void tst_QJsonStream::skipContainers()
+{
+    QJsonStreamReader reader(QByteArray("[ {\"a\": [1, \"]}\", {\"b\": {}}]}, [[[]]], 3, \"x\" ]"));
+
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.isObject());
+    QCOMPARE(reader.currentOffset(), qint64(2));
+    QVERIFY(reader.next());
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isInteger());
+    QCOMPARE(reader.toInteger(), qint64(3));
+
+    // leaving skips whatever is left
+    QVERIFY(reader.leaveContainer());
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+}
+
+void tst_QJsonStream::documents_data()
+{
+    QTest::addColumn<QJsonDocument>("document");
+
+    QJsonObject nested{
+        { "string", "text with \"quotes\", a \\ and a \t" },
+        { "unicode", QString::fromUtf8("\xe4\xbd\xa0\xe5\xa5\xbd \xf0\x9f\x98\x80") },
+        { "control", QString(QChar(1)) },
+        { "integer", 1234567890123LL },
+        { "double", 3.25 },
+        { "null", QJsonValue() },
+        { "bool", false },
+        { "emptyArray", QJsonArray() },
+        { "emptyObject", QJsonObject() },
+        { "array", QJsonArray{ 1, "two", QJsonArray{ 3 }, QJsonObject{ { "four", 4 } } } },
+    };
+    QJsonArray records;
+    for (int i = 0; i < 100; ++i)
+        records.append(QJsonObject{ { "id", i }, { "name", QString("record %1").arg(i) } });
+
+    QTest::newRow("empty-object") << QJsonDocument(QJsonObject());
+    QTest::newRow("empty-array") << QJsonDocument(QJsonArray());
+    QTest::newRow("object") << QJsonDocument(nested);
+    QTest::newRow("array") << QJsonDocument(QJsonArray{ nested, nested, QJsonArray() });
+    QTest::newRow("records") << QJsonDocument(records);
+}
+
+void tst_QJsonStream::readValue()
+{
+    QFETCH(QJsonDocument, document);
+
+    for (auto format : { QJsonDocument::Compact, QJsonDocument::Indented }) {
+        QJsonStreamReader reader(document.toJson(format));
+        const QJsonValue value = reader.readValue();
+        QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+        QVERIFY(!reader.hasNext());
+        if (document.isObject())
+            QCOMPARE(value.toObject(), document.object());
+        else
+            QCOMPARE(value.toArray(), document.array());
+
+        // the same, one element at a time
+        QJsonStreamReader elements(document.toJson(format));
+        QVERIFY(elements.enterContainer());
+        QJsonArray array;
+        QJsonObject object;
+        while (elements.hasNext()) {
+            if (document.isObject()) {
+                const QString key = elements.readString();
+                object.insert(key, elements.readValue());
+            } else {
+                array.append(elements.readValue());
+            }
+        }
+        QVERIFY(elements.leaveContainer());
+        QCOMPARE(elements.lastError().error, QJsonParseError::NoError);
+        if (document.isObject())
+            QCOMPARE(object, document.object());
+        else
+            QCOMPARE(array, document.array());
+    }
+}
+
+void tst_QJsonStream::newlineDelimited()
+{
+    QJsonStreamReader reader(QByteArray("{\"id\":1}\n{\"id\":2}\r\n\n[3]\n\"four\"\n5"));
+
+    QList<QJsonValue> values;
+    while (reader.hasNext())
+        values.append(reader.readValue());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(values, QList<QJsonValue>({ QJsonObject{ { "id", 1 } }, QJsonObject{ { "id", 2 } },
+                                         QJsonArray{ 3 }, "four", 5 }));
+}
+
+void tst_QJsonStream::incrementalData_data()
+{
+    QTest::addColumn<int>("chunkSize");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("3") << 3;
+    QTest::newRow("64") << 64;
+}
+
+void tst_QJsonStream::incrementalData()
+{
+    QFETCH(int, chunkSize);
+
+    QByteArray json;
+    QList<QJsonValue> expected;
+    for (int i = 0; i < 20; ++i) {
+        const QJsonObject object{ { "id", i }, { "name", QString("line \"%1\"").arg(i) },
+                                  { "values", QJsonArray{ i, i / 2., true, QJsonValue() } } };
+        json += QJsonDocument(object).toJson(QJsonDocument::Compact) + '\n';
+        expected.append(object);
+    }
+
+    QJsonStreamReader reader;
+    QList<QJsonValue> values;
+    for (int i = 0; i < json.size(); i += chunkSize) {
+        reader.addData(json.mid(i, chunkSize));
+        while (reader.hasNext()) {
+            const QJsonValue value = reader.readValue();
+            if (value.isUndefined())
+                break;
+            values.append(value);
+        }
+        if (reader.lastError().error != QJsonParseError::NoError)
+            QCOMPARE(reader.lastError().error, QJsonParseError::PrematureEndOfData);
+    }
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(values, expected);
+
+    // walking the tree works the same way, continuing after each failure
+    QJsonStreamReader walker;
+    int ids = 0;
+    bool isId = false;
+    for (qsizetype i = 0; ; ) {
+        if (walker.lastError().error == QJsonParseError::PrematureEndOfData
+                || (!walker.hasNext() && walker.containerDepth() == 0)) {
+            if (i >= json.size())
+                break;
+            walker.addData(json.mid(i, chunkSize));
+            i += chunkSize;
+            walker.reparse();
+            continue;
+        }
+        QCOMPARE(walker.lastError().error, QJsonParseError::NoError);
+
+        if (!walker.hasNext()) {
+            walker.leaveContainer();
+        } else if (walker.isContainer()) {
+            walker.enterContainer();
+        } else if (walker.isKey()) {
+            isId = walker.readString() == QLatin1String("id");
+        } else {
+            if (isId) {
+                QCOMPARE(walker.toInteger(), qint64(ids));
+                ++ids;
+                isId = false;
+            }
+            walker.next();
+        }
+    }
+    QCOMPARE(walker.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(walker.containerDepth(), 0);
+    QCOMPARE(ids, 20);
+}
+
+void tst_QJsonStream::device()
+{
+    // large enough that the reader has to read and discard data several times
+    QJsonArray records;
+    for (int i = 0; i < 20000; ++i) {
+        records.append(QJsonObject{ { "id", i }, { "name", QString("record %1").arg(i) },
+                                    { "tags", QJsonArray{ "a", "b" } } });
+    }
+    QByteArray json = QJsonDocument(records).toJson();
+    QVERIFY(json.size() > 1024 * 1024);
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+    QVERIFY(reader.enterContainer());
+    int count = 0;
+    while (reader.hasNext()) {
+        const QJsonValue value = reader.readValue();
+        QCOMPARE(value, records.at(count));
+        ++count;
+    }
+    QCOMPARE(count, records.size());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(reader.currentOffset(), qint64(json.size()));
+}
+
+void tst_QJsonStream::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+    QTest::addColumn<int>("offset");
+
+    QTest::newRow("missing-value-separator") << QByteArray("[1 2]")
+                                             << QJsonParseError::MissingValueSeparator << 3;
+    QTest::newRow("missing-name-separator") << QByteArray("{\"a\" 1}")
+                                            << QJsonParseError::MissingNameSeparator << 5;
+    QTest::newRow("trailing-comma") << QByteArray("[1, ]") << QJsonParseError::MissingObject << 4;
+    QTest::newRow("key-not-string") << QByteArray("{1: 2}")
+                                    << QJsonParseError::UnterminatedObject << 1;
+    QTest::newRow("bad-literal") << QByteArray("[tru]") << QJsonParseError::IllegalValue << 1;
+    QTest::newRow("bad-number") << QByteArray("[-]") << QJsonParseError::IllegalNumber << 1;
+    QTest::newRow("bad-utf8") << QByteArray("[\"\xff\"]") << QJsonParseError::IllegalUTF8String
+                              << 1;
+    QTest::newRow("bad-escape") << QByteArray("[\"\\u12\"]")
+                                << QJsonParseError::IllegalEscapeSequence << 2;
+    QTest::newRow("mismatched-bracket") << QByteArray("[[1}]")
+                                        << QJsonParseError::MissingValueSeparator << 3;
+    QTest::newRow("unterminated-array") << QByteArray("[[1, 2]")
+                                        << QJsonParseError::PrematureEndOfData << 7;
+    QTest::newRow("unterminated-string") << QByteArray("[\"abc")
+                                         << QJsonParseError::PrematureEndOfData << 5;
+}
+
+void tst_QJsonStream::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonParseError::ParseError, error);
+    QFETCH(int, offset);
+
+    // walking the whole tree and reading every value
+    QJsonStreamReader reader(json);
+    const std::function<void()> walk = [&]() {
+        while (reader.hasNext()) {
+            if (reader.isContainer()) {
+                if (!reader.enterContainer())
+                    return;
+                walk();
+                if (!reader.leaveContainer())
+                    return;
+            } else if (reader.readValue().isUndefined()) {
+                return;
+            }
+        }
+    };
+    walk();
+    QCOMPARE(reader.lastError().error, error);
+    QCOMPARE(reader.lastError().offset, offset);
+    QVERIFY(!reader.lastError().errorString().isEmpty());
+}
+
+static void writeValue(QJsonStreamWriter &writer, const QJsonValue &value)
+{
+    if (value.isObject()) {
+        const QJsonObject object = value.toObject();
+        writer.startObject();
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            writer.append(it.key());
+            writeValue(writer, it.value());
+        }
+        QVERIFY(writer.endObject());
+    } else if (value.isArray()) {
+        writer.startArray();
+        for (const QJsonValue &element : value.toArray())
+            writeValue(writer, element);
+        QVERIFY(writer.endArray());
+    } else if (value.isString()) {
+        writer.append(value.toString());
+    } else if (value.isBool()) {
+        writer.append(value.toBool());
+    } else if (value.isNull()) {
+        writer.appendNull();
+    } else if (value.isDouble() && value.toDouble() == double(value.toInteger())) {
+        writer.append(value.toInteger());
+    } else {
+        writer.append(value.toDouble());
+    }
+}
+
+void tst_QJsonStream::writer()
+{
+    QFETCH(QJsonDocument, document);
+
+    const QJsonValue value = document.isObject() ? QJsonValue(document.object())
+                                                 : QJsonValue(document.array());
+    for (auto format : { QJsonDocument::Compact, QJsonDocument::Indented }) {
+        QByteArray json;
+        QJsonStreamWriter writer(&json);
+        writer.setFormat(format);
+        QCOMPARE(writer.format(), format);
+        writeValue(writer, value);
+        QCOMPARE(json, document.toJson(format));
+
+        // and back
+        QJsonStreamReader reader(json);
+        QCOMPARE(reader.readValue(), value);
+    }
+}
+
+void tst_QJsonStream::writerValues()
+{
+    QFETCH(QJsonDocument, document);
+
+    const QJsonValue value = document.isObject() ? QJsonValue(document.object())
+                                                 : QJsonValue(document.array());
+    for (auto format : { QJsonDocument::Compact, QJsonDocument::Indented }) {
+        QByteArray json;
+        {
+            QJsonStreamWriter writer(&json);
+            writer.setFormat(format);
+            writer.append(value);
+        }
+        QCOMPARE(json, document.toJson(format));
+
+        // writing the elements as whole values, one level down
+        json.clear();
+        QJsonStreamWriter writer(&json);
+        writer.setFormat(format);
+        if (document.isObject()) {
+            writer.startObject();
+            const QJsonObject object = document.object();
+            for (auto it = object.begin(); it != object.end(); ++it) {
+                writer.append(it.key());
+                writer.append(it.value());
+            }
+            QVERIFY(writer.endObject());
+        } else {
+            writer.startArray();
+            for (const QJsonValue &element : document.array())
+                writer.append(element);
+            QVERIFY(writer.endArray());
+        }
+        QCOMPARE(json, document.toJson(format));
+    }
+}
+
+void tst_QJsonStream::writerNewlineDelimited()
+{
+    QByteArray json;
+    QJsonStreamWriter writer(&json);
+    writer.setFormat(QJsonDocument::Compact);
+    writer.startObject();
+    writer.append(QLatin1String("id"));
+    writer.append(1);
+    QVERIFY(!writer.endArray());
+    QVERIFY(writer.endObject());
+    writer.append(QJsonObject{ { "id", 2 } });
+    writer.append("three");
+    writer.append(nullptr);
+    writer.append(qInf());
+    QCOMPARE(json, QByteArray("{\"id\":1}\n{\"id\":2}\n\"three\"\nnull\nnull"));
+
+    json.clear();
+    QJsonStreamWriter indented(&json);
+    indented.append(1);
+    indented.startArray();
+    QVERIFY(indented.endArray());
+    QCOMPARE(json, QByteArray("1\n[\n]\n"));
+}
+
+void tst_QJsonStream::writerDevice()
+{
+    QByteArray json;
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+    {
+        QJsonStreamWriter writer(&buffer);
+        QCOMPARE(writer.device(), &buffer);
+        writer.setFormat(QJsonDocument::Compact);
+        writer.startArray();
+        writer.append(1);
+        // buffered until the top-level value is complete
+        QVERIFY(json.isEmpty());
+        writer.flush();
+        QCOMPARE(json, QByteArray("[1"));
+        for (int i = 0; i < 10000; ++i)
+            writer.append(QLatin1String("some text"));
+        // but not all of it
+        QVERIFY(json.size() > 16 * 1024);
+        QVERIFY(writer.endArray());
+        writer.startObject();
+    }
+    // the destructor writes what is left
+    QVERIFY(json.endsWith("\"some text\"]\n{"));
+}
+
+QTEST_APPLESS_MAIN(tst_QJsonStream)
+#include "tst_qjsonstream.moc"
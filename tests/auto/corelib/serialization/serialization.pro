@@ -7,6 +7,7 @@ SUBDIRS = \
     qcborvalue_json \
     qdatastream \
     qdatastream_core_pixmap \
+    qjsonstream \
     qtextstream \
     qxmlstream
 
@@ -0,0 +1,215 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qsmallstring.h>
+#include <qhash.h>
+
+class tst_QSmallString : public QObject
+{
+    Q_OBJECT
+private slots:
+    void defaultConstructed();
+    void construct_data();
+    void construct();
+    void fromLatin1_data();
+    void fromLatin1();
+    void sharesLongString();
+    void copyAndMove();
+    void swap();
+    void compare();
+    void hash();
+};
+
+void tst_QSmallString::defaultConstructed()
+{
+    QSmallString s;
+    QVERIFY(s.isInline());
+    QVERIFY(s.isEmpty());
+    QCOMPARE(s.size(), 0);
+    QCOMPARE(s.toString(), QString());
+    QCOMPARE(s.begin(), s.end());
+}
+
+void tst_QSmallString::construct_data()
+{
+    QTest::addColumn<QString>("str");
+    QTest::addColumn<bool>("inlined");
+
+    QTest::newRow("empty") << QString() << true;
+    QTest::newRow("one") << QStringLiteral("a") << true;
+    QTest::newRow("key") << QStringLiteral("objectName") << true;
+    QTest::newRow("full") << QString(QSmallString::InlineCapacity, QLatin1Char('x')) << true;
+    QTest::newRow("overfull") << QString(QSmallString::InlineCapacity + 1, QLatin1Char('x')) << false;
+    QTest::newRow("long") << QStringLiteral("Content-Security-Policy-Report-Only") << false;
+    QTest::newRow("non-latin1") << QString::fromUtf8("\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e") << true;
+}
+
+void tst_QSmallString::construct()
+{
+    QFETCH(QString, str);
+    QFETCH(bool, inlined);
+
+    const QSmallString fromView(QStringView{str});
+    QCOMPARE(fromView.isInline(), inlined);
+    QCOMPARE(fromView.size(), str.size());
+    QCOMPARE(fromView.toString(), str);
+    QCOMPARE(fromView.view(), QStringView(str));
+
+    const QSmallString fromString(str);
+    QCOMPARE(fromString.isInline(), inlined);
+    QCOMPARE(fromString.toString(), str);
+
+    QString copy = str;
+    const QSmallString fromRvalue(std::move(copy));
+    QCOMPARE(fromRvalue.isInline(), inlined);
+    QCOMPARE(fromRvalue.toString(), str);
+
+    for (qsizetype i = 0; i < str.size(); ++i)
+        QCOMPARE(fromString.at(i), str.at(i));
+    QCOMPARE(fromString.end() - fromString.begin(), str.size());
+}
+
+void tst_QSmallString::fromLatin1_data()
+{
+    QTest::addColumn<QByteArray>("latin1");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("short") << QByteArray("width");
+    QTest::newRow("accents") << QByteArray("caf\xe9");
+    QTest::newRow("long") << QByteArray("Access-Control-Allow-Origin");
+}
+
+void tst_QSmallString::fromLatin1()
+{
+    QFETCH(QByteArray, latin1);
+
+    const QLatin1String l1(latin1);
+    const QSmallString s(l1);
+    QCOMPARE(s.isInline(), latin1.size() <= QSmallString::InlineCapacity);
+    QCOMPARE(s.toString(), QString(l1));
+    QVERIFY(s == l1);
+    QVERIFY(l1 == s);
+}
+
+void tst_QSmallString::sharesLongString()
+{
+    const QString str = QStringLiteral("a string that does not fit inline");
+    QString detached = str;
+    detached.detach();
+
+    const QSmallString s(detached);
+    QVERIFY(!s.isInline());
+    QCOMPARE(s.constData(), detached.constData());
+    QCOMPARE(s.toString().constData(), detached.constData());
+}
+
+void tst_QSmallString::copyAndMove()
+{
+    const QString longStr = QStringLiteral("a string that does not fit inline");
+    for (const QString &str : { QStringLiteral("short"), longStr }) {
+        QSmallString s(str);
+        QSmallString copy(s);
+        QCOMPARE(copy, s);
+        QCOMPARE(copy.isInline(), s.isInline());
+
+        QSmallString moved(std::move(copy));
+        QCOMPARE(moved, s);
+        QVERIFY(copy.isEmpty());
+
+        QSmallString assigned;
+        assigned = moved;
+        QCOMPARE(assigned, s);
+        assigned = std::move(moved);
+        QCOMPARE(assigned, s);
+        QVERIFY(moved.isEmpty());
+
+        assigned = assigned;
+        QCOMPARE(assigned.toString(), str);
+
+        assigned.clear();
+        QVERIFY(assigned.isEmpty());
+        QVERIFY(assigned.isInline());
+    }
+}
+
+void tst_QSmallString::swap()
+{
+    QSmallString a(QStringLiteral("short"));
+    QSmallString b(QStringLiteral("a string that does not fit inline"));
+    a.swap(b);
+    QVERIFY(!a.isInline());
+    QVERIFY(b.isInline());
+    QCOMPARE(a.toString(), QStringLiteral("a string that does not fit inline"));
+    QCOMPARE(b.toString(), QStringLiteral("short"));
+    std::swap(a, b);
+    QCOMPARE(a.toString(), QStringLiteral("short"));
+}
+
+void tst_QSmallString::compare()
+{
+    const QSmallString a(QStringLiteral("apple"));
+    const QSmallString b(QStringLiteral("banana"));
+    const QString apple = QStringLiteral("apple");
+
+    QVERIFY(a == a);
+    QVERIFY(a != b);
+    QVERIFY(a < b);
+    QVERIFY(b > a);
+    QVERIFY(a <= a);
+    QVERIFY(b >= a);
+
+    QVERIFY(a == QStringView(apple));
+    QVERIFY(QStringView(apple) == a);
+    QVERIFY(a == apple);
+    QVERIFY(apple == a);
+    QVERIFY(b != apple);
+    QVERIFY(a == QLatin1String("apple"));
+    QVERIFY(QLatin1String("banana") != a);
+
+    QVERIFY(apple.startsWith(a));
+    QCOMPARE(QStringView(a).indexOf(u'p'), 1);
+}
+
+void tst_QSmallString::hash()
+{
+    const QString str = QStringLiteral("margin");
+    QCOMPARE(qHash(QSmallString(str)), qHash(str));
+    QCOMPARE(qHash(QSmallString(str), 42), qHash(str, 42));
+
+    QHash<QSmallString, int> hash;
+    hash.insert(QSmallString(QStringLiteral("top")), 1);
+    hash.insert(QSmallString(QStringLiteral("a rather long key")), 2);
+    QCOMPARE(hash.value(QSmallString(QLatin1String("top"))), 1);
+    QCOMPARE(hash.value(QSmallString(QLatin1String("a rather long key"))), 2);
+}
+
+QTEST_APPLESS_MAIN(tst_QSmallString)
+#include "tst_qsmallstring.moc"
@@ -57,6 +57,12 @@ private slots:
     void utf8stateful_data();
     void utf8stateful();
 
+    void utf8LongText_data();
+    void utf8LongText();
+
+    void convertToBuffer_data();
+    void convertToBuffer();
+
     void utfHeaders_data();
     void utfHeaders();
 
@@ -1417,6 +1423,153 @@ void tst_QStringConverter::utf8stateful()
     }
 }
 
+void tst_QStringConverter::utf8LongText_data()
+{
+    QTest::addColumn<QString>("text");
+
+    // long enough for the SIMD code, with the non-ASCII characters at every
+    // offset in the blocks it converts
+    const auto repeat = [](const QString &sample) {
+        const auto ucs4 = sample.toUcs4();
+        QString result;
+        for (int i = 0; result.size() < 300; ++i)
+            result += QString::fromUcs4(ucs4.constData(), i % ucs4.size() + 1) + QLatin1Char(' ');
+        return result;
+    };
+
+    QTest::newRow("latin1") << repeat(QString::fromUtf8("Zwölf Boxkämpfer über den großen Deich"));
+    QTest::newRow("cyrillic") << repeat(QString::fromUtf8("Съешь же ещё этих мягких французских булок"));
+    QTest::newRow("chinese") << repeat(QString::fromUtf8("我能吞下玻璃而不伤身体天地玄黄宇宙洪荒"));
+    QTest::newRow("mixed") << repeat(QString::fromUtf8("aя€bж我ĉ߿ࠀ￿d"));
+    QTest::newRow("emoji") << repeat(QString::fromUtf8("Привет 🎉 мир 🚀 你好 ✅ \U0010ffff"));
+}
+
+void tst_QStringConverter::utf8LongText()
+{
+    QFETCH(QString, text);
+
+    QByteArray utf8;
+    for (char32_t c : text.toUcs4()) {
+        if (c < 0x80) {
+            utf8 += char(c);
+        } else if (c < 0x800) {
+            utf8 += char(0xc0 | c >> 6);
+            utf8 += char(0x80 | (c & 0x3f));
+        } else if (c < 0x10000) {
+            utf8 += char(0xe0 | c >> 12);
+            utf8 += char(0x80 | ((c >> 6) & 0x3f));
+            utf8 += char(0x80 | (c & 0x3f));
+        } else {
+            utf8 += char(0xf0 | c >> 18);
+            utf8 += char(0x80 | ((c >> 12) & 0x3f));
+            utf8 += char(0x80 | ((c >> 6) & 0x3f));
+            utf8 += char(0x80 | (c & 0x3f));
+        }
+    }
+
+    QCOMPARE(text.toUtf8(), utf8);
+    QCOMPARE(QString::fromUtf8(utf8), text);
+
+    QStringEncoder encoder(QStringEncoder::Utf8);
+    QByteArray encoded = encoder(text);
+    QVERIFY(!encoder.hasError());
+    QCOMPARE(encoded, utf8);
+
+    QStringDecoder decoder(QStringDecoder::Utf8);
+    QString decoded = decoder(utf8);
+    QVERIFY(!decoder.hasError());
+    QCOMPARE(decoded, text);
+
+    // an invalid byte between two characters becomes one replacement character
+    for (qsizetype i = 0, pos = 0; i < text.size(); ++i) {
+        if (text.at(i).isLowSurrogate())
+            continue;
+        const QString expected = text.left(i) + QChar(QChar::ReplacementCharacter) + text.mid(i);
+        for (char invalid : { '\x80', '\xff' }) {
+            QByteArray data = utf8;
+            data.insert(pos, invalid);
+            QStringDecoder decoder(QStringDecoder::Utf8, QStringDecoder::Flag::Stateless);
+            QCOMPARE(decoder(data), expected);
+            QVERIFY(decoder.hasError());
+        }
+        pos += text.at(i).unicode() < 0x80 ? 1 : text.at(i).unicode() < 0x800 ? 2
+                : text.at(i).isHighSurrogate() ? 4 : 3;
+    }
+}
+
+void tst_QStringConverter::convertToBuffer_data()
+{
+    QTest::addColumn<QStringConverter::Encoding>("encoding");
+    QTest::addColumn<int>("bufferSize");
+
+    const QStringConverter::Encoding encodings[] = {
+        QStringConverter::Utf8, QStringConverter::Utf16LE, QStringConverter::Utf32BE,
+        QStringConverter::Latin1
+    };
+    for (QStringConverter::Encoding encoding : encodings) {
+        for (int bufferSize : { 16, 17, 64, 1000 }) {
+            const QByteArray name = QStringConverter::nameForEncoding(encoding)
+                    + QByteArray("-") + QByteArray::number(bufferSize);
+            QTest::newRow(name.constData()) << encoding << bufferSize;
+        }
+    }
+}
+
+void tst_QStringConverter::convertToBuffer()
+{
+    QFETCH(QStringConverter::Encoding, encoding);
+    QFETCH(int, bufferSize);
+
+    QString text;
+    while (text.size() < 1000)
+        text += QString::fromUtf8("Hello, world! Привет, мир! 你好，世界！ 🎉🚀 ");
+    if (encoding == QStringConverter::Latin1)
+        text = QString::fromLatin1(text.toLatin1());
+
+    // the chunks must not be larger than the buffer and must add up to the
+    // same data as converting everything at once
+    QByteArray encoded;
+    {
+        QStringEncoder encoder(encoding, QStringConverter::Flag::Stateless);
+        QByteArray buffer(bufferSize, '\0');
+        QStringView in = text;
+        while (!in.isEmpty()) {
+            const QStringConverter::ConversionResult result =
+                    encoder.encodeToBuffer(buffer.data(), buffer.size(), in);
+            QVERIFY(result.consumed > 0);
+            QVERIFY(result.written <= bufferSize);
+            encoded += QByteArray(buffer.constData(), result.written);
+            in = in.mid(result.consumed);
+        }
+        QVERIFY(!encoder.hasError());
+        QCOMPARE(encoded, QByteArray(QStringEncoder(encoding)(text)));
+    }
+
+    {
+        QStringDecoder decoder(encoding);
+        QVarLengthArray<QChar> buffer(bufferSize);
+        QString decoded;
+        for (qsizetype i = 0; i < encoded.size(); ) {
+            const QStringConverter::ConversionResult result =
+                    decoder.decodeToBuffer(buffer.data(), buffer.size(),
+                                           encoded.constData() + i, encoded.size() - i);
+            QVERIFY(result.consumed > 0);
+            QVERIFY(result.written <= bufferSize);
+            decoded += QStringView(buffer.constData(), result.written);
+            i += result.consumed;
+        }
+        QVERIFY(!decoder.hasError());
+        QCOMPARE(decoded, text);
+    }
+
+    // a buffer that is too small for anything consumes nothing
+    QStringEncoder encoder(encoding);
+    char byte;
+    QStringConverter::ConversionResult result = encoder.encodeToBuffer(&byte, 1, text);
+    QCOMPARE(result.consumed, 0);
+    QCOMPARE(result.written, 0);
+}
+
 void tst_QStringConverter::utfHeaders_data()
 {
     QTest::addColumn<QStringConverter::Encoding>("encoding");
@@ -0,0 +1,201 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qhash.h>
+#include <qstringpool.h>
+#include <qthread.h>
+
+#include <memory>
+#include <vector>
+
+class tst_QStringPool : public QObject
+{
+    Q_OBJECT
+private slots:
+    void nullAtom();
+    void atom();
+    void intern();
+    void latin1();
+    void find();
+    void hash();
+    void atomAsKey();
+    void concurrentAtoms();
+    void globalInstance();
+};
+
+void tst_QStringPool::nullAtom()
+{
+    const QStringAtom atom;
+    QVERIFY(atom.isNull());
+    QVERIFY(atom.isEmpty());
+    QCOMPARE(atom.size(), 0);
+    QVERIFY(atom.toString().isNull());
+    QCOMPARE(atom, QStringAtom());
+
+    QStringPool pool;
+    const QStringAtom empty = pool.atom(QStringView(u""));
+    QVERIFY(!empty.isNull());
+    QVERIFY(empty.isEmpty());
+    QVERIFY(empty != atom);
+}
+
+void tst_QStringPool::atom()
+{
+    QStringPool pool;
+    QCOMPARE(pool.size(), 0);
+
+    const QString width = QStringLiteral("width");
+    const QStringAtom a = pool.atom(width);
+    const QStringAtom b = pool.atom(QString(width.constData(), width.size()));
+    const QStringAtom c = pool.atom(QStringLiteral("height"));
+
+    QVERIFY(!a.isNull());
+    QCOMPARE(a, b);
+    QVERIFY(a != c);
+    QCOMPARE(a.view(), QStringView(width));
+    QCOMPARE(a.size(), width.size());
+    QCOMPARE(c.toString(), QStringLiteral("height"));
+    QCOMPARE(pool.size(), 2);
+}
+
+void tst_QStringPool::intern()
+{
+    QStringPool pool;
+
+    QString first = QStringLiteral("application/json");
+    first.detach();
+    const QString a = pool.intern(first);
+    const QString b = pool.intern(QStringView(u"application/json"));
+
+    QCOMPARE(a, first);
+    QCOMPARE(a.constData(), b.constData());
+    QVERIFY(a.isSharedWith(b));
+    // the pool keeps its own copy
+    QVERIFY(a.constData() != first.constData());
+    first[0] = u'A';
+    QCOMPARE(b, QStringLiteral("application/json"));
+
+    QCOMPARE(pool.atom(a).toString().constData(), a.constData());
+}
+
+void tst_QStringPool::latin1()
+{
+    QStringPool pool;
+    const QStringAtom a = pool.atom(QLatin1String("Content-Type"));
+    QCOMPARE(a, pool.atom(QStringView(u"Content-Type")));
+    QCOMPARE(pool.intern(QLatin1String("caf\xe9")), QString::fromUtf8("caf\xc3\xa9"));
+    QCOMPARE(pool.size(), 2);
+}
+
+void tst_QStringPool::find()
+{
+    QStringPool pool;
+    QVERIFY(pool.find(u"x").isNull());
+    QCOMPARE(pool.size(), 0);
+
+    const QStringAtom x = pool.atom(QStringView(u"x"));
+    QCOMPARE(pool.find(u"x"), x);
+    QVERIFY(pool.find(u"y").isNull());
+}
+
+void tst_QStringPool::hash()
+{
+    QStringPool pool;
+    const QString str = QStringLiteral("objectName");
+    const QStringAtom atom = pool.atom(str);
+    QCOMPARE(atom.hash(), qHash(str, size_t(qGlobalQHashSeed())));
+    QCOMPARE(qHash(atom, 42), qHash(pool.atom(str), 42));
+    QCOMPARE(qHash(atom, 42), qHash(atom.hash(), 42));
+
+    // the seed is mixed into the hash value, so that atoms whose hash values
+    // fall into the same bucket for one seed don't necessarily do for others
+    QVERIFY(qHash(atom, 1) != (qHash(atom, 0) ^ 1));
+
+    // a pool keeps the seed it was created with
+    qSetGlobalQHashSeed(0);
+    const size_t poolSeed = size_t(qGlobalQHashSeed());
+    QStringPool otherPool;
+    qSetGlobalQHashSeed(-1);
+    const QStringAtom otherAtom = otherPool.atom(str);
+    QCOMPARE(otherAtom.hash(), qHash(str, poolSeed));
+    QCOMPARE(otherPool.find(str), otherAtom);
+}
+
+void tst_QStringPool::atomAsKey()
+{
+    QStringPool pool;
+    QHash<QStringAtom, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(pool.atom(QString::number(i)), i);
+    QCOMPARE(hash.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(pool.atom(QString::number(i)), -1), i);
+    QCOMPARE(hash.value(pool.atom(QStringView(u"100")), -1), -1);
+}
+
+void tst_QStringPool::concurrentAtoms()
+{
+    QStringPool pool;
+    enum { ThreadCount = 4, KeyCount = 1000 };
+
+    QStringAtom atoms[ThreadCount][KeyCount];
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back(QThread::create([&pool, &atoms, t] {
+            // every thread adds the same keys, starting at a different one
+            for (int i = 0; i < KeyCount; ++i) {
+                const int key = (i + t * KeyCount / ThreadCount) % KeyCount;
+                atoms[t][key] = pool.atom(QString::number(key));
+            }
+        }));
+        threads.back()->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(pool.size(), KeyCount);
+    for (int i = 0; i < KeyCount; ++i) {
+        QCOMPARE(atoms[0][i].toString(), QString::number(i));
+        for (int t = 1; t < ThreadCount; ++t)
+            QCOMPARE(atoms[t][i], atoms[0][i]);
+    }
+}
+
+void tst_QStringPool::globalInstance()
+{
+    QStringPool *pool = QStringPool::globalInstance();
+    QVERIFY(pool);
+    QCOMPARE(QStringPool::globalInstance(), pool);
+    QCOMPARE(pool->atom(QStringView(u"global")), QStringPool::globalInstance()->atom(QStringView(u"global")));
+}
+
+QTEST_APPLESS_MAIN(tst_QStringPool)
+#include "tst_qstringpool.moc"
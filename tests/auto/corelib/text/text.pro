@@ -11,6 +11,7 @@ SUBDIRS = \
     qlocale \
     qregexp \
     qregularexpression \
+    qsmallstring \
     qstring \
     qstring_no_cast_from_bytearray \
     qstringapisymmetry \
@@ -19,6 +20,7 @@ SUBDIRS = \
     qstringiterator \
     qstringlist \
     qstringmatcher \
+    qstringpool \
     qstringref \
     qstringtokenizer \
     qstringview \
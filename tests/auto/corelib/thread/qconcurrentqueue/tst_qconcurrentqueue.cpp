@@ -0,0 +1,319 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qconcurrentqueue.h>
+#include <qthread.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+class tst_QConcurrentQueue : public QObject
+{
+    Q_OBJECT
+private slots:
+    void capacity();
+    void fifo_data();
+    void fifo();
+    void moveOnly_data() { fifo_data(); }
+    void moveOnly();
+    void destroysValues_data() { fifo_data(); }
+    void destroysValues();
+    void timeout_data() { fifo_data(); }
+    void timeout();
+#ifndef QT_NO_EXCEPTIONS
+    void throwingCopy_data() { fifo_data(); }
+    void throwingCopy();
+#endif
+    void spscTransfer();
+    void mpmcTransfer();
+
+private:
+    template <template <typename> class Queue> void fifo_impl();
+    template <template <typename> class Queue> void moveOnly_impl();
+    template <template <typename> class Queue> void destroysValues_impl();
+    template <template <typename> class Queue> void timeout_impl();
+#ifndef QT_NO_EXCEPTIONS
+    template <template <typename> class Queue> void throwingCopy_impl();
+#endif
+};
+
+void tst_QConcurrentQueue::capacity()
+{
+    QCOMPARE(QSpscQueue<int>(1).capacity(), 2);
+    QCOMPARE(QSpscQueue<int>(8).capacity(), 8);
+    QCOMPARE(QSpscQueue<int>(9).capacity(), 16);
+    QCOMPARE(QMpmcQueue<int>(1000).capacity(), 1024);
+}
+
+void tst_QConcurrentQueue::fifo_data()
+{
+    QTest::addColumn<bool>("mpmc");
+    QTest::newRow("spsc") << false;
+    QTest::newRow("mpmc") << true;
+}
+
+template <template <typename> class Queue>
+void tst_QConcurrentQueue::fifo_impl()
+{
+    Queue<int> queue(4);
+    QVERIFY(queue.isEmpty());
+
+    int value = -1;
+    QVERIFY(!queue.tryPop(&value));
+    QCOMPARE(value, -1);
+
+    // go around the ring a few times
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i)
+            QVERIFY(queue.tryPush(round * 10 + i));
+        QVERIFY(!queue.tryPush(99));
+        QCOMPARE(queue.size(), 4);
+
+        for (int i = 0; i < 4; ++i) {
+            QVERIFY(queue.tryPop(&value));
+            QCOMPARE(value, round * 10 + i);
+        }
+        QVERIFY(!queue.tryPop(&value));
+        QVERIFY(queue.isEmpty());
+    }
+}
+
+void tst_QConcurrentQueue::fifo()
+{
+    QFETCH(bool, mpmc);
+    if (mpmc)
+        fifo_impl<QMpmcQueue>();
+    else
+        fifo_impl<QSpscQueue>();
+}
+
+template <template <typename> class Queue>
+void tst_QConcurrentQueue::moveOnly_impl()
+{
+    Queue<std::unique_ptr<int>> queue(2);
+    std::unique_ptr<int> p(new int(42));
+    QVERIFY(queue.tryPush(std::move(p)));
+    QVERIFY(!p);
+    QVERIFY(queue.tryPush(std::unique_ptr<int>(new int(43))));
+
+    // a failed push leaves the value alone
+    std::unique_ptr<int> rejected(new int(44));
+    QVERIFY(!queue.tryPush(std::move(rejected)));
+    QVERIFY(rejected);
+
+    std::unique_ptr<int> out;
+    QVERIFY(queue.pop(&out));
+    QCOMPARE(*out, 42);
+    QVERIFY(queue.pop(&out));
+    QCOMPARE(*out, 43);
+}
+
+void tst_QConcurrentQueue::moveOnly()
+{
+    QFETCH(bool, mpmc);
+    if (mpmc)
+        moveOnly_impl<QMpmcQueue>();
+    else
+        moveOnly_impl<QSpscQueue>();
+}
+
+template <template <typename> class Queue>
+void tst_QConcurrentQueue::destroysValues_impl()
+{
+    auto value = std::make_shared<int>(0);
+    {
+        Queue<std::shared_ptr<int>> queue(8);
+        for (int i = 0; i < 5; ++i)
+            QVERIFY(queue.tryPush(value));
+        std::shared_ptr<int> out;
+        QVERIFY(queue.tryPop(&out));
+        out.reset();
+        QCOMPARE(value.use_count(), 5);
+    }
+    QCOMPARE(value.use_count(), 1);
+}
+
+void tst_QConcurrentQueue::destroysValues()
+{
+    QFETCH(bool, mpmc);
+    if (mpmc)
+        destroysValues_impl<QMpmcQueue>();
+    else
+        destroysValues_impl<QSpscQueue>();
+}
+
+template <template <typename> class Queue>
+void tst_QConcurrentQueue::timeout_impl()
+{
+    Queue<int> queue(2);
+    int value;
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(!queue.pop(&value, QDeadlineTimer(50)));
+    QVERIFY(timer.elapsed() >= 40);
+
+    QVERIFY(queue.push(1, QDeadlineTimer(0)));
+    QVERIFY(queue.push(2, QDeadlineTimer(50)));
+    timer.restart();
+    QVERIFY(!queue.push(3, QDeadlineTimer(50)));
+    QVERIFY(timer.elapsed() >= 40);
+
+    QVERIFY(queue.pop(&value, QDeadlineTimer(0)));
+    QCOMPARE(value, 1);
+}
+
+void tst_QConcurrentQueue::timeout()
+{
+    QFETCH(bool, mpmc);
+    if (mpmc)
+        timeout_impl<QMpmcQueue>();
+    else
+        timeout_impl<QSpscQueue>();
+}
+
+#ifndef QT_NO_EXCEPTIONS
+struct ThrowingCopy
+{
+    int value;
+    bool throwOnCopy;
+
+    explicit ThrowingCopy(int value, bool throwOnCopy = false)
+        : value(value), throwOnCopy(throwOnCopy)
+    {}
+    ThrowingCopy(const ThrowingCopy &other)
+        : value(other.value), throwOnCopy(false)
+    {
+        if (other.throwOnCopy)
+            throw std::runtime_error("copy");
+    }
+    ThrowingCopy(ThrowingCopy &&other) noexcept = default;
+    ThrowingCopy &operator=(ThrowingCopy &&other) noexcept = default;
+};
+
+template <template <typename> class Queue>
+void tst_QConcurrentQueue::throwingCopy_impl()
+{
+    // a failed copy must not leave a slot behind that nobody fills
+    Queue<ThrowingCopy> queue(2);
+    const ThrowingCopy bad(1, true);
+    QVERIFY_EXCEPTION_THROWN(queue.tryPush(bad), std::runtime_error);
+    QVERIFY(queue.isEmpty());
+
+    const ThrowingCopy good(2);
+    QVERIFY(queue.tryPush(good));
+    QVERIFY(queue.tryPush(ThrowingCopy(3)));
+    QVERIFY(!queue.tryPush(good));
+
+    ThrowingCopy value(0);
+    QVERIFY(queue.tryPop(&value));
+    QCOMPARE(value.value, 2);
+    QVERIFY(queue.tryPop(&value));
+    QCOMPARE(value.value, 3);
+    QVERIFY(!queue.tryPop(&value));
+}
+
+void tst_QConcurrentQueue::throwingCopy()
+{
+    QFETCH(bool, mpmc);
+    if (mpmc)
+        throwingCopy_impl<QMpmcQueue>();
+    else
+        throwingCopy_impl<QSpscQueue>();
+}
+#endif
+
+void tst_QConcurrentQueue::spscTransfer()
+{
+    enum { Count = 100000 };
+    // a small queue makes both threads block often
+    QSpscQueue<int> queue(4);
+
+    std::unique_ptr<QThread> producer(QThread::create([&queue] {
+        for (int i = 0; i < Count; ++i)
+            queue.push(i);
+    }));
+    producer->start();
+
+    bool inOrder = true;
+    for (int i = 0; i < Count; ++i) {
+        int value;
+        queue.pop(&value);
+        inOrder = inOrder && value == i;
+    }
+    QVERIFY(producer->wait());
+    QVERIFY(inOrder);
+    QVERIFY(queue.isEmpty());
+}
+
+void tst_QConcurrentQueue::mpmcTransfer()
+{
+    enum { ThreadCount = 4, CountPerThread = 25000 };
+    QMpmcQueue<int> queue(8);
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back(QThread::create([&queue, t] {
+            for (int i = 0; i < CountPerThread; ++i)
+                queue.push(t * CountPerThread + i);
+        }));
+        threads.back()->start();
+    }
+
+    QAtomicInteger<qint64> sum = 0;
+    std::vector<std::vector<bool>> seen(ThreadCount, std::vector<bool>(ThreadCount * CountPerThread));
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back(QThread::create([&queue, &sum, &seen, t] {
+            for (int i = 0; i < CountPerThread; ++i) {
+                int value;
+                queue.pop(&value);
+                seen[t][value] = true;
+                sum.fetchAndAddRelaxed(value);
+            }
+        }));
+        threads.back()->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    const qint64 n = ThreadCount * CountPerThread;
+    QCOMPARE(sum.loadRelaxed(), n * (n - 1) / 2);
+    for (int value = 0; value < n; ++value) {
+        int count = 0;
+        for (int t = 0; t < ThreadCount; ++t)
+            count += seen[t][value];
+        QCOMPARE(count, 1);
+    }
+    QVERIFY(queue.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(tst_QConcurrentQueue)
+#include "tst_qconcurrentqueue.moc"
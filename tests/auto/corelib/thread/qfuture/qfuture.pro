@@ -3,3 +3,4 @@ TARGET = tst_qfuture
 QT = core core-private testlib
 SOURCES = tst_qfuture.cpp
 DEFINES -= QT_NO_JAVA_STYLE_ITERATORS
+contains(QT_CONFIG, c++2a): CONFIG += c++2a
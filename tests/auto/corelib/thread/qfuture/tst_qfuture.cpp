@@ -127,6 +127,7 @@ private slots:
 
     void then();
     void thenForMoveOnlyTypes();
+    void thenForOverAlignedCaptures();
     void thenOnCanceledFuture();
 #ifndef QT_NO_EXCEPTIONS
     void thenOnExceptionFuture();
@@ -144,6 +145,13 @@ private slots:
     void takeResultWorksForTypesWithoutDefaultCtor();
     void canceledFutureIsNotValid();
     void signalConnect();
+    void coroutines();
+    void coroutinesForMoveOnlyTypes();
+    void coroutineResumeOn();
+    void coroutineCancellation();
+#ifndef QT_NO_EXCEPTIONS
+    void coroutineExceptions();
+#endif
 
 private:
     using size_type = std::vector<int>::size_type;
@@ -2037,6 +2045,34 @@ void tst_QFuture::thenForMoveOnlyTypes()
     QVERIFY(runThenForMoveOnly<void>([] { return std::make_unique<int>(42); }));
 }
 
+void tst_QFuture::thenForOverAlignedCaptures()
+{
+    struct alignas(128) OverAligned
+    {
+        int value = 42;
+    };
+
+    // several times, so that recycled memory would be used, too
+    for (int i = 0; i < 4; ++i) {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+
+        const OverAligned captured;
+        bool aligned = false;
+        int value = 0;
+        auto then = promise.future().then([captured, &aligned, &value](int) {
+            aligned = quintptr(&captured) % alignof(OverAligned) == 0;
+            value = captured.value;
+        });
+
+        promise.reportResult(1);
+        promise.reportFinished();
+        then.waitForFinished();
+        QVERIFY(aligned);
+        QCOMPARE(value, 42);
+    }
+}
+
 template<class T>
 QFuture<T> createCanceledFuture()
 {
@@ -3066,5 +3102,231 @@ void tst_QFuture::signalConnect()
     }
 }
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+static QFuture<int> finishedFuture(int value)
+{
+    QFutureInterface<int> promise;
+    promise.reportStarted();
+    promise.reportResult(value);
+    promise.reportFinished();
+    return promise.future();
+}
+
+static QFuture<void> finishedFuture()
+{
+    QFutureInterface<void> promise;
+    promise.reportStarted();
+    promise.reportFinished();
+    return promise.future();
+}
+
+static QFuture<int> coroutineAdd(QFuture<int> a, QFuture<int> b)
+{
+    co_return co_await a + co_await b;
+}
+
+static QFuture<void> coroutineStore(QFuture<int> future, int *stored)
+{
+    *stored = co_await future;
+}
+
+static QFuture<UniquePtr> coroutineTakeUnique(QFuture<UniquePtr> future)
+{
+    UniquePtr value = co_await future;
+    ++*value;
+    co_return value;
+}
+
+static QFuture<QThread *> coroutineThreadAfter(QtPrivate::FutureAwaiter<void> awaiter)
+{
+    co_await awaiter;
+    co_return QThread::currentThread();
+}
+
+#ifndef QT_NO_EXCEPTIONS
+static QFuture<int> coroutineCatch(QFuture<int> future)
+{
+    try {
+        co_return co_await future;
+    } catch (const QException &) {
+        co_return -1;
+    }
+}
+#endif
+#endif
+
+void tst_QFuture::coroutines()
+{
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    // finished futures do not suspend the coroutine
+    {
+        auto future = coroutineAdd(finishedFuture(1), finishedFuture(2));
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.result(), 3);
+    }
+
+    // the coroutine continues when the awaited futures finish
+    {
+        QFutureInterface<int> a;
+        QFutureInterface<int> b;
+        a.reportStarted();
+        b.reportStarted();
+
+        auto future = coroutineAdd(a.future(), b.future());
+        QVERIFY(future.isStarted());
+        QVERIFY(!future.isFinished());
+
+        a.reportResult(20);
+        a.reportFinished();
+        QVERIFY(!future.isFinished());
+        b.reportResult(22);
+        b.reportFinished();
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.result(), 42);
+    }
+
+    // awaiting a future finished in another thread
+    {
+        int stored = 0;
+        auto future = coroutineStore(QtConcurrent::run([] { return 42; }), &stored);
+        future.waitForFinished();
+        QCOMPARE(stored, 42);
+    }
+#else
+    QSKIP("This test requires C++20 coroutine support.");
+#endif
+}
+
+void tst_QFuture::coroutinesForMoveOnlyTypes()
+{
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    QFutureInterface<UniquePtr> promise;
+    promise.reportStarted();
+
+    auto future = coroutineTakeUnique(promise.future());
+    promise.reportAndMoveResult(std::make_unique<int>(41));
+    promise.reportFinished();
+
+    QVERIFY(future.isFinished());
+    QCOMPARE(*future.takeResult(), 42);
+#else
+    QSKIP("This test requires C++20 coroutine support.");
+#endif
+}
+
+void tst_QFuture::coroutineResumeOn()
+{
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    // resume in a thread pool
+    {
+        QThreadPool pool;
+        auto future = coroutineThreadAfter(
+                QtFuture::resumeOn(&pool, finishedFuture()));
+        QThread *thread = future.result();
+        QVERIFY(thread != QThread::currentThread());
+    }
+
+    // resume in the thread of a context object
+    {
+        QThread thread;
+        thread.start();
+        QObject context;
+        context.moveToThread(&thread);
+
+        QFutureInterface<void> promise;
+        promise.reportStarted();
+        auto future = coroutineThreadAfter(QtFuture::resumeOn(&context, promise.future()));
+        promise.reportFinished();
+        QCOMPARE(future.result(), &thread);
+
+        thread.quit();
+        QVERIFY(thread.wait());
+    }
+
+    // the coroutine is canceled when the context object is gone
+    {
+        QFutureInterface<void> promise;
+        promise.reportStarted();
+        auto context = std::make_unique<QObject>();
+        auto future = coroutineThreadAfter(QtFuture::resumeOn(context.get(), promise.future()));
+        promise.reportFinished();
+        QVERIFY(!future.isFinished());
+        context.reset();
+        QVERIFY(future.isFinished());
+        QVERIFY(future.isCanceled());
+    }
+#else
+    QSKIP("This test requires C++20 coroutine support.");
+#endif
+}
+
+void tst_QFuture::coroutineCancellation()
+{
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    // the awaited future is canceled
+    {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        int stored = 0;
+        auto future = coroutineStore(promise.future(), &stored);
+
+        promise.reportCanceled();
+        promise.reportFinished();
+        QVERIFY(future.isFinished());
+        QVERIFY(future.isCanceled());
+        QCOMPARE(stored, 0);
+    }
+
+    // the future of the coroutine is canceled
+    {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        int stored = 0;
+        auto future = coroutineStore(promise.future(), &stored);
+        future.cancel();
+
+        promise.reportResult(42);
+        promise.reportFinished();
+        QVERIFY(future.isFinished());
+        QVERIFY(future.isCanceled());
+        QCOMPARE(stored, 0);
+    }
+#else
+    QSKIP("This test requires C++20 coroutine support.");
+#endif
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QFuture::coroutineExceptions()
+{
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    // the exception of the awaited future is thrown in the coroutine
+    {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        auto future = coroutineCatch(promise.future());
+        promise.reportException(QException());
+        promise.reportFinished();
+        QCOMPARE(future.result(), -1);
+    }
+
+    // an exception leaving the coroutine is stored in its future
+    {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        int stored = 0;
+        auto future = coroutineStore(promise.future(), &stored);
+        promise.reportException(QException());
+        promise.reportFinished();
+        QVERIFY(future.isFinished());
+        QVERIFY_EXCEPTION_THROWN(future.waitForFinished(), QException);
+        QCOMPARE(stored, 0);
+    }
+#else
+    QSKIP("This test requires C++20 coroutine support.");
+#endif
+}
+#endif // QT_NO_EXCEPTIONS
+
 QTEST_MAIN(tst_QFuture)
 #include "tst_qfuture.moc"
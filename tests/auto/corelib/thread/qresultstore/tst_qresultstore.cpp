@@ -30,6 +30,8 @@
 
 #include <qresultstore.h>
 
+#include <memory>
+
 using namespace QtPrivate;
 
 struct ResultStoreInt : ResultStoreBase
@@ -53,6 +55,7 @@ private slots:
     void filterMode();
     void addCanceledResult();
     void count();
+    void smallResults();
 private:
     int int0;
     int int1;
@@ -477,5 +480,62 @@ void tst_QtConcurrentResultStore::count()
     }
 }
 
+void tst_QtConcurrentResultStore::smallResults()
+{
+    using SharedInt = std::shared_ptr<int>;
+    struct ResultStoreSharedInt : ResultStoreBase
+    {
+        ~ResultStoreSharedInt() { clear<SharedInt>(); }
+    };
+
+    const SharedInt first = std::make_shared<int>(0);
+    const SharedInt second = std::make_shared<int>(1);
+    {
+        ResultStoreSharedInt store;
+        store.addResult(1, &second);
+        store.addResult(0, &first);
+        QCOMPARE(store.count(), 2);
+        QCOMPARE(first.use_count(), 2);
+        QCOMPARE(second.use_count(), 2);
+
+        ResultIteratorBase it = store.begin();
+        QCOMPARE(it.resultIndex(), 0);
+        QCOMPARE(it.value<SharedInt>(), first);
+        ++it;
+        QCOMPARE(it.resultIndex(), 1);
+        QCOMPARE(it.value<SharedInt>(), second);
+        ++it;
+        QCOMPARE(it, store.end());
+
+        QCOMPARE(store.resultAt(0).value<SharedInt>(), first);
+        QCOMPARE(store.resultAt(1).value<SharedInt>(), second);
+    }
+    QCOMPARE(first.use_count(), 1);
+    QCOMPARE(second.use_count(), 1);
+
+    // the inline storage is reused after clearing
+    {
+        ResultStoreSharedInt store;
+        SharedInt moved = first;
+        store.moveResult(-1, std::move(moved));
+        store.clear<SharedInt>();
+        QCOMPARE(first.use_count(), 1);
+        store.addResult(0, &second);
+        QCOMPARE(store.resultAt(0).value<SharedInt>(), second);
+    }
+    QCOMPARE(second.use_count(), 1);
+
+    // a vector at index 0
+    {
+        ResultStoreInt store;
+        store.addResults(-1, &vec0);
+        store.addResult(-1, &int0);
+        QCOMPARE(store.count(), 3);
+        QCOMPARE(store.resultAt(1).value<int>(), vec0.at(1));
+        QCOMPARE(store.resultAt(2).value<int>(), int0);
+        QCOMPARE(store.resultAt(3), store.end());
+    }
+}
+
 QTEST_MAIN(tst_QtConcurrentResultStore)
 #include "tst_qresultstore.moc"
@@ -40,6 +40,9 @@
 #ifdef Q_OS_UNIX
 #include <pthread.h>
 #endif
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#endif
 #if defined(Q_OS_WIN)
 #include <windows.h>
 #if defined(Q_OS_WIN32)
@@ -64,6 +67,7 @@ private slots:
     void isRunning();
     void setPriority();
     void setStackSize();
+    void cpuAffinity();
     void exit();
     void start();
     void terminate();
@@ -408,6 +412,66 @@ void tst_QThread::setStackSize()
     QCOMPARE(thread.stackSize(), 0u);
 }
 
+void tst_QThread::cpuAffinity()
+{
+    QVERIFY(QThread::numaNodeCount() >= 1);
+    for (int node = 0; node < QThread::numaNodeCount(); ++node)
+        QVERIFY(!QThread::numaNodeCpus(node).isEmpty());
+    QVERIFY(QThread::numaNodeCpus(QThread::numaNodeCount()).isEmpty());
+
+    const int cpu = QThread::numaNodeCpus(0).constLast();
+    int ranOn = -1;
+    QScopedPointer<QThread> thread(QThread::create([&ranOn] {
+#ifdef Q_OS_LINUX
+        ranOn = sched_getcpu();
+#endif
+    }));
+    QVERIFY(thread->cpuAffinity().isEmpty());
+    thread->setCpuAffinity({ cpu });
+    QCOMPARE(thread->cpuAffinity(), QList<int>{ cpu });
+    thread->start();
+    QVERIFY(thread->wait(five_minutes));
+#ifdef Q_OS_LINUX
+    QCOMPARE(ranOn, cpu);
+#endif
+    thread->setCpuAffinity({});
+    QVERIFY(thread->cpuAffinity().isEmpty());
+
+#ifdef Q_OS_LINUX
+    // lifting the restriction gives a running thread its processors back
+    cpu_set_t inherited, whileRestricted, afterwards;
+    QCOMPARE(sched_getaffinity(0, sizeof(inherited), &inherited), 0);
+    QSemaphore restricted, checked, lifted;
+    thread.reset(QThread::create([&] {
+        restricted.acquire();
+        sched_getaffinity(0, sizeof(whileRestricted), &whileRestricted);
+        checked.release();
+        lifted.acquire();
+        sched_getaffinity(0, sizeof(afterwards), &afterwards);
+    }));
+    thread->start();
+    thread->setCpuAffinity({ cpu });
+    restricted.release();
+    checked.acquire();
+    thread->setCpuAffinity({});
+    lifted.release();
+    QVERIFY(thread->wait(five_minutes));
+    QCOMPARE(CPU_COUNT(&whileRestricted), 1);
+    QVERIFY(CPU_ISSET(cpu, &whileRestricted));
+    QVERIFY(CPU_EQUAL(&afterwards, &inherited));
+
+    // a list without any valid processor is rejected
+    QTest::ignoreMessage(QtWarningMsg, "QThread::setCpuAffinity: Cannot set the processor affinity, no valid processor");
+    thread.reset(QThread::create([&] {
+        sched_getaffinity(0, sizeof(afterwards), &afterwards);
+    }));
+    thread->setCpuAffinity({ -1 });
+    thread->start();
+    QVERIFY(thread->wait(five_minutes));
+    QVERIFY(CPU_EQUAL(&afterwards, &inherited));
+#endif
+}
+
 void tst_QThread::exit()
 {
     Exit_Thread thread;
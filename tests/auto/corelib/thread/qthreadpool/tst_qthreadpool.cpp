@@ -100,6 +100,9 @@ private slots:
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
+    void workStealing();
+    void workStealingTakeAndClear();
+    void numaAware();
 
 private:
     QMutex m_functionTestMutex;
@@ -1282,5 +1285,95 @@ void tst_QThreadPool::waitForDoneAfterTake()
 
 }
 
+void tst_QThreadPool::workStealing()
+{
+    enum {
+        Spawners = 4,
+        TasksPerSpawner = 1000
+    };
+
+    qputenv("QT_THREADPOOL_WORK_STEALING", "1"); // read when the pool is created
+    QThreadPool threadPool;
+    qunsetenv("QT_THREADPOOL_WORK_STEALING");
+    threadPool.setMaxThreadCount(4);
+
+    QAtomicInt ran = 0;
+    QAtomicInt highPriorityRan = 0;
+    for (int i = 0; i < Spawners; ++i) {
+        threadPool.start([&] {
+            for (int j = 0; j < TasksPerSpawner; ++j)
+                threadPool.start([&] { ran.ref(); });
+            threadPool.start([&] { highPriorityRan.ref(); }, 1);
+        });
+    }
+
+    QVERIFY(threadPool.waitForDone(60 * 1000));
+    QCOMPARE(ran.loadRelaxed(), int(Spawners * TasksPerSpawner));
+    QCOMPARE(highPriorityRan.loadRelaxed(), int(Spawners));
+}
+
+void tst_QThreadPool::workStealingTakeAndClear()
+{
+    qputenv("QT_THREADPOOL_WORK_STEALING", "1"); // read when the pool is created
+    QThreadPool threadPool;
+    qunsetenv("QT_THREADPOOL_WORK_STEALING");
+    // no other thread can steal the runnables started below
+    threadPool.setMaxThreadCount(1);
+
+    QAtomicInt ran = 0;
+    QRunnable *child = createTask(emptyFunct);
+    child->setAutoDelete(false);
+    bool taken = false;
+    threadPool.start([&] {
+        threadPool.start(child);
+        for (int i = 0; i < 10; ++i)
+            threadPool.start([&] { ran.ref(); });
+        taken = threadPool.tryTake(child);
+        threadPool.clear();
+    });
+
+    QVERIFY(threadPool.waitForDone(60 * 1000));
+    QVERIFY(taken);
+    QCOMPARE(ran.loadRelaxed(), 0);
+    delete child;
+}
+
+void tst_QThreadPool::numaAware()
+{
+    qputenv("QT_THREADPOOL_WORK_STEALING", "1"); // read when the pool is created
+    QThreadPool threadPool;
+    qunsetenv("QT_THREADPOOL_WORK_STEALING");
+    QVERIFY(!threadPool.isNumaAware());
+    threadPool.setNumaAware(true);
+    QVERIFY(threadPool.isNumaAware());
+
+    const QList<int> nodeCpus = QThread::numaNodeCpus(0);
+    threadPool.setThreadCpuAffinity({ nodeCpus.constFirst() });
+    QCOMPARE(threadPool.threadCpuAffinity(), QList<int>{ nodeCpus.constFirst() });
+
+    QMutex mutex;
+    QList<QList<int>> affinities;
+    QAtomicInt ran = 0;
+    for (int i = 0; i < 10; ++i) {
+        threadPool.start([&] {
+            for (int j = 0; j < 100; ++j)
+                threadPool.start([&] { ran.ref(); });
+            QMutexLocker locker(&mutex);
+            affinities.append(QThread::currentThread()->cpuAffinity());
+        });
+    }
+    QVERIFY(threadPool.waitForDone(60 * 1000));
+    QCOMPARE(ran.loadRelaxed(), 1000);
+
+    // each thread is placed on a node within the pool's affinity
+    QCOMPARE(affinities.size(), 10);
+    for (const QList<int> &cpus : qAsConst(affinities))
+        QCOMPARE(cpus, QList<int>{ nodeCpus.constFirst() });
+
+    threadPool.setNumaAware(false);
+    threadPool.setThreadCpuAffinity({});
+    QVERIFY(threadPool.threadCpuAffinity().isEmpty());
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
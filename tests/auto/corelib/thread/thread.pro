@@ -5,6 +5,7 @@ qtConfig(thread) {
         qatomicint \
         qatomicinteger \
         qatomicpointer \
+        qconcurrentqueue \
         qresultstore \
         qfuture \
         qfuturesynchronizer \
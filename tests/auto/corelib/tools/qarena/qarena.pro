@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qarena
+QT = core testlib
+SOURCES = tst_qarena.cpp
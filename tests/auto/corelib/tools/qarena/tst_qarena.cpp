@@ -0,0 +1,263 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qarena.h>
+#include <qbytearray.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qset.h>
+#include <qstring.h>
+
+class tst_QArena : public QObject
+{
+    Q_OBJECT
+private slots:
+    void allocate();
+    void alignment();
+    void largeAllocation();
+    void reset();
+    void string();
+    void byteArray();
+    void list();
+    void listGrowth();
+    void hash();
+    void set();
+};
+
+void tst_QArena::allocate()
+{
+    QArena arena(256);
+    QCOMPARE(arena.blockCount(), 0);
+    QCOMPARE(arena.allocationCount(), 0);
+
+    char *a = static_cast<char *>(arena.allocate(16));
+    char *b = static_cast<char *>(arena.allocate(16));
+    QVERIFY(a);
+    QVERIFY(b);
+    QCOMPARE(b - a, 16);
+    QCOMPARE(arena.blockCount(), 1);
+    QCOMPARE(arena.allocationCount(), 2);
+    QCOMPARE(arena.bytesAllocated(), 32);
+    memset(a, 'a', 16);
+    memset(b, 'b', 16);
+
+    // filling the first block makes the arena allocate a new one
+    for (int i = 0; i < 100; ++i)
+        QVERIFY(arena.allocate(16));
+    QVERIFY(arena.blockCount() > 1);
+    QCOMPARE(arena.allocationCount(), 102);
+    QCOMPARE(a[15], 'a');
+}
+
+void tst_QArena::alignment()
+{
+    QArena arena;
+    for (size_t alignment : { 1, 2, 4, 8, 16, 32, 64, 128 }) {
+        (void)arena.allocate(1, 1);
+        void *p = arena.allocate(3, alignment);
+        QVERIFY(p);
+        QCOMPARE(quintptr(p) % alignment, quintptr(0));
+    }
+}
+
+void tst_QArena::largeAllocation()
+{
+    QArena arena(256);
+    char *small = static_cast<char *>(arena.allocate(8, 8));
+    char *large = static_cast<char *>(arena.allocate(100000));
+    QVERIFY(large);
+    memset(large, 0, 100000);
+    // the rest of the current block is still used for small allocations
+    char *next = static_cast<char *>(arena.allocate(8, 8));
+    QCOMPARE(next - small, 8);
+    QCOMPARE(arena.blockCount(), 2);
+}
+
+void tst_QArena::reset()
+{
+    QArena arena(256);
+    for (int i = 0; i < 1000; ++i)
+        QVERIFY(arena.allocate(64));
+    QVERIFY(arena.blockCount() > 1);
+
+    arena.reset();
+    QCOMPARE(arena.blockCount(), 1);
+    QCOMPARE(arena.allocationCount(), 0);
+    QCOMPARE(arena.bytesAllocated(), 0);
+
+    // the block kept across the reset is reused
+    void *p = arena.allocate(64);
+    QVERIFY(p);
+    QCOMPARE(arena.blockCount(), 1);
+}
+
+void tst_QArena::string()
+{
+    QArena arena;
+    {
+        QString s = arena.string(64);
+        QVERIFY(s.isEmpty());
+        QVERIFY(s.capacity() >= 64);
+        QCOMPARE(arena.allocationCount(), 1);
+
+        s += QLatin1String("appended within the capacity");
+        QCOMPARE(arena.allocationCount(), 1);
+
+        // containers not created by the arena never use it
+        const QString other = QString::number(42) + s;
+        QCOMPARE(arena.allocationCount(), 1);
+
+        // growing takes the new memory from the same arena
+        for (int i = 0; i < 1000; ++i)
+            s += QChar(u'a' + i % 26);
+        QVERIFY(arena.allocationCount() > 1);
+        QCOMPARE(s.size(), 1028);
+        QVERIFY(s.startsWith(QLatin1String("appended within the capacity")));
+        QCOMPARE(s.back(), QChar(u'a' + 999 % 26));
+
+        // modifying a shared copy detaches it to the heap
+        const qsizetype count = arena.allocationCount();
+        QString copy = s;
+        copy += QLatin1String("!");
+        QCOMPARE(arena.allocationCount(), count);
+        QCOMPARE(copy.size(), s.size() + 1);
+        QVERIFY(copy.startsWith(s));
+    }
+    arena.reset();
+}
+
+void tst_QArena::byteArray()
+{
+    QArena arena;
+    {
+        QByteArray ba = arena.byteArray(16);
+        QVERIFY(ba.isEmpty());
+        QVERIFY(ba.capacity() >= 16);
+        QCOMPARE(arena.allocationCount(), 1);
+
+        for (int i = 0; i < 1000; ++i)
+            ba += char('a' + i % 26);
+        QVERIFY(arena.allocationCount() > 1);
+        QCOMPARE(ba.size(), 1000);
+        for (int i = 0; i < 1000; ++i)
+            QCOMPARE(ba.at(i), char('a' + i % 26));
+        QCOMPARE(*ba.constEnd(), '\0');
+    }
+    arena.reset();
+}
+
+void tst_QArena::list()
+{
+    QArena arena;
+    {
+        QList<int> list = arena.list<int>(3);
+        QVERIFY(list.capacity() >= 3);
+        QCOMPARE(arena.allocationCount(), 1);
+        list << 1 << 2 << 3;
+        QCOMPARE(arena.allocationCount(), 1);
+        QCOMPARE(list, QList<int>({ 1, 2, 3 }));
+
+        const qsizetype count = arena.allocationCount();
+        QList<int> copy = list;
+        copy.append(4);
+        QCOMPARE(arena.allocationCount(), count);
+        QCOMPARE(list, QList<int>({ 1, 2, 3 }));
+        QCOMPARE(copy, QList<int>({ 1, 2, 3, 4 }));
+    }
+    arena.reset();
+}
+
+void tst_QArena::listGrowth()
+{
+    QArena arena;
+    {
+        QList<QString> list = arena.list<QString>(0);
+        for (int i = 0; i < 1000; ++i)
+            list.append(QString::number(i));
+        QVERIFY(arena.allocationCount() > 0);
+        QCOMPARE(list.size(), 1000);
+        for (int i = 0; i < 1000; ++i)
+            QCOMPARE(list.at(i), QString::number(i));
+    }
+    arena.reset();
+}
+
+void tst_QArena::hash()
+{
+    QArena arena;
+    {
+        QHash<int, QString> hash = arena.hash<int, QString>();
+        QCOMPARE(arena.allocationCount(), 2); // the hash and its first span
+        for (int i = 0; i < 1000; ++i)
+            hash.insert(i, QString::number(i));
+        QVERIFY(arena.allocationCount() > 2);
+
+        // detaching copies the data to the heap
+        const qsizetype count = arena.allocationCount();
+        QHash<int, QString> copy = hash;
+        copy.insert(1000, QString::number(1000));
+        QCOMPARE(arena.allocationCount(), count);
+        for (int i = 0; i < 1000; ++i) {
+            QCOMPARE(hash.value(i), QString::number(i));
+            QCOMPARE(copy.value(i), QString::number(i));
+        }
+        QCOMPARE(copy.size(), 1001);
+
+        // as does a hash that is not created by the arena
+        QHash<int, QString> other;
+        other.insert(1, QString());
+        QCOMPARE(arena.allocationCount(), count);
+
+        hash.remove(500);
+        QCOMPARE(hash.size(), 999);
+        QVERIFY(!hash.contains(500));
+    }
+    arena.reset();
+}
+
+void tst_QArena::set()
+{
+    QArena arena;
+    {
+        QSet<int> set = arena.set<int>(100);
+        const qsizetype count = arena.allocationCount();
+        QVERIFY(count > 0);
+        for (int i = 0; i < 100; ++i)
+            set.insert(i);
+        QVERIFY(arena.allocationCount() > count);
+        QCOMPARE(set.size(), 100);
+        for (int i = 0; i < 100; ++i)
+            QVERIFY(set.contains(i));
+    }
+    arena.reset();
+}
+
+QTEST_APPLESS_MAIN(tst_QArena)
+#include "tst_qarena.moc"
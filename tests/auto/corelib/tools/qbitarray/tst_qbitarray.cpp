@@ -89,6 +89,11 @@ private slots:
 
     void toUInt32_data();
     void toUInt32();
+
+    void bulkOperations_data();
+    void bulkOperations();
+    void findNextBit_data();
+    void findNextBit();
 };
 
 void tst_QBitArray::size_data()
@@ -760,5 +765,94 @@ void tst_QBitArray::toUInt32()
     QCOMPARE(ok, check);
 }
 
+static QBitArray randomBitArray(int size, int percentSet)
+{
+    QBitArray ba(size);
+    for (int i = 0; i < size; ++i)
+        ba.setBit(i, int(QRandomGenerator::global()->bounded(100)) < percentSet);
+    return ba;
+}
+
+void tst_QBitArray::bulkOperations_data()
+{
+    QTest::addColumn<int>("size1");
+    QTest::addColumn<int>("size2");
+
+    // sizes around the 8, 16 and 32 byte blocks that the operations use
+    for (int size : { 0, 1, 7, 63, 64, 65, 127, 128, 129, 255, 256, 257, 1000, 4099 }) {
+        QTest::addRow("%d", size) << size << size;
+        QTest::addRow("%d,%d", size, size + 37) << size << size + 37;
+        QTest::addRow("%d,%d", size + 300, size) << size + 300 << size;
+    }
+}
+
+void tst_QBitArray::bulkOperations()
+{
+    QFETCH(int, size1);
+    QFETCH(int, size2);
+
+    const QBitArray a = randomBitArray(size1, 50);
+    const QBitArray b = randomBitArray(size2, 30);
+    const int size = qMax(size1, size2);
+
+    QBitArray andResult(size), orResult(size), xorResult(size);
+    for (int i = 0; i < size; ++i) {
+        const bool bitA = i < size1 && a.testBit(i);
+        const bool bitB = i < size2 && b.testBit(i);
+        andResult.setBit(i, bitA && bitB);
+        orResult.setBit(i, bitA || bitB);
+        xorResult.setBit(i, bitA != bitB);
+    }
+    QCOMPARE(a & b, andResult);
+    QCOMPARE(a | b, orResult);
+    QCOMPARE(a ^ b, xorResult);
+
+    QBitArray notResult(size1);
+    for (int i = 0; i < size1; ++i)
+        notResult.setBit(i, !a.testBit(i));
+    QCOMPARE(~a, notResult);
+
+    int setBits = 0;
+    for (int i = 0; i < size1; ++i)
+        setBits += a.testBit(i);
+    QCOMPARE(a.count(true), setBits);
+    QCOMPARE(a.count(false), size1 - setBits);
+    QCOMPARE((~a).count(true), size1 - setBits);
+}
+
+void tst_QBitArray::findNextBit_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("percentSet");
+
+    for (int size : { 1, 8, 63, 64, 65, 200, 1031 }) {
+        for (int percentSet : { 0, 1, 50, 99, 100 })
+            QTest::addRow("%d-%d%%", size, percentSet) << size << percentSet;
+    }
+}
+
+void tst_QBitArray::findNextBit()
+{
+    QFETCH(int, size);
+    QFETCH(int, percentSet);
+
+    const QBitArray ba = randomBitArray(size, percentSet);
+    for (int from = 0; from <= size; ++from) {
+        int expectedSet = -1;
+        int expectedClear = -1;
+        for (int i = from; i < size; ++i) {
+            if (expectedSet == -1 && ba.testBit(i))
+                expectedSet = i;
+            if (expectedClear == -1 && !ba.testBit(i))
+                expectedClear = i;
+        }
+        QCOMPARE(ba.findNextSetBit(from), expectedSet);
+        QCOMPARE(ba.findNextClearBit(from), expectedClear);
+    }
+
+    QCOMPARE(QBitArray().findNextSetBit(), -1);
+    QCOMPARE(QBitArray().findNextClearBit(), -1);
+}
+
 QTEST_APPLESS_MAIN(tst_QBitArray)
 #include "tst_qbitarray.moc"
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qconcurrentcache
+QT = core testlib
+SOURCES = tst_qconcurrentcache.cpp
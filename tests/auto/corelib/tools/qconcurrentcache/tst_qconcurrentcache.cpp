@@ -0,0 +1,284 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qconcurrentcache.h>
+#include <qthread.h>
+
+#include <memory>
+#include <vector>
+
+class tst_QConcurrentCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void cleanup();
+    void shardCount();
+    void insert();
+    void replace();
+    void remove();
+    void take();
+    void clear();
+    void maxCost();
+    void secondChance();
+    void statistics();
+    void concurrentAccess();
+};
+
+struct Foo {
+    static QAtomicInt count;
+    explicit Foo(int v = 0) : value(v) { count.ref(); }
+    ~Foo() { count.deref(); }
+    int value;
+};
+
+QAtomicInt Foo::count;
+
+using Cache = QConcurrentCache<int, Foo>;
+
+void tst_QConcurrentCache::cleanup()
+{
+    // always check for memory leaks
+    QCOMPARE(Foo::count.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::shardCount()
+{
+    QCOMPARE(Cache().shardCount(), 16);
+    QCOMPARE(Cache(100, 1).shardCount(), 1);
+    QCOMPARE(Cache(100, 5).shardCount(), 8);
+    QCOMPARE(Cache(100, 0).shardCount(), 1);
+}
+
+void tst_QConcurrentCache::insert()
+{
+    Cache cache(100);
+    QVERIFY(cache.isEmpty());
+    for (int i = 0; i < 10; ++i)
+        QVERIFY(cache.insert(i, new Foo(i), 2));
+    QCOMPARE(cache.size(), 10);
+    QCOMPARE(cache.totalCost(), 20);
+
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(cache.contains(i));
+        QSharedPointer<Foo> foo = cache.object(i);
+        QVERIFY(foo);
+        QCOMPARE(foo->value, i);
+        QCOMPARE(cache[i], foo);
+    }
+    QVERIFY(!cache.contains(10));
+    QVERIFY(!cache.object(10));
+
+    QList<int> keys = cache.keys();
+    std::sort(keys.begin(), keys.end());
+    QCOMPARE(keys, QList<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+
+    // objects costing more than the maximum are rejected (and deleted)
+    QVERIFY(!cache.insert(10, new Foo(10), 101));
+    QVERIFY(!cache.contains(10));
+    QCOMPARE(Foo::count.loadRelaxed(), 10);
+}
+
+void tst_QConcurrentCache::replace()
+{
+    Cache cache(100);
+    QVERIFY(cache.insert(1, new Foo(1), 10));
+    QSharedPointer<Foo> old = cache.object(1);
+    QVERIFY(cache.insert(1, new Foo(2), 20));
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.totalCost(), 20);
+    QCOMPARE(cache.object(1)->value, 2);
+    // the replaced object lives on as long as someone uses it
+    QCOMPARE(old->value, 1);
+    QCOMPARE(Foo::count.loadRelaxed(), 2);
+
+    // a rejected replacement removes the old object, like QCache does
+    QVERIFY(!cache.insert(1, new Foo(3), 200));
+    QVERIFY(!cache.contains(1));
+    QCOMPARE(cache.totalCost(), 0);
+}
+
+void tst_QConcurrentCache::remove()
+{
+    Cache cache(100, 1);
+    for (int i = 0; i < 5; ++i)
+        cache.insert(i, new Foo(i), i);
+    QVERIFY(cache.remove(2));
+    QVERIFY(!cache.remove(2));
+    QCOMPARE(cache.size(), 4);
+    QCOMPARE(cache.totalCost(), 0 + 1 + 3 + 4);
+    for (int i : { 0, 1, 3, 4 })
+        QCOMPARE(cache.object(i)->value, i);
+    QVERIFY(cache.remove(0));
+    QVERIFY(cache.remove(4));
+    QList<int> keys = cache.keys();
+    std::sort(keys.begin(), keys.end());
+    QCOMPARE(keys, QList<int>({ 1, 3 }));
+    QCOMPARE(cache.totalCost(), 4);
+
+    // a null object is still an object in the cache
+    QVERIFY(cache.insert(5, QSharedPointer<Foo>(), 5));
+    QVERIFY(cache.contains(5));
+    QVERIFY(cache.remove(5));
+    QVERIFY(!cache.contains(5));
+    QVERIFY(!cache.remove(5));
+    QCOMPARE(cache.totalCost(), 4);
+}
+
+void tst_QConcurrentCache::take()
+{
+    Cache cache(100);
+    cache.insert(1, new Foo(1), 10);
+    QSharedPointer<Foo> foo = cache.take(1);
+    QVERIFY(foo);
+    QCOMPARE(foo->value, 1);
+    QVERIFY(!cache.contains(1));
+    QCOMPARE(cache.totalCost(), 0);
+    QVERIFY(!cache.take(1));
+}
+
+void tst_QConcurrentCache::clear()
+{
+    Cache cache(100);
+    for (int i = 0; i < 50; ++i)
+        cache.insert(i, new Foo(i));
+    cache.clear();
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(cache.totalCost(), 0);
+    QCOMPARE(Foo::count.loadRelaxed(), 0);
+    QVERIFY(cache.insert(1, new Foo(1)));
+    QCOMPARE(cache.size(), 1);
+}
+
+void tst_QConcurrentCache::maxCost()
+{
+    Cache cache(10);
+    QCOMPARE(cache.maxCost(), 10);
+    for (int i = 0; i < 100; ++i) {
+        QVERIFY(cache.insert(i, new Foo(i), 3));
+        QVERIFY(cache.totalCost() <= 10);
+    }
+    QCOMPARE(cache.size(), 3);
+    QCOMPARE(Foo::count.loadRelaxed(), 3);
+
+    cache.setMaxCost(4);
+    QCOMPARE(cache.maxCost(), 4);
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.totalCost(), 3);
+
+    cache.setMaxCost(0);
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(Foo::count.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::secondChance()
+{
+    // with a single shard the eviction order is that of the CLOCK algorithm
+    Cache cache(4, 1);
+    for (int i = 0; i < 4; ++i)
+        cache.insert(i, new Foo(i));
+
+    // The first insertion beyond the limit clears all referenced bits and
+    // evicts the oldest entry
+    cache.insert(4, new Foo(4));
+    QVERIFY(!cache.contains(0));
+
+    // an entry that is used in the meantime survives the next eviction
+    QVERIFY(cache.object(1));
+    cache.insert(5, new Foo(5));
+    QVERIFY(cache.contains(1));
+    QCOMPARE(cache.size(), 4);
+    QCOMPARE(cache.keys().count(1), 1);
+}
+
+void tst_QConcurrentCache::statistics()
+{
+    Cache cache(2, 1);
+    cache.insert(1, new Foo(1));
+    cache.insert(2, new Foo(2));
+    cache.object(1);
+    cache.object(1);
+    cache.object(3);
+    cache.contains(2);
+    cache.insert(3, new Foo(3));
+
+    Cache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.hits, 2u);
+    QCOMPARE(stats.misses, 1u);
+    QCOMPARE(stats.insertions, 3u);
+    QCOMPARE(stats.evictions, 1u);
+
+    cache.resetStatistics();
+    stats = cache.statistics();
+    QCOMPARE(stats.hits, 0u);
+    QCOMPARE(stats.misses, 0u);
+    QCOMPARE(stats.insertions, 0u);
+    QCOMPARE(stats.evictions, 0u);
+}
+
+void tst_QConcurrentCache::concurrentAccess()
+{
+    const int threadCount = 4;
+    const int iterations = 20000;
+    const int keyCount = 1000;
+    Cache cache(keyCount / 2);
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    QAtomicInt errors;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back(QThread::create([&cache, &errors, t]() {
+            for (int i = 0; i < iterations; ++i) {
+                const int key = (i * 7919 + t * 104729) % keyCount;
+                if (QSharedPointer<Foo> foo = cache.object(key)) {
+                    if (foo->value != key)
+                        errors.ref();
+                } else {
+                    cache.insert(key, new Foo(key));
+                }
+                if (i % 100 == 0)
+                    cache.remove((key + 1) % keyCount);
+            }
+        }));
+        threads.back()->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(errors.loadRelaxed(), 0);
+    QVERIFY(cache.totalCost() <= cache.maxCost());
+    QCOMPARE(cache.totalCost(), int(cache.size()));
+    QCOMPARE(Foo::count.loadRelaxed(), int(cache.size()));
+
+    const Cache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.hits + stats.misses, quint64(threadCount * iterations));
+    cache.clear();
+}
+
+QTEST_APPLESS_MAIN(tst_QConcurrentCache)
+#include "tst_qconcurrentcache.moc"
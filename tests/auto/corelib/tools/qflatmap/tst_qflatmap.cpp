@@ -28,7 +28,7 @@
 
 #include <QtTest/QtTest>
 
-#include <private/qflatmap_p.h>
+#include <qflatmap.h>
 #include <qbytearray.h>
 #include <qstring.h>
 #include <qstringview.h>
@@ -44,6 +44,7 @@ class tst_QFlatMap : public QObject
     Q_OBJECT
 private slots:
     void constructing();
+    void duplicateKeys();
     void constAccess();
     void insertion();
     void removal();
@@ -53,6 +54,7 @@ private slots:
     void transparency();
     void viewIterators();
     void varLengthArray();
+    void flatSet();
 };
 
 void tst_QFlatMap::constructing()
@@ -88,6 +90,10 @@ void tst_QFlatMap::constructing()
     auto fmInitList = Map{ { 1, 2 }, { "foo", "bar" } };
     QVERIFY(std::is_sorted(fmInitList.begin(), fmInitList.end(), value_compare));
 
+    const Map fmCopyListInit = { { 3, "baz" }, { 1, "foo" } };
+    QCOMPARE(fmCopyListInit.size(), Map::size_type(2));
+    QVERIFY(std::is_sorted(fmCopyListInit.begin(), fmCopyListInit.end(), value_compare));
+
     auto fmRange = Map(fmCopy.begin(), fmCopy.end());
     QVERIFY(std::is_sorted(fmRange.begin(), fmRange.end(), value_compare));
 
@@ -106,6 +112,30 @@ void tst_QFlatMap::constructing()
     auto fmFromSortedRange = Map(Qt::OrderedUniqueRange, sv.begin(), sv.end());
 }
 
+void tst_QFlatMap::duplicateKeys()
+{
+    using Map = QFlatMap<int, QByteArray>;
+    const Map::key_container_type kv = { 3, 1, 3, 2, 1, 3 };
+    const Map::mapped_container_type mv = { "a", "b", "c", "d", "e", "f" };
+
+    // the last value of each key wins, as with inserting them one by one
+    const Map m(kv, mv);
+    QCOMPARE(m.keys(), Map::key_container_type({ 1, 2, 3 }));
+    QCOMPARE(m.values(), Map::mapped_container_type({ "e", "d", "f" }));
+
+    Map inserted;
+    for (int i = 0; i < kv.size(); ++i)
+        inserted[kv.at(i)] = mv.at(i);
+    QCOMPARE(inserted.keys(), m.keys());
+    QCOMPARE(inserted.values(), m.values());
+
+    // already sorted input with duplicates
+    const Map sorted(Map::key_container_type{ 1, 1, 2, 2, 2 },
+                     Map::mapped_container_type{ "a", "b", "c", "d", "e" });
+    QCOMPARE(sorted.keys(), Map::key_container_type({ 1, 2 }));
+    QCOMPARE(sorted.values(), Map::mapped_container_type({ "b", "e" }));
+}
+
 void tst_QFlatMap::constAccess()
 {
     using Map = QFlatMap<QByteArray, QByteArray>;
@@ -387,6 +417,21 @@ void tst_QFlatMap::transparency()
     QCOMPARE(m.lower_bound(sv1).value(), "een");
     QCOMPARE(m.lower_bound(sv2).value(), "twee");
     QCOMPARE(m.lower_bound(sv3).value(), "dree");
+
+    QVERIFY(m.contains(sv2));
+    QVERIFY(!m.contains(QStringView(numbers).left(2)));
+    QCOMPARE(m.find(sv3).value(), "dree");
+    QCOMPARE(m.value(sv1), "een");
+    QCOMPARE(m.value(QStringView(numbers).left(2), QStringLiteral("nix")), "nix");
+    QVERIFY(m.remove(sv1));
+    QVERIFY(!m.remove(sv1));
+    QCOMPARE(m.size(), 2);
+
+    using StdLessMap = QFlatMap<QString, int, std::less<>>;
+    const StdLessMap sm{ { "one", 1 }, { "two", 2 }, { "three", 3 } };
+    QCOMPARE(sm.value(sv1), 1);
+    QCOMPARE(sm.value(sv3), 3);
+    QVERIFY(!sm.contains(QStringView(numbers).left(2)));
 }
 
 void tst_QFlatMap::viewIterators()
@@ -449,5 +494,47 @@ void tst_QFlatMap::varLengthArray()
     QVERIFY(m.isEmpty());
 }
 
+void tst_QFlatMap::flatSet()
+{
+    using Set = QFlatSet<QString>;
+    Set s{ "c", "a", "b", "a" };
+    QCOMPARE(s.size(), 3);
+    QVERIFY(std::is_sorted(s.begin(), s.end()));
+    QCOMPARE(s.values(), QList<QString>({ "a", "b", "c" }));
+
+    QVERIFY(s.insert("d").second);
+    QVERIFY(!s.insert("a").second);
+    QCOMPARE(*s.insert("bb").first, "bb");
+    QCOMPARE(s.size(), 5);
+    QVERIFY(s.contains("bb"));
+    QVERIFY(!s.contains("e"));
+    QCOMPARE(*s.lower_bound("ba"), "bb");
+    QCOMPARE(*s.upper_bound("bb"), "c");
+    QCOMPARE(s.find("e"), s.end());
+
+    QVERIFY(s.remove("bb"));
+    QVERIFY(!s.remove("bb"));
+    QCOMPARE(*s.erase(s.find("b")), "c");
+    QCOMPARE(s.values(), QList<QString>({ "a", "c", "d" }));
+
+    const QStringList sorted = { "x", "y", "z" };
+    s.insert(Qt::OrderedUniqueRange, sorted.begin(), sorted.end());
+    QCOMPARE(s.size(), 6);
+    QVERIFY(std::is_sorted(s.begin(), s.end()));
+
+    const Set fromSorted(Qt::OrderedUniqueRange, QList<QString>{ "a", "b" });
+    QCOMPARE(fromSorted.size(), 2);
+
+    using TransparentSet = QFlatSet<QString, std::less<>>;
+    const TransparentSet ts = { "one", "two", "three" };
+    const QString numbers = "one two";
+    QVERIFY(ts.contains(QStringView(numbers).left(3)));
+    QVERIFY(ts.contains(QStringView(numbers).mid(4)));
+    QVERIFY(!ts.contains(QStringView(numbers).left(2)));
+
+    QList<QString> values = std::move(s).extract();
+    QCOMPARE(values.size(), 6);
+}
+
 QTEST_APPLESS_MAIN(tst_QFlatMap)
 #include "tst_qflatmap.moc"
@@ -73,6 +73,7 @@ private slots:
     void emplace();
 
     void badHashFunction();
+    void probeAcrossGroupsAndSpans();
 };
 
 struct IdentityTracker {
@@ -1751,5 +1752,96 @@ void tst_QHash::badHashFunction()
 
 }
 
+// The hash puts the key into the given bucket, and uses only a few distinct
+// hash fragments (the top bits), so that lookups need to compare keys
+struct ProbeKey {
+    int bucket;
+    int id;
+    bool operator==(const ProbeKey &other) const
+    {
+        return bucket == other.bucket && id == other.id;
+    }
+};
+
+size_t qHash(ProbeKey key, size_t)
+{
+    return size_t(key.bucket) | size_t(key.id % 4) << (8 * sizeof(size_t) - 7);
+}
+
+void tst_QHash::probeAcrossGroupsAndSpans()
+{
+    QHash<ProbeKey, int> hash;
+    hash.reserve(128);
+    QCOMPARE(hash.capacity(), 128); // 256 buckets, 2 spans of 8 groups each
+
+    // clusters that cross a group boundary, the span boundary and the end
+    // of the table
+    const QList<ProbeKey> homes = { { 12, 8 }, { 120, 20 }, { 250, 12 }, { 2, 3 } };
+    QList<ProbeKey> keys;
+    for (ProbeKey home : homes) {
+        for (int id = 0; id < home.id; ++id)
+            keys.append({ home.bucket, id });
+    }
+    for (int i = 0; i < keys.size(); ++i)
+        hash.insert(keys.at(i), i);
+    QCOMPARE(hash.capacity(), 128);
+    QCOMPARE(hash.size(), keys.size());
+
+    auto verify = [&](const QList<ProbeKey> &expected) {
+        QCOMPARE(hash.size(), expected.size());
+        for (ProbeKey key : std::as_const(keys)) {
+            const auto it = hash.constFind(key);
+            if (expected.contains(key)) {
+                QVERIFY(it != hash.cend());
+                QCOMPARE(it.key(), key);
+                QCOMPARE(it.value(), keys.indexOf(key));
+            } else {
+                QVERIFY(it == hash.cend());
+            }
+        }
+        for (ProbeKey home : homes)
+            QVERIFY(!hash.contains({ home.bucket, 100 }));
+        qsizetype count = 0;
+        for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+            QVERIFY(expected.contains(it.key()));
+            ++count;
+        }
+        QCOMPARE(count, expected.size());
+    };
+    verify(keys);
+    if (QTest::currentTestFailed())
+        return;
+
+    // erasing from the middle and the start of the clusters moves the
+    // following keys back, also across the boundaries
+    QList<ProbeKey> remaining = keys;
+    const QList<ProbeKey> erased = { { 12, 0 }, { 120, 7 }, { 120, 8 }, { 120, 0 },
+                                     { 250, 5 }, { 250, 0 }, { 2, 1 } };
+    for (ProbeKey key : erased) {
+        QVERIFY(hash.remove(key));
+        remaining.removeOne(key);
+        verify(remaining);
+        if (QTest::currentTestFailed())
+            return;
+    }
+
+    // the freed buckets get reused
+    for (ProbeKey key : erased) {
+        hash.insert(key, keys.indexOf(key));
+        remaining.append(key);
+    }
+    QCOMPARE(hash.capacity(), 128);
+    verify(remaining);
+    if (QTest::currentTestFailed())
+        return;
+
+    for (ProbeKey key : std::as_const(keys)) {
+        QVERIFY(hash.remove(key));
+        remaining.removeOne(key);
+    }
+    verify(remaining);
+    QVERIFY(hash.isEmpty());
+}
+
 QTEST_APPLESS_MAIN(tst_QHash)
 #include "tst_qhash.moc"
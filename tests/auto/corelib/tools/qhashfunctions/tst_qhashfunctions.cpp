@@ -56,6 +56,7 @@ private Q_SLOTS:
     void qhash_of_empty_and_null_qstring();
     void qhash_of_empty_and_null_qbytearray();
     void qhash_of_zero_floating_points();
+    void qhashBits();
     void qthash_data();
     void qthash();
     void range();
@@ -201,6 +202,52 @@ void tst_QHashFunctions::qhash_of_zero_floating_points()
 #endif
 }
 
+void tst_QHashFunctions::qhashBits()
+{
+    // qHashBits() may read whole 16-byte blocks around short keys; make sure
+    // the result only depends on the key itself, wherever it is in memory,
+    // including right after the start and right before the end of a page.
+    enum { PageSize = 4096, MaxLength = 70 };
+    alignas(PageSize) static uchar buffer[3 * PageSize];
+
+    QRandomGenerator generator(seed);
+    uchar key[MaxLength];
+    generator.fillRange(reinterpret_cast<quint32 *>(buffer), sizeof(buffer) / sizeof(quint32));
+    for (uchar &c : key)
+        c = uchar(generator.bounded(256));
+
+    QSet<size_t> zeroHashes;
+    for (size_t len = 0; len <= MaxLength; ++len) {
+        const size_t expected = qHashBits(key, len, seed);
+        const size_t offsets[] = { PageSize, PageSize + 1, PageSize + 7, PageSize + 15,
+                                   2 * PageSize - len, 2 * PageSize - len - 1,
+                                   2 * PageSize - len - 9, PageSize + 100 };
+        for (size_t offset : offsets) {
+            uchar *p = buffer + offset;
+            memcpy(p, key, len);
+            QCOMPARE(qHashBits(p, len, seed), expected);
+
+            // changing the bytes around the key must not matter
+            p[-1] = ~p[-1];
+            p[len] = ~p[len];
+            QCOMPARE(qHashBits(p, len, seed), expected);
+        }
+
+        // changing any byte of the key should change the hash
+        if (len) {
+            uchar modified[MaxLength];
+            memcpy(modified, key, len);
+            modified[len / 2] ^= 0x20;
+            QVERIFY(qHashBits(modified, len, seed) != expected);
+        }
+
+        // the length is part of the hash
+        const uchar zeroes[MaxLength] = {};
+        zeroHashes.insert(qHashBits(zeroes, len, seed));
+    }
+    QCOMPARE(zeroHashes.size(), qsizetype(MaxLength + 1));
+}
+
 void tst_QHashFunctions::qthash_data()
 {
     QTest::addColumn<QString>("key");
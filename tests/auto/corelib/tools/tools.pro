@@ -3,9 +3,11 @@ SUBDIRS=\
     collections \
     containerapisymmetry \
     qalgorithms \
+    qarena \
     qarraydata \
     qbitarray \
     qcache \
+    qconcurrentcache \
     qcommandlineparser \
     qcontiguouscache \
     qcryptographichash \
@@ -30,6 +30,8 @@
 #include <QIODevice>
 #include <QString>
 #include <QBuffer>
+#include <QStringList>
+#include <QTextStream>
 #include <qtest.h>
 
 class tst_qtextstream : public QObject
@@ -38,6 +40,8 @@ class tst_qtextstream : public QObject
 private slots:
     void writeSingleChar_data();
     void writeSingleChar();
+    void readLinesFromDevice();
+    void writeLinesToDevice();
 
 private:
 };
@@ -115,6 +119,53 @@ void tst_qtextstream::writeSingleChar()
     QCOMPARE(result.left(10), QString("hhhhhhhhhh"));
 }
 
+// about 1 MB of UTF-8 text in lines of different lengths and scripts
+static QByteArray textLines()
+{
+    const QString samples[] = {
+        QStringLiteral("The quick brown fox jumps over the lazy dog."),
+        QString::fromUtf8("Съешь же ещё этих мягких французских булок, да выпей чаю."),
+        QString::fromUtf8("我能吞下玻璃而不伤身体。"),
+        QStringLiteral("42"),
+    };
+    QByteArray result;
+    for (int i = 0; result.size() < 1024 * 1024; ++i)
+        result += samples[i % 4].repeated(i % 7 + 1).toUtf8() + '\n';
+    return result;
+}
+
+void tst_qtextstream::readLinesFromDevice()
+{
+    QByteArray data = textLines();
+
+    QBENCHMARK {
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QTextStream stream(&buffer);
+        QString line;
+        qsizetype size = 0;
+        while (stream.readLineInto(&line))
+            size += line.size();
+        QVERIFY(size);
+    }
+}
+
+void tst_qtextstream::writeLinesToDevice()
+{
+    const QStringList lines = QString::fromUtf8(textLines()).split(QLatin1Char('\n'));
+
+    QBENCHMARK {
+        QByteArray data;
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        QTextStream stream(&buffer);
+        for (const QString &line : lines)
+            stream << line << '\n';
+        stream.flush();
+        QVERIFY(data.size());
+    }
+}
+
 QTEST_MAIN(tst_qtextstream)
 
 #include "main.moc"
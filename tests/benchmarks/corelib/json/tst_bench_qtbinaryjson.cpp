@@ -45,6 +45,10 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseLargeDocument_data();
+    void parseLargeDocument();
+    void parseLargeDocumentReferencingStrings_data() { parseLargeDocument_data(); }
+    void parseLargeDocumentReferencingStrings();
 
     void toByteArray();
     void fromByteArray();
@@ -120,6 +124,92 @@ void BenchmarkQtBinaryJson::parseJsonToVariant()
     }
 }
 
+void BenchmarkQtBinaryJson::parseLargeDocument_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    // Documents of at least 8 MB each, with the kind of content that dominates
+    // typical large inputs: indentation, long strings and numbers.
+    const int size = 8 * 1024 * 1024;
+    QJsonArray records;
+    QJsonArray strings;
+    QJsonArray mixedScript;
+    QJsonArray numbers;
+    QByteArray recordsJson;
+    QByteArray stringsJson;
+    QByteArray mixedScriptJson;
+    QByteArray numbersJson;
+    for (int i = 0; recordsJson.size() < size; ++i) {
+        records.append(QJsonObject{
+            { "id", i },
+            { "name", QString("record %1").arg(i) },
+            { "enabled", i % 3 == 0 },
+            { "score", i / 7. },
+            { "tags", QJsonArray{ "alpha", "beta", "gamma" } }
+        });
+        if ((i & (i - 1)) == 0)
+            recordsJson = QJsonDocument(records).toJson(QJsonDocument::Indented);
+    }
+    for (int i = 0; stringsJson.size() < size; ++i) {
+        strings.append(QString(1000, QLatin1Char('a' + i % 26)));
+        if ((i & (i - 1)) == 0)
+            stringsJson = QJsonDocument(strings).toJson(QJsonDocument::Compact);
+    }
+    const QString text = QString::fromUtf8("Qt \xe2\x80\x94 \xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5"
+                                           "\xd1\x82 \xe4\xbd\xa0\xe5\xa5\xbd caf\xc3\xa9 ");
+    for (int i = 0; mixedScriptJson.size() < size; ++i) {
+        mixedScript.append(text.repeated(20));
+        if ((i & (i - 1)) == 0)
+            mixedScriptJson = QJsonDocument(mixedScript).toJson(QJsonDocument::Compact);
+    }
+    for (int i = 0; numbersJson.size() < size; ++i) {
+        numbers.append(i % 2 ? QJsonValue(i * 1000) : QJsonValue(i / 3.));
+        if ((i & (i - 1)) == 0)
+            numbersJson = QJsonDocument(numbers).toJson(QJsonDocument::Compact);
+    }
+
+    QTest::newRow("indented-records") << recordsJson;
+    QTest::newRow("long-strings") << stringsJson;
+    QTest::newRow("mixed-script-strings") << mixedScriptJson;
+    QTest::newRow("numbers") << numbersJson;
+}
+
+void BenchmarkQtBinaryJson::parseLargeDocument()
+{
+    QFETCH(QByteArray, json);
+
+    // report the throughput instead of the time per document
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    qint64 parsed = 0;
+    QBENCHMARK {
+        timer.start();
+        QJsonDocument doc = QJsonDocument::fromJson(json);
+        elapsed += timer.nsecsElapsed();
+        parsed += json.size();
+        QVERIFY(!doc.isNull());
+    }
+    QTest::setBenchmarkResult(parsed * 1e9 / qMax(elapsed, qint64(1)), QTest::BytesPerSecond);
+}
+
+void BenchmarkQtBinaryJson::parseLargeDocumentReferencingStrings()
+{
+    QFETCH(QByteArray, json);
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    qint64 parsed = 0;
+    QBENCHMARK {
+        timer.start();
+        QJsonDocument doc = QJsonDocument::fromJson(json, nullptr,
+                                                    QJsonDocument::ReferenceStrings);
+        elapsed += timer.nsecsElapsed();
+        parsed += json.size();
+        QVERIFY(!doc.isNull());
+    }
+    QTest::setBenchmarkResult(parsed * 1e9 / qMax(elapsed, qint64(1)), QTest::BytesPerSecond);
+}
+
 void BenchmarkQtBinaryJson::toByteArray()
 {
     // Example: send information over a datastream to another process
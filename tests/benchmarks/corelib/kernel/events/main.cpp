@@ -30,6 +30,10 @@
 #include <qtest.h>
 #include <qtesteventloop.h>
 
+#ifdef Q_OS_UNIX
+#  include <unistd.h>
+#endif
+
 class PingPong : public QObject
 {
 public:
@@ -96,6 +100,10 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+#ifdef Q_OS_UNIX
+    void socketNotifierWakeUp_data();
+    void socketNotifierWakeUp();
+#endif
 };
 
 void EventsBench::initTestCase()
@@ -169,6 +177,62 @@ void EventsBench::postEvent()
     }
 }
 
+#ifdef Q_OS_UNIX
+void EventsBench::socketNotifierWakeUp_data()
+{
+    QTest::addColumn<int>("idleNotifiers");
+    QTest::newRow("0") << 0;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("5000") << 5000;
+    QTest::newRow("20000") << 20000;
+}
+
+// Measures the latency of waking the event loop through a single active
+// socket notifier while many idle ones are registered. Run with
+// QT_EVENT_DISPATCHER_EPOLL=1 or QT_EVENT_DISPATCHER_IO_URING=1 to compare
+// against the epoll and io_uring backends.
+void EventsBench::socketNotifierWakeUp()
+{
+    QFETCH(int, idleNotifiers);
+
+    QList<int> fds;
+    auto closeAll = qScopeGuard([&fds] {
+        for (int fd : qAsConst(fds))
+            ::close(fd);
+    });
+
+    std::vector<std::unique_ptr<QSocketNotifier>> idle;
+    idle.reserve(idleNotifiers);
+    for (int i = 0; i < idleNotifiers; ++i) {
+        int pipefd[2];
+        if (::pipe(pipefd) == -1)
+            QSKIP(qPrintable(QString("Could not create %1 pipes (raise the file descriptor limit)")
+                             .arg(idleNotifiers)));
+        fds << pipefd[0] << pipefd[1];
+        idle.emplace_back(new QSocketNotifier(pipefd[0], QSocketNotifier::Read));
+    }
+
+    int active[2];
+    QVERIFY(::pipe(active) == 0);
+    fds << active[0] << active[1];
+
+    QSocketNotifier notifier(active[0], QSocketNotifier::Read);
+    connect(&notifier, &QSocketNotifier::activated, this, [&active]() {
+        char c;
+        if (::read(active[0], &c, 1) == 1)
+            QTestEventLoop::instance().exitLoop();
+    });
+
+    QBENCHMARK {
+        const char c = 'x';
+        QVERIFY(::write(active[1], &c, 1) == 1);
+        QTestEventLoop::instance().enterLoop(10);
+        QVERIFY(!QTestEventLoop::instance().timeout());
+    }
+}
+#endif
+
 QTEST_MAIN(EventsBench)
 
 #include "main.moc"
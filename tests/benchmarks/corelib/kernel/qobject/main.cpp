@@ -51,10 +51,28 @@ private slots:
     void connect_disconnect_benchmark_data();
     void connect_disconnect_benchmark();
     void receiver_destroyed_benchmark();
+    void queued_cross_thread_benchmark_data();
+    void queued_cross_thread_benchmark();
 
     void stdAllocator();
 };
 
+class QueuedReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    int expected = 0;
+    int received = 0;
+    QSemaphore done;
+
+public slots:
+    void slot()
+    {
+        if (++received == expected)
+            done.release();
+    }
+};
+
 class QObjectUsingStandardAllocator : public QObject
 {
     Q_OBJECT
@@ -305,6 +323,55 @@ void QObjectBenchmark::receiver_destroyed_benchmark()
     }
 }
 
+void QObjectBenchmark::queued_cross_thread_benchmark_data()
+{
+    QTest::addColumn<int>("producerCount");
+    QTest::addColumn<bool>("batched");
+    QTest::newRow("1 producer") << 1 << false;
+    QTest::newRow("2 producers") << 2 << false;
+    QTest::newRow("4 producers") << 4 << false;
+    QTest::newRow("1 producer, batched") << 1 << true;
+    QTest::newRow("2 producers, batched") << 2 << true;
+    QTest::newRow("4 producers, batched") << 4 << true;
+}
+
+// Emits queued signals from producer threads to a receiver living in
+// another thread, and waits until all of them have been delivered.
+void QObjectBenchmark::queued_cross_thread_benchmark()
+{
+    QFETCH(int, producerCount);
+    QFETCH(bool, batched);
+    const int emitsPerProducer = SignalsAndSlotsBenchmarkConstant / producerCount;
+
+    QThread consumer;
+    consumer.start();
+    Object sender;
+    QueuedReceiver receiver;
+    receiver.moveToThread(&consumer);
+    QObject::connect(&sender, &Object::signal0, &receiver, &QueuedReceiver::slot,
+                     batched ? Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection)
+                             : Qt::QueuedConnection);
+
+    QBENCHMARK {
+        receiver.expected = emitsPerProducer * producerCount;
+        receiver.received = 0;
+        std::vector<std::unique_ptr<QThread>> producers;
+        for (int i = 0; i < producerCount; ++i) {
+            producers.emplace_back(QThread::create([&sender, emitsPerProducer] {
+                for (int j = 0; j < emitsPerProducer; ++j)
+                    sender.emitSignal0();
+            }));
+            producers.back()->start();
+        }
+        receiver.done.acquire();
+        for (auto &producer : producers)
+            producer->wait();
+    }
+
+    consumer.quit();
+    consumer.wait();
+}
+
 QTEST_MAIN(QObjectBenchmark)
 
 #include "main.moc"
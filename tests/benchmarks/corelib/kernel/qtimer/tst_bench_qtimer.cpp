@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qobject.h>
+#include <QtTest/qtest.h>
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void registerAndCancel_data();
+    void registerAndCancel();
+    void restartAmongActiveTimers_data();
+    void restartAmongActiveTimers();
+
+private:
+    void addTimerCountRows();
+};
+
+void tst_QTimer::addTimerCountRows()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<Qt::TimerType>("timerType");
+
+    const int counts[] = { 100, 1000, 10000, 100000 };
+    const struct {
+        Qt::TimerType type;
+        const char *name;
+    } types[] = {
+        { Qt::PreciseTimer, "precise" },
+        { Qt::CoarseTimer, "coarse" },
+        { Qt::VeryCoarseTimer, "verycoarse" }
+    };
+
+    for (const auto &type : types) {
+        for (int count : counts)
+            QTest::addRow("%s-%d", type.name, count) << count << type.type;
+    }
+}
+
+// Keepalive-like intervals: spread over a minute, so that the timers do not
+// all share the same timeout.
+static int intervalFor(int i)
+{
+    return 1000 + (i * 7919) % 60000;
+}
+
+void tst_QTimer::registerAndCancel_data()
+{
+    addTimerCountRows();
+}
+
+// Registers N timers on one object and kills them again.
+void tst_QTimer::registerAndCancel()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, timerType);
+
+    QObject object;
+    QList<int> ids;
+    ids.reserve(count);
+
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            ids.append(object.startTimer(intervalFor(i), timerType));
+        for (int id : qAsConst(ids))
+            object.killTimer(id);
+        ids.clear();
+    }
+}
+
+void tst_QTimer::restartAmongActiveTimers_data()
+{
+    addTimerCountRows();
+}
+
+// Restarts one timer while N others are active, like resetting a keepalive
+// timer when data arrives on one of many connections.
+void tst_QTimer::restartAmongActiveTimers()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, timerType);
+
+    QObject background;
+    for (int i = 0; i < count; ++i)
+        background.startTimer(intervalFor(i), timerType);
+
+    QObject object;
+    int id = object.startTimer(30000, timerType);
+    QBENCHMARK {
+        object.killTimer(id);
+        id = object.startTimer(30000, timerType);
+    }
+    object.killTimer(id);
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "tst_bench_qtimer.moc"
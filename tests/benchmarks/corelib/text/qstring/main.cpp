@@ -27,6 +27,7 @@
 ****************************************************************************/
 #include <QStringList>
 #include <QFile>
+#include <QSmallString>
 #include <QtTest/QtTest>
 
 class tst_QString: public QObject
@@ -48,6 +49,11 @@ private slots:
     void toCaseFolded_data();
     void toCaseFolded();
 
+    void shortStrings_data();
+    void shortStrings();
+    void shortStringAllocations_data() { shortStrings_data(); }
+    void shortStringAllocations();
+
 private:
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
@@ -187,6 +193,75 @@ void tst_QString::toCaseFolded()
     }
 }
 
+void tst_QString::shortStrings_data()
+{
+    QTest::addColumn<QStringList>("keys");
+    QTest::addColumn<bool>("small");
+
+    // property names and header names, most of which fit into a QSmallString
+    const QStringList keys = {
+        QStringLiteral("x"), QStringLiteral("y"), QStringLiteral("width"), QStringLiteral("height"),
+        QStringLiteral("id"), QStringLiteral("name"), QStringLiteral("type"), QStringLiteral("value"),
+        QStringLiteral("enabled"), QStringLiteral("objectName"), QStringLiteral("Host"),
+        QStringLiteral("Accept"), QStringLiteral("Content-Type"), QStringLiteral("User-Agent"),
+        QStringLiteral("Cache-Control"), QStringLiteral("Accept-Encoding"),
+    };
+
+    QTest::newRow("QString") << keys << false;
+    QTest::newRow("QSmallString") << keys << true;
+}
+
+template <typename String>
+static qsizetype copyKeys(const QStringList &keys)
+{
+    qsizetype total = 0;
+    for (const QString &key : keys) {
+        // deep copies, as if the keys had been parsed from some input
+        const String copy(key.constData(), key.size());
+        total += copy.size();
+    }
+    return total;
+}
+
+// whether the string needed an allocation for its characters
+static bool isAllocated(const QString &s) { return s.capacity() > 0; }
+static bool isAllocated(const QSmallString &s) { return !s.isInline(); }
+
+template <typename String>
+static qsizetype countAllocations(const QStringList &keys)
+{
+    qsizetype allocations = 0;
+    for (const QString &key : keys) {
+        const String copy(key.constData(), key.size());
+        if (isAllocated(copy))
+            ++allocations;
+    }
+    return allocations;
+}
+
+void tst_QString::shortStrings()
+{
+    QFETCH(QStringList, keys);
+    QFETCH(bool, small);
+
+    qsizetype total = 0;
+    QBENCHMARK {
+        total += small ? copyKeys<QSmallString>(keys) : copyKeys<QString>(keys);
+    }
+    QVERIFY(total > 0);
+}
+
+void tst_QString::shortStringAllocations()
+{
+    QFETCH(QStringList, keys);
+    QFETCH(bool, small);
+
+    // count the string allocations instead of timing them
+    const qsizetype allocations = small ? countAllocations<QSmallString>(keys)
+                                        : countAllocations<QString>(keys);
+    QTest::setBenchmarkResult(allocations, QTest::Events);
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "main.moc"
@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+#include <QStringDecoder>
+#include <QStringEncoder>
+#include <QRandomGenerator>
+
+class tst_QStringConverter : public QObject
+{
+    Q_OBJECT
+private slots:
+    void fromUtf8_data();
+    void fromUtf8();
+    void toUtf8_data() { fromUtf8_data(); }
+    void toUtf8();
+    void decodeUtf8InChunks_data() { fromUtf8_data(); }
+    void decodeUtf8InChunks();
+    void encodeUtf8InChunks_data() { fromUtf8_data(); }
+    void encodeUtf8InChunks();
+};
+
+static const qsizetype ChunkSize = 4096;
+
+// returns about 64 kB of text made of the space-separated words of sample in
+// a pseudo-random order, so that the branch predictor can't learn the text
+static QByteArray corpus(const char *sample)
+{
+    const QByteArrayList words = QByteArray(sample).split(' ');
+    QRandomGenerator rng(64);
+    QByteArray result;
+    while (result.size() < 64 * 1024)
+        result += words.at(rng.bounded(words.size())) + ' ';
+    return result;
+}
+
+void tst_QStringConverter::fromUtf8_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+
+    QTest::newRow("ascii")
+            << corpus("The quick brown fox jumps over the lazy dog.");
+    QTest::newRow("latin1")
+            << corpus("Zwölf Boxkämpfer jagen Viktor quer über den großen Sylter Deich. "
+                      "Voix ambiguë d'un cœur qui, au zéphyr, préfère les jattes de kiwis.");
+    QTest::newRow("cyrillic")
+            << corpus("Съешь же ещё этих мягких французских булок, да выпей чаю.");
+    QTest::newRow("greek")
+            << corpus("Ξεσκεπάζω την ψυχοφθόρα βδελυγμία.");
+    QTest::newRow("chinese")
+            << corpus("我能 吞下 玻璃 而不 伤身体。 天地 玄黄， 宇宙 洪荒。");
+    QTest::newRow("japanese")
+            << corpus("いろはにほへと ちりぬるを わかよたれそ つねならむ Qt 6.0 のリリース。");
+    QTest::newRow("korean")
+            << corpus("다람쥐 헌 쳇바퀴에 타고파.");
+    QTest::newRow("mixed")
+            << corpus("<p lang=\"ru\">Привет, мир!</p> <p lang=\"zh\">你好，世界！</p> "
+                      "<p lang=\"en\">Hello, world!</p>");
+    QTest::newRow("emoji")
+            << corpus("Release day 🎉 🚀 — all tests pass ✅");
+}
+
+void tst_QStringConverter::fromUtf8()
+{
+    QFETCH(QByteArray, utf8);
+
+    QBENCHMARK {
+        QString s = QString::fromUtf8(utf8);
+        Q_UNUSED(s);
+    }
+}
+
+void tst_QStringConverter::toUtf8()
+{
+    QFETCH(QByteArray, utf8);
+    const QString text = QString::fromUtf8(utf8);
+
+    QBENCHMARK {
+        QByteArray ba = text.toUtf8();
+        Q_UNUSED(ba);
+    }
+}
+
+void tst_QStringConverter::decodeUtf8InChunks()
+{
+    QFETCH(QByteArray, utf8);
+
+    QBENCHMARK {
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        QString s;
+        for (qsizetype i = 0; i < utf8.size(); i += ChunkSize) {
+            const QString chunk = decoder(utf8.constData() + i, qMin(ChunkSize, utf8.size() - i));
+            s += chunk;
+        }
+    }
+}
+
+void tst_QStringConverter::encodeUtf8InChunks()
+{
+    QFETCH(QByteArray, utf8);
+    const QString text = QString::fromUtf8(utf8);
+
+    QBENCHMARK {
+        QStringEncoder encoder(QStringEncoder::Utf8);
+        QByteArray ba;
+        for (qsizetype i = 0; i < text.size(); i += ChunkSize) {
+            const QByteArray chunk = encoder(text.constData() + i, qMin(ChunkSize, text.size() - i));
+            ba += chunk;
+        }
+    }
+}
+
+QTEST_MAIN(tst_QStringConverter)
+
+#include "main.moc"
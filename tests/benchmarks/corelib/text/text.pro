@@ -4,6 +4,7 @@ SUBDIRS = \
         qchar \
         qlocale \
         qstringbuilder \
+        qstringconverter \
         qstringlist
 
 *g++*: SUBDIRS += qstring
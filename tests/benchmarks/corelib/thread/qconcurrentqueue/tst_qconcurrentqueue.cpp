@@ -0,0 +1,191 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QStringList>
+
+#include <QtTest/QtTest>
+
+#include <QConcurrentQueue>
+#include <QMutex>
+#include <QQueue>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <memory>
+#include <vector>
+
+// the kind of queue that the concurrent queues are meant to replace
+template <typename T>
+class LockedQueue
+{
+public:
+    explicit LockedQueue(qsizetype capacity) : capacity(capacity) {}
+
+    void push(const T &value)
+    {
+        QMutexLocker locker(&mutex);
+        while (queue.size() >= capacity)
+            notFull.wait(&mutex);
+        queue.enqueue(value);
+        notEmpty.wakeOne();
+    }
+    void pop(T *value)
+    {
+        QMutexLocker locker(&mutex);
+        while (queue.isEmpty())
+            notEmpty.wait(&mutex);
+        *value = queue.dequeue();
+        notFull.wakeOne();
+    }
+
+private:
+    QMutex mutex;
+    QWaitCondition notEmpty;
+    QWaitCondition notFull;
+    QQueue<T> queue;
+    const qsizetype capacity;
+};
+
+class tst_QConcurrentQueue : public QObject
+{
+    Q_OBJECT
+private slots:
+    void singleProducer_data();
+    void singleProducer();
+    void multipleProducers_data();
+    void multipleProducers();
+};
+
+enum Kind { Locked, Spsc, Mpmc };
+Q_DECLARE_METATYPE(Kind)
+
+enum { ValueCount = 100000 };
+
+template <typename Queue>
+static qint64 transfer(Queue &queue, int producerCount, int consumerCount)
+{
+    QAtomicInteger<qint64> sum = 0;
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < producerCount; ++i) {
+        threads.emplace_back(QThread::create([&queue, producerCount] {
+            for (int n = 0; n < ValueCount / producerCount; ++n)
+                queue.push(n);
+        }));
+    }
+    for (int i = 0; i < consumerCount; ++i) {
+        threads.emplace_back(QThread::create([&queue, &sum, consumerCount] {
+            qint64 local = 0;
+            for (int n = 0; n < ValueCount / consumerCount; ++n) {
+                int value;
+                queue.pop(&value);
+                local += value;
+            }
+            sum.fetchAndAddRelaxed(local);
+        }));
+    }
+    for (auto &thread : threads)
+        thread->start();
+    for (auto &thread : threads)
+        thread->wait();
+    return sum.loadRelaxed();
+}
+
+void tst_QConcurrentQueue::singleProducer_data()
+{
+    QTest::addColumn<Kind>("kind");
+    QTest::addColumn<int>("capacity");
+
+    for (int capacity : { 16, 1024 }) {
+        const QByteArray suffix = '/' + QByteArray::number(capacity);
+        QTest::newRow("QMutex+QWaitCondition" + suffix) << Locked << capacity;
+        QTest::newRow("QSpscQueue" + suffix) << Spsc << capacity;
+        QTest::newRow("QMpmcQueue" + suffix) << Mpmc << capacity;
+    }
+}
+
+void tst_QConcurrentQueue::singleProducer()
+{
+    QFETCH(Kind, kind);
+    QFETCH(int, capacity);
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        switch (kind) {
+        case Locked: {
+            LockedQueue<int> queue(capacity);
+            sum = transfer(queue, 1, 1);
+            break;
+        }
+        case Spsc: {
+            QSpscQueue<int> queue(capacity);
+            sum = transfer(queue, 1, 1);
+            break;
+        }
+        case Mpmc: {
+            QMpmcQueue<int> queue(capacity);
+            sum = transfer(queue, 1, 1);
+            break;
+        }
+        }
+    }
+    QCOMPARE(sum, qint64(ValueCount) * (ValueCount - 1) / 2);
+}
+
+void tst_QConcurrentQueue::multipleProducers_data()
+{
+    QTest::addColumn<Kind>("kind");
+    QTest::addColumn<int>("threadCount");
+
+    for (int threadCount : { 2, 4 }) {
+        const QByteArray suffix = '/' + QByteArray::number(threadCount);
+        QTest::newRow("QMutex+QWaitCondition" + suffix) << Locked << threadCount;
+        QTest::newRow("QMpmcQueue" + suffix) << Mpmc << threadCount;
+    }
+}
+
+void tst_QConcurrentQueue::multipleProducers()
+{
+    QFETCH(Kind, kind);
+    QFETCH(int, threadCount);
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        if (kind == Locked) {
+            LockedQueue<int> queue(256);
+            sum = transfer(queue, threadCount, threadCount);
+        } else {
+            QMpmcQueue<int> queue(256);
+            sum = transfer(queue, threadCount, threadCount);
+        }
+    }
+    const qint64 perProducer = ValueCount / threadCount;
+    QCOMPARE(sum, threadCount * perProducer * (perProducer - 1) / 2);
+}
+
+QTEST_MAIN(tst_QConcurrentQueue)
+
+#include "tst_qconcurrentqueue.moc"
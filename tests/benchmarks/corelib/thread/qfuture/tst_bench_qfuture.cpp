@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/qfuture.h>
+#include <QtTest/qtest.h>
+
+class tst_QFuture : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void singleResult();
+    void thenChain_data();
+    void thenChain();
+    void thenChainVoid_data();
+    void thenChainVoid();
+    void onCanceledChain_data();
+    void onCanceledChain();
+};
+
+// Reports and reads back a single int, the most common result of a
+// continuation.
+void tst_QFuture::singleResult()
+{
+    QBENCHMARK {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        promise.reportResult(42);
+        promise.reportFinished();
+        QCOMPARE(promise.future().result(), 42);
+    }
+}
+
+static void addChainLengthRows()
+{
+    QTest::addColumn<int>("length");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("5") << 5;
+    QTest::newRow("20") << 20;
+}
+
+void tst_QFuture::thenChain_data()
+{
+    addChainLengthRows();
+}
+
+// Attaches a chain of synchronous continuations passing an int along, and
+// finishes it.
+void tst_QFuture::thenChain()
+{
+    QFETCH(int, length);
+
+    QBENCHMARK {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        QFuture<int> future = promise.future();
+        for (int i = 0; i < length; ++i)
+            future = future.then([](int value) { return value + 1; });
+        promise.reportResult(0);
+        promise.reportFinished();
+        QCOMPARE(future.result(), length);
+    }
+}
+
+void tst_QFuture::thenChainVoid_data()
+{
+    addChainLengthRows();
+}
+
+void tst_QFuture::thenChainVoid()
+{
+    QFETCH(int, length);
+
+    QBENCHMARK {
+        int count = 0;
+        QFutureInterface<void> promise;
+        promise.reportStarted();
+        QFuture<void> future = promise.future();
+        for (int i = 0; i < length; ++i)
+            future = future.then([&count] { ++count; });
+        promise.reportFinished();
+        future.waitForFinished();
+        QCOMPARE(count, length);
+    }
+}
+
+void tst_QFuture::onCanceledChain_data()
+{
+    addChainLengthRows();
+}
+
+void tst_QFuture::onCanceledChain()
+{
+    QFETCH(int, length);
+
+    QBENCHMARK {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        QFuture<int> future = promise.future();
+        for (int i = 0; i < length; ++i)
+            future = future.onCanceled([] { return 1; });
+        promise.reportResult(0);
+        promise.reportFinished();
+        QCOMPARE(future.result(), 0);
+    }
+}
+
+QTEST_MAIN(tst_QFuture)
+
+#include "tst_bench_qfuture.moc"
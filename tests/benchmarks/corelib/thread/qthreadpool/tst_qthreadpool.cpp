@@ -40,6 +40,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void tinyTasks_data();
+    void tinyTasks();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -75,5 +77,84 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::tinyTasks_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("nested");
+
+    const int maxThreadCount = qMax(4, QThread::idealThreadCount());
+    for (int threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2) {
+        QTest::addRow("external-%d", threadCount) << threadCount << false;
+        QTest::addRow("nested-%d", threadCount) << threadCount << true;
+    }
+}
+
+class CountDownRunnable : public QRunnable
+{
+public:
+    CountDownRunnable(QAtomicInt &remaining, QSemaphore &done)
+        : remaining(remaining), done(done)
+    { }
+
+    void run() override
+    {
+        if (remaining.fetchAndSubRelaxed(1) == 1)
+            done.release();
+    }
+
+private:
+    QAtomicInt &remaining;
+    QSemaphore &done;
+};
+
+class SpawningRunnable : public QRunnable
+{
+public:
+    SpawningRunnable(QThreadPool &pool, int count, QAtomicInt &remaining, QSemaphore &done)
+        : pool(pool), count(count), remaining(remaining), done(done)
+    { }
+
+    void run() override
+    {
+        for (int i = 0; i < count; ++i)
+            pool.start(new CountDownRunnable(remaining, done));
+    }
+
+private:
+    QThreadPool &pool;
+    int count;
+    QAtomicInt &remaining;
+    QSemaphore &done;
+};
+
+// Throughput for runnables that do next to nothing, started either from the
+// outside, or from inside the pool (as recursive algorithms do). Run with
+// QT_THREADPOOL_WORK_STEALING=1 to compare with the work-stealing mode.
+void tst_QThreadPool::tinyTasks()
+{
+    QFETCH(int, threadCount);
+    QFETCH(bool, nested);
+
+    const int taskCount = 100000;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    QAtomicInt remaining;
+    QSemaphore done;
+
+    QBENCHMARK {
+        remaining.storeRelaxed(taskCount);
+        if (nested) {
+            for (int i = 0; i < threadCount; ++i) {
+                const int count = taskCount / threadCount + (i < taskCount % threadCount);
+                threadPool.start(new SpawningRunnable(threadPool, count, remaining, done));
+            }
+        } else {
+            for (int i = 0; i < taskCount; ++i)
+                threadPool.start(new CountDownRunnable(remaining, done));
+        }
+        done.acquire();
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 #include "tst_qthreadpool.moc"
@@ -1,5 +1,7 @@
 TEMPLATE = subdirs
 SUBDIRS = \
+        qconcurrentqueue \
+        qfuture \
         qmutex \
         qreadwritelock \
         qthreadstorage \
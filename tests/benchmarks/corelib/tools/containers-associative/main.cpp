@@ -26,9 +26,13 @@
 **
 ****************************************************************************/
 #include <QString>
+#include <QHash>
+#include <QRandomGenerator>
 
 #include <qtest.h>
 
+#include <unordered_map>
+
 class tst_associative_containers : public QObject
 {
     Q_OBJECT
@@ -37,6 +41,8 @@ private slots:
     void insert();
     void lookup_data();
     void lookup();
+    void lookupLarge_data();
+    void lookupLarge();
 };
 
 template <typename T>
@@ -125,5 +131,69 @@ void tst_associative_containers::lookup()
     }
 }
 
+struct Record
+{
+    quint64 id;
+    double values[3];
+};
+
+static quint64 recordKey(quint64 i)
+{
+    // spread the keys over the whole 64-bit range
+    return i * Q_UINT64_C(0x9e3779b97f4a7c15);
+}
+
+void tst_associative_containers::lookupLarge_data()
+{
+    QTest::addColumn<bool>("useStd");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("hit");
+
+    for (int size : { 1000, 100000, 1000000, 10000000 }) {
+        for (bool hit : { true, false }) {
+            const char *kind = hit ? "hit" : "miss";
+            QTest::addRow("hash--%d-%s", size, kind) << false << size << hit;
+            QTest::addRow("unordered_map--%d-%s", size, kind) << true << size << hit;
+        }
+    }
+}
+
+template <typename T>
+void testLookupLarge(int size, bool hit)
+{
+    T container;
+    container.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        const quint64 key = recordKey(i);
+        container.emplace(key, Record{ key, { 0, 1, 2 } });
+    }
+
+    // look up in random order, so that the caches don't help
+    enum { LookupCount = 100000 };
+    QRandomGenerator generator(size);
+    std::vector<quint64> keys(LookupCount);
+    for (quint64 &key : keys)
+        key = recordKey(generator.bounded(size) + (hit ? 0 : size));
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        for (quint64 key : keys)
+            found += container.find(key) != container.end();
+    }
+    QCOMPARE(found > 0, hit);
+}
+
+void tst_associative_containers::lookupLarge()
+{
+    QFETCH(bool, useStd);
+    QFETCH(int, size);
+    QFETCH(bool, hit);
+
+    if (useStd)
+        testLookupLarge<std::unordered_map<quint64, Record>>(size, hit);
+    else
+        testLookupLarge<QHash<quint64, Record>>(size, hit);
+}
+
 QTEST_MAIN(tst_associative_containers)
 #include "main.moc"
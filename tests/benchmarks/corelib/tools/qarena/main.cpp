@@ -0,0 +1,147 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QArena>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTest>
+
+class tst_QArena : public QObject
+{
+    Q_OBJECT
+private slots:
+    void request_data();
+    void request();
+    void allocationsPerRequest_data();
+    void allocationsPerRequest();
+};
+
+// What a request handler typically does: split the request into header
+// lines, index the headers and build a response from them
+static QByteArray requestData()
+{
+    QByteArray data = "GET /index.html HTTP/1.1\r\n";
+    for (int i = 0; i < 50; ++i)
+        data += "X-Header-" + QByteArray::number(i) + ": value-" + QByteArray::number(i * 7) + "\r\n";
+    return data;
+}
+
+// The containers of the request either come from the arena or from the heap
+static QString newString(QArena *arena, qsizetype capacity)
+{
+    if (arena)
+        return arena->string(capacity);
+    QString s;
+    s.reserve(capacity);
+    return s;
+}
+
+static qsizetype handleRequest(const QByteArray &request, QArena *arena)
+{
+    auto headers = arena ? arena->hash<QString, QString>(64) : QHash<QString, QString>();
+    if (!arena)
+        headers.reserve(64);
+    qsizetype from = request.indexOf('\n') + 1;
+    while (from > 0 && from < request.size()) {
+        qsizetype to = request.indexOf('\n', from);
+        if (to < 0)
+            to = request.size();
+        const QLatin1String line = QLatin1String(request.constData() + from, to - from).trimmed();
+        from = to + 1;
+        const qsizetype colon = line.indexOf(QLatin1Char(':'));
+        if (colon < 0)
+            continue;
+        const QLatin1String name = line.left(colon);
+        const QLatin1String value = line.mid(colon + 1).trimmed();
+        QString key = newString(arena, name.size());
+        for (char c : name)
+            key += QLatin1Char(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+        QString v = newString(arena, value.size());
+        v += value;
+        headers.insert(key, v);
+    }
+    QString response = newString(arena, 4096);
+    for (auto it = headers.cbegin(); it != headers.cend(); ++it) {
+        response += it.key();
+        response += QLatin1String(" = ");
+        response += it.value();
+        response += QLatin1Char('\n');
+    }
+    return response.size();
+}
+
+void tst_QArena::request_data()
+{
+    QTest::addColumn<bool>("useArena");
+    QTest::newRow("heap") << false;
+    QTest::newRow("arena") << true;
+}
+
+void tst_QArena::request()
+{
+    QFETCH(bool, useArena);
+    const QByteArray data = requestData();
+    QArena arena;
+    qsizetype size = 0;
+    QBENCHMARK {
+        size += handleRequest(data, useArena ? &arena : nullptr);
+        arena.reset();
+    }
+    QVERIFY(size > 0);
+}
+
+void tst_QArena::allocationsPerRequest_data()
+{
+    QTest::addColumn<bool>("heapAllocations");
+    QTest::newRow("container-allocations") << false;
+    QTest::newRow("heap-allocations-with-arena") << true;
+}
+
+void tst_QArena::allocationsPerRequest()
+{
+    QFETCH(bool, heapAllocations);
+    const QByteArray data = requestData();
+
+    // warm up, so that the arena has grown its block to the needed size
+    QArena arena(64 * 1024);
+    handleRequest(data, &arena);
+    arena.reset();
+
+    handleRequest(data, &arena);
+    // without an arena, each container allocation is a heap allocation;
+    // with one, only the blocks of the arena are
+    QTest::setBenchmarkResult(heapAllocations ? arena.blockCount() : arena.allocationCount(),
+                              QTest::Events);
+}
+
+QTEST_MAIN(tst_QArena)
+
+#include "main.moc"
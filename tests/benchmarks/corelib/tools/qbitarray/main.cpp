@@ -0,0 +1,174 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QBitArray>
+#include <QRandomGenerator>
+#include <QTest>
+
+class tst_QBitArray : public QObject
+{
+    Q_OBJECT
+private slots:
+    void bitwiseAnd_data() { data(); }
+    void bitwiseAnd();
+    void bitwiseOr_data() { data(); }
+    void bitwiseOr();
+    void bitwiseXor_data() { data(); }
+    void bitwiseXor();
+    void bitwiseNot_data() { data(); }
+    void bitwiseNot();
+    void countBits_data() { data(); }
+    void countBits();
+    void iterateSetBits_data();
+    void iterateSetBits();
+    void iterateSetBitsWithTestBit_data() { iterateSetBits_data(); }
+    void iterateSetBitsWithTestBit();
+
+private:
+    void data();
+};
+
+static QBitArray randomBitArray(int size, int percentSet)
+{
+    QBitArray ba(size);
+    QRandomGenerator rng(size);
+    for (int i = 0; i < size; ++i)
+        ba.setBit(i, int(rng.bounded(100)) < percentSet);
+    return ba;
+}
+
+void tst_QBitArray::data()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("64K") << 64 * 1024;
+    QTest::newRow("1M") << 1024 * 1024;
+    QTest::newRow("16M") << 16 * 1024 * 1024;
+}
+
+void tst_QBitArray::bitwiseAnd()
+{
+    QFETCH(int, size);
+    const QBitArray a = randomBitArray(size, 50);
+    QBitArray b = randomBitArray(size, 50);
+
+    QBENCHMARK {
+        b &= a;
+    }
+}
+
+void tst_QBitArray::bitwiseOr()
+{
+    QFETCH(int, size);
+    const QBitArray a = randomBitArray(size, 50);
+    QBitArray b = randomBitArray(size, 50);
+
+    QBENCHMARK {
+        b |= a;
+    }
+}
+
+void tst_QBitArray::bitwiseXor()
+{
+    QFETCH(int, size);
+    const QBitArray a = randomBitArray(size, 50);
+    QBitArray b = randomBitArray(size, 50);
+
+    QBENCHMARK {
+        b ^= a;
+    }
+}
+
+void tst_QBitArray::bitwiseNot()
+{
+    QFETCH(int, size);
+    const QBitArray a = randomBitArray(size, 50);
+
+    QBENCHMARK {
+        const QBitArray b = ~a;
+        Q_UNUSED(b);
+    }
+}
+
+void tst_QBitArray::countBits()
+{
+    QFETCH(int, size);
+    const QBitArray a = randomBitArray(size, 50);
+
+    int count = 0;
+    QBENCHMARK {
+        count = a.count(true);
+    }
+    QVERIFY(count > 0);
+}
+
+void tst_QBitArray::iterateSetBits_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("percentSet");
+
+    // a selection of rows from a large table
+    for (int percentSet : { 1, 10, 50 })
+        QTest::addRow("1M-%d%%", percentSet) << 1024 * 1024 << percentSet;
+}
+
+void tst_QBitArray::iterateSetBits()
+{
+    QFETCH(int, size);
+    QFETCH(int, percentSet);
+    const QBitArray a = randomBitArray(size, percentSet);
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        for (int i = a.findNextSetBit(); i != -1; i = a.findNextSetBit(i + 1))
+            sum += i;
+    }
+    QVERIFY(sum > 0);
+}
+
+void tst_QBitArray::iterateSetBitsWithTestBit()
+{
+    QFETCH(int, size);
+    QFETCH(int, percentSet);
+    const QBitArray a = randomBitArray(size, percentSet);
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < size; ++i) {
+            if (a.testBit(i))
+                sum += i;
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+QTEST_APPLESS_MAIN(tst_QBitArray)
+
+#include "main.moc"
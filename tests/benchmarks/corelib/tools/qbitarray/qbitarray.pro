@@ -0,0 +1,6 @@
+CONFIG += benchmark
+CONFIG += parallel_test
+QT = core testlib
+
+TARGET = tst_bench_qbitarray
+SOURCES += main.cpp
@@ -51,6 +51,8 @@ private slots:
     void qhash_qt4() { qhash_template<Qt4String>(); }
     void qhash_javaString_data() { data(); }
     void qhash_javaString() { qhash_template<JavaString>(); }
+    void qhash_sipHash_data() { data(); }
+    void qhash_sipHash() { qhash_template<SipHashString>(); }
 
     void hashing_current_data() { data(); }
     void hashing_current() { hashing_template<QString>(); }
@@ -60,9 +62,18 @@ private slots:
     void hashing_qt4() { hashing_template<Qt4String>(); }
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
+    void hashing_sipHash_data() { data(); }
+    void hashing_sipHash() { hashing_template<SipHashString>(); }
+
+    void hashBits_current_data() { bitsData(); }
+    void hashBits_current() { hashBits_template(qHashBits); }
+    void hashBits_sipHash_data() { bitsData(); }
+    void hashBits_sipHash() { hashBits_template(sipHashBits); }
 
 private:
     void data();
+    void bitsData();
+    void hashBits_template(size_t (*hashFunction)(const void *, size_t, size_t));
     template <typename String> void qhash_template();
     template <typename String> void hashing_template();
 
@@ -136,6 +147,13 @@ void tst_QHash::data()
     QTest::newRow("numbers") << numbers;
 }
 
+void tst_QHash::bitsData()
+{
+    QTest::addColumn<int>("length");
+    for (int length : { 4, 8, 12, 16, 24, 32, 64, 256, 4096 })
+        QTest::addRow("%d", length) << length;
+}
+
 template <typename String> void tst_QHash::qhash_template()
 {
     QFETCH(QStringList, items);
@@ -168,6 +186,25 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+void tst_QHash::hashBits_template(size_t (*hashFunction)(const void *, size_t, size_t))
+{
+    // just the hashing function, for raw memory of a given length
+    QFETCH(int, length);
+
+    const int count = 1000;
+    QByteArray data(length + count, 'a');
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char('a' + i % 26);
+    const size_t seed = size_t(qGlobalQHashSeed());
+
+    size_t result = 0;
+    QBENCHMARK {
+        for (int i = 0; i != count; ++i)
+            result += hashFunction(data.constData() + i, size_t(length), seed);
+    }
+    Q_UNUSED(result);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "main.moc"
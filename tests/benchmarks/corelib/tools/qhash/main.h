@@ -59,3 +59,17 @@ QT_BEGIN_NAMESPACE
 uint qHash(const JavaString &);
 QT_END_NAMESPACE
 
+
+struct SipHashString : QString
+{
+    SipHashString() {}
+    SipHashString(const QString &s) : QString(s) {}
+};
+
+QT_BEGIN_NAMESPACE
+size_t qHash(const SipHashString &, size_t seed = 0);
+
+// Copy of the SipHash-1-2 implementation that qHashBits() uses for keys
+// longer than a pointer when the CPU doesn't support AES-NI
+size_t sipHashBits(const void *p, size_t len, size_t seed);
+QT_END_NAMESPACE
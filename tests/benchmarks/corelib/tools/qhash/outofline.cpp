@@ -28,6 +28,8 @@
 
 #include "main.h"
 
+#include <QtEndian>
+
 QT_BEGIN_NAMESPACE
 
 uint qHash(const Qt4String &str)
@@ -78,4 +80,108 @@ uint qHash(const JavaString &str)
     return h;
 }
 
+// SipHash-1-2, as in qhash.cpp
+#define cROUNDS 1
+#define dROUNDS 2
+
+#define ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIPROUND                                                               \
+  do {                                                                         \
+    v0 += v1;                                                                  \
+    v1 = ROTL(v1, 13);                                                         \
+    v1 ^= v0;                                                                  \
+    v0 = ROTL(v0, 32);                                                         \
+    v2 += v3;                                                                  \
+    v3 = ROTL(v3, 16);                                                         \
+    v3 ^= v2;                                                                  \
+    v0 += v3;                                                                  \
+    v3 = ROTL(v3, 21);                                                         \
+    v3 ^= v0;                                                                  \
+    v2 += v1;                                                                  \
+    v1 = ROTL(v1, 17);                                                         \
+    v1 ^= v2;                                                                  \
+    v2 = ROTL(v2, 32);                                                         \
+  } while (0)
+
+
+static uint64_t siphash(const uint8_t *in, uint64_t inlen, const uint64_t seed)
+{
+    /* "somepseudorandomlygeneratedbytes" */
+    uint64_t v0 = 0x736f6d6570736575ULL;
+    uint64_t v1 = 0x646f72616e646f6dULL;
+    uint64_t v2 = 0x6c7967656e657261ULL;
+    uint64_t v3 = 0x7465646279746573ULL;
+    uint64_t b;
+    uint64_t k0 = seed;
+    uint64_t k1 = seed ^ inlen;
+    int i;
+    const uint8_t *end = in + (inlen & ~7ULL);
+    const int left = inlen & 7;
+    b = inlen << 56;
+    v3 ^= k1;
+    v2 ^= k0;
+    v1 ^= k1;
+    v0 ^= k0;
+
+    for (; in != end; in += 8) {
+        uint64_t m = qFromUnaligned<uint64_t>(in);
+        v3 ^= m;
+
+        for (i = 0; i < cROUNDS; ++i)
+            SIPROUND;
+
+        v0 ^= m;
+    }
+
+
+#if defined(Q_CC_GNU) && Q_CC_GNU >= 700
+    QT_WARNING_DISABLE_GCC("-Wimplicit-fallthrough")
+#endif
+    switch (left) {
+    case 7:
+        b |= ((uint64_t)in[6]) << 48;
+    case 6:
+        b |= ((uint64_t)in[5]) << 40;
+    case 5:
+        b |= ((uint64_t)in[4]) << 32;
+    case 4:
+        b |= ((uint64_t)in[3]) << 24;
+    case 3:
+        b |= ((uint64_t)in[2]) << 16;
+    case 2:
+        b |= ((uint64_t)in[1]) << 8;
+    case 1:
+        b |= ((uint64_t)in[0]);
+        break;
+    case 0:
+        break;
+    }
+
+    v3 ^= b;
+
+    for (i = 0; i < cROUNDS; ++i)
+        SIPROUND;
+
+    v0 ^= b;
+
+    v2 ^= 0xff;
+
+    for (i = 0; i < dROUNDS; ++i)
+        SIPROUND;
+
+    b = v0 ^ v1 ^ v2 ^ v3;
+    return b;
+}
+
+size_t sipHashBits(const void *p, size_t len, size_t seed)
+{
+    return size_t(siphash(reinterpret_cast<const uint8_t *>(p), len, seed));
+}
+
+size_t qHash(const SipHashString &str, size_t seed)
+{
+    return sipHashBits(str.constData(), size_t(str.size()) * sizeof(QChar), seed);
+}
+
 QT_END_NAMESPACE
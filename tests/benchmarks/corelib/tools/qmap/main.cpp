@@ -28,10 +28,14 @@
 
 #include <QFile>
 #include <QMap>
+#include <QRandomGenerator>
 #include <QString>
 #include <QTest>
 #include <qdebug.h>
 
+#include <algorithm>
+#include <map>
+
 
 class tst_QMap : public QObject
 {
@@ -61,6 +65,16 @@ private slots:
     void insertion_string_int2_hint();
 
     void insertMap();
+
+    void insertRandom_data() { largeMapData(); }
+    void insertRandom();
+    void lookupRandom_data() { largeMapData(); }
+    void lookupRandom();
+    void iterateRandom_data() { largeMapData(); }
+    void iterateRandom();
+
+private:
+    void largeMapData();
 };
 
 
@@ -284,6 +298,122 @@ void tst_QMap::insertMap()
     }
 }
 
+enum MapType { QtMap, StdMap };
+Q_DECLARE_METATYPE(MapType)
+
+void tst_QMap::largeMapData()
+{
+    QTest::addColumn<MapType>("type");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 1000, 100000, 10000000 }) {
+        QTest::addRow("QMap:%d", size) << QtMap << size;
+        QTest::addRow("std::map:%d", size) << StdMap << size;
+    }
+}
+
+// The keys in a random order, so that the nodes are not allocated in key order
+static std::vector<quint64> randomKeys(int size)
+{
+    std::vector<quint64> keys(size);
+    for (int i = 0; i < size; ++i)
+        keys[i] = quint64(i) * 2;
+    std::shuffle(keys.begin(), keys.end(), *QRandomGenerator::global());
+    return keys;
+}
+
+typedef QMap<quint64, quint64> QtMapType;
+typedef std::map<quint64, quint64> StdMapType;
+
+static void insertKey(QtMapType &map, quint64 key) { map.insert(key, key); }
+static void insertKey(StdMapType &map, quint64 key) { map.emplace(key, key); }
+static quint64 valueAt(QtMapType::const_iterator it) { return it.value(); }
+static quint64 valueAt(StdMapType::const_iterator it) { return it->second; }
+
+template <typename Map>
+static void insertRandom_impl(const std::vector<quint64> &keys)
+{
+    QBENCHMARK {
+        Map map;
+        for (quint64 key : keys)
+            insertKey(map, key);
+    }
+}
+
+void tst_QMap::insertRandom()
+{
+    QFETCH(MapType, type);
+    QFETCH(int, size);
+
+    const std::vector<quint64> keys = randomKeys(size);
+    if (type == QtMap)
+        insertRandom_impl<QtMapType>(keys);
+    else
+        insertRandom_impl<StdMapType>(keys);
+}
+
+template <typename Map>
+static void lookupRandom_impl(const std::vector<quint64> &keys)
+{
+    Map map;
+    for (quint64 key : keys)
+        insertKey(map, key);
+
+    // look up as many existing as missing keys (the odd ones)
+    std::vector<quint64> lookups(100000);
+    for (quint64 &key : lookups)
+        key = QRandomGenerator::global()->bounded(quint32(keys.size() * 2));
+
+    quint64 sum = 0;
+    QBENCHMARK {
+        for (quint64 key : lookups) {
+            auto it = map.find(key);
+            if (it != map.end())
+                sum += key;
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+void tst_QMap::lookupRandom()
+{
+    QFETCH(MapType, type);
+    QFETCH(int, size);
+
+    const std::vector<quint64> keys = randomKeys(size);
+    if (type == QtMap)
+        lookupRandom_impl<QtMapType>(keys);
+    else
+        lookupRandom_impl<StdMapType>(keys);
+}
+
+template <typename Map>
+static void iterateRandom_impl(const std::vector<quint64> &keys)
+{
+    Map map;
+    for (quint64 key : keys)
+        insertKey(map, key);
+
+    quint64 sum = 0;
+    QBENCHMARK {
+        for (auto it = map.cbegin(), end = map.cend(); it != end; ++it)
+            sum += valueAt(it);
+    }
+    QVERIFY(sum > 0);
+}
+
+void tst_QMap::iterateRandom()
+{
+    QFETCH(MapType, type);
+    QFETCH(int, size);
+
+    const std::vector<quint64> keys = randomKeys(size);
+    if (type == QtMap)
+        iterateRandom_impl<QtMapType>(keys);
+    else
+        iterateRandom_impl<StdMapType>(keys);
+}
+
 QTEST_MAIN(tst_QMap)
 
 #include "main.moc"
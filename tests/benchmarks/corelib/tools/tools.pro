@@ -10,4 +10,6 @@ SUBDIRS = \
         qringbuffer \
         qstack \
         qvector \
-        qalgorithms
+        qalgorithms \
+        qarena \
+        qbitarray